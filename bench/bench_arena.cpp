@@ -0,0 +1,56 @@
+#include <iostream>
+#include <chrono>
+#include "../include/vector.h"
+#include "../include/arena.h"
+
+/*!
+ * Arena benchmark: simulated request handlers that build a few hundred
+ * short-lived vectors and drop them all at the end of the request.
+ *
+ * The default heap pays one malloc/free per growth step of every vector;
+ * the arena bumps a pointer, grows in place while a vector sits at the tip
+ * and releases the whole request with a single reset().
+ */
+
+const int requests = 2000;
+const int vectors_per_request = 300;
+
+/// Builds the temporaries of one request; returns a checksum so the work is not optimized away.
+template <typename Vector, typename... Alloc>
+long handle_request(int seed, const Alloc&... alloc){
+    long checksum = 0;
+    for(int v = 0; v < vectors_per_request; v++){
+        Vector vec(alloc...);
+        int n = 1 + (seed * 31 + v * 17) % 64;
+        for(int i = 0; i < n; i++){
+            vec.push_back(i ^ seed);
+        }
+        checksum += vec.back() + vec.size();
+    }
+    return checksum;
+}
+
+int main(void){
+    long checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < requests; r++){
+        checksum += handle_request<sc::vector<int>>(r);
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    sc::arena arena;
+    sc::arena_allocator<int> alloc(arena);
+    for(int r = 0; r < requests; r++){
+        checksum -= handle_request<sc::arena_vector<int>>(r, alloc);
+        arena.reset();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double heap_s = std::chrono::duration<double>(mid - start).count();
+    double arena_s = std::chrono::duration<double>(end - mid).count();
+    std::cout << requests << " requests x " << vectors_per_request << " temporary vectors\n"
+              << "  default heap: " << requests / heap_s << " requests/s\n"
+              << "  sc::arena:    " << requests / arena_s << " requests/s (" << heap_s / arena_s << "x)\n";
+    return checksum == 0 ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include "../include/vector.h"
+
+/*!
+ * Comparison benchmark: ==, < and std::lexicographical_compare on two
+ * equal sc::vector<int> (the worst case: every element is visited), at
+ * 1K, 1M and 100M elements.
+ *
+ * The element-wise loop is what operator== did before; it is kept here as
+ * the baseline.
+ */
+
+volatile bool sink; //!< Keeps the comparisons from being optimized away.
+
+/// Element-wise equality, the baseline.
+template <typename V>
+bool loop_equal(const V &lhs, const V &rhs){
+    if(lhs.size() != rhs.size()) return false;
+    for(size_t i = 0; i < lhs.size(); i++){
+        if(lhs[i] != rhs[i]) return false;
+    }
+    return true;
+}
+
+/// Runs f `reps` times and prints the throughput over both vectors.
+template <typename F>
+void time(const char *name, unsigned long n, int reps, F f){
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < reps; r++){
+        sink = f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double s = std::chrono::duration<double>(end - start).count();
+    double bytes = 2.0 * n * sizeof(int) * reps;
+    std::cout << "  " << name << ": " << s / reps * 1e6 << " us, " << bytes / s / 1e9 << " GB/s\n";
+}
+
+void run(unsigned long n, int reps){
+    sc::vector<int> a, b;
+    a.resize(n);
+    for(auto i(0ul); i < n; i++){
+        a[i] = int(i * 2654435761u);
+    }
+    b = a;
+    std::cout << n << " ints\n";
+    time("element loop ==          ", n, reps, [&]{ return loop_equal(a, b); });
+    time("operator== (memcmp)      ", n, reps, [&]{ return a == b; });
+    time("std::lexicographical_cmp ", n, reps, [&]{
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    });
+    time("operator< (SIMD mismatch)", n, reps, [&]{ return a < b; });
+}
+
+int main(void){
+    run(1000, 100000);
+    run(1000000, 200);
+    run(100000000, 3);
+}
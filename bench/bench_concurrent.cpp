@@ -0,0 +1,61 @@
+#include <iostream>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include "../include/vector.h"
+#include "../include/concurrent_vector.h"
+
+/*!
+ * Concurrent append benchmark: 1 to 64 threads push 16M uint64_t in total
+ * into one shared container, either an sc::vector behind a std::mutex or an
+ * sc::concurrent_vector, and the time to join them all is reported.
+ *
+ * With more threads than cores the mutex is often held by a thread that has
+ * been preempted, which is when the lock-free version helps most.
+ */
+
+using clock_type = std::chrono::steady_clock;
+
+/// Starts threads workers, each running body(first, count) on its share of n, and returns the time to join them.
+template <typename Body>
+double run(unsigned threads, unsigned long n, Body body){
+    sc::vector<std::thread> workers;
+    auto start = clock_type::now();
+    for(unsigned t = 0; t < threads; t++){
+        unsigned long first = n * t / threads, last = n * (t + 1) / threads;
+        workers.push_back(std::thread(body, first, last - first));
+    }
+    for(auto &w : workers) w.join();
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+int main(void){
+    const unsigned long n = 16ul << 20;
+    std::cout << n << " push_back of uint64_t, shared by all the threads ("
+              << std::thread::hardware_concurrency() << " hardware threads)\n";
+    std::cout << "threads   mutex + sc::vector   sc::concurrent_vector\n";
+    for(unsigned threads = 1; threads <= 64; threads *= 2){
+        double locked, lock_free;
+        {
+            sc::vector<std::uint64_t> v;
+            std::mutex m;
+            locked = run(threads, n, [&](unsigned long first, unsigned long count){
+                for(auto i(first); i < first + count; i++){
+                    std::lock_guard<std::mutex> lock(m);
+                    v.push_back(i);
+                }
+            });
+        }
+        {
+            sc::concurrent_vector<std::uint64_t> v;
+            lock_free = run(threads, n, [&](unsigned long first, unsigned long count){
+                for(auto i(first); i < first + count; i++){
+                    v.push_back(i);
+                }
+            });
+        }
+        std::cout << "  " << threads << "\t  " << locked << " ms\t\t" << lock_free << " ms\n";
+    }
+    return 0;
+}
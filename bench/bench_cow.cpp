@@ -0,0 +1,46 @@
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include "../include/vector.h"
+#include "../include/cow_vector.h"
+
+/*!
+ * Copy-on-write benchmark: a routing table of 256K uint32_t entries is handed
+ * to readers as snapshots. Each round takes 64 snapshots (one per reader),
+ * each reader reads 1000 entries, and one round in 10 updates an entry.
+ * The same workload runs with sc::vector, whose copies are deep, and with
+ * sc::cow_vector, whose copies share the table until it changes.
+ */
+
+volatile std::uint64_t sink; //!< Keeps the reads from being optimized away.
+
+using clock_type = std::chrono::steady_clock;
+
+/// Runs the workload on a table of type V and prints its time.
+template <typename V, typename Update>
+void run(const char *name, V table, unsigned rounds, Update update){
+    auto start = clock_type::now();
+    std::uint64_t sum = 0;
+    for(unsigned round = 0; round < rounds; round++){
+        if(round % 10 == 0) update(table, round);
+        for(int reader = 0; reader < 64; reader++){
+            V snapshot = table;
+            for(unsigned long i = 0; i < 1000; i++) sum += snapshot[(i * 7919 + reader) % snapshot.size()];
+        }
+    }
+    sink = sum;
+    std::cout << "  " << name << std::chrono::duration<double, std::milli>(clock_type::now() - start).count() << " ms\n";
+}
+
+int main(void){
+    const unsigned long n = 1ul << 18;
+    const unsigned rounds = 20;
+    sc::vector<std::uint32_t> table;
+    table.reserve(n);
+    for(auto i(0ul); i < n; i++) table.push_back(std::uint32_t(i * 2654435761u));
+    std::cout << rounds << " rounds of 64 snapshots of a " << n << "-entry table, an update every 10 rounds\n";
+    run("sc::vector (deep copy)      ", table, rounds, [](sc::vector<std::uint32_t> &t, unsigned r){ t[r % t.size()] = r; });
+    run("sc::cow_vector              ", sc::cow_vector<std::uint32_t>(table), rounds,
+        [](sc::cow_vector<std::uint32_t> &t, unsigned r){ t.set(r % t.size(), r); });
+    return 0;
+}
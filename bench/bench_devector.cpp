@@ -0,0 +1,49 @@
+#include <iostream>
+#include <chrono>
+#include "../include/vector.h"
+#include "../include/devector.h"
+
+/*!
+ * Devector benchmark: a FIFO queue (push_back + pop_front) and front
+ * pushes, both on a list that already holds 1M elements.
+ *
+ * sc::vector shifts every element on each front operation, so both
+ * workloads are O(n) per operation; sc::devector keeps spare room before
+ * the first element and does them in amortized O(1).
+ */
+
+/// Times `ops` iterations of f and prints the throughput.
+template <typename F>
+void time(const char *name, int ops, F f){
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < ops; i++){
+        f(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double s = std::chrono::duration<double>(end - start).count();
+    std::cout << "  " << name << ": " << ops / s << " ops/s\n";
+}
+
+template <typename V>
+void run(const char *name, unsigned long n, int ops){
+    std::cout << name << "\n";
+    V queue;
+    for(auto i(0ul); i < n; i++){
+        queue.push_back(int(i));
+    }
+    time("queue (push_back + pop_front)", ops, [&](int i){
+        queue.push_back(i);
+        queue.pop_front();
+    });
+
+    time("push_front", ops, [&](int i){
+        queue.push_front(i);
+    });
+}
+
+int main(void){
+    const unsigned long n = 1000000;
+    std::cout << "Queue of " << n << " ints, and front pushes\n";
+    run<sc::vector<int>>("sc::vector<int>", n, 2000);
+    run<sc::devector<int>>("sc::devector<int>", n, 2000000);
+}
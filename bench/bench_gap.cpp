@@ -0,0 +1,75 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include "../include/vector.h"
+#include "../include/gap_vector.h"
+
+/*!
+ * Gap buffer benchmark: replays an editor-like trace on a 1M-character
+ * document. The cursor mostly types forward, sometimes backspaces, and now
+ * and then jumps to a nearby line.
+ *
+ * sc::vector shifts the whole tail on every keystroke; sc::gap_vector only
+ * moves the elements between the previous and the current edit point.
+ */
+
+/// One step of the trace.
+struct Edit{
+    enum{ type, backspace, jump } kind;
+    long arg; //!< Character typed, or jump distance.
+};
+
+/// Builds a reproducible trace of `n` edits.
+std::vector<Edit> make_trace(int n){
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::uniform_int_distribution<long> distance(-2000, 2000);
+    std::vector<Edit> trace;
+    for(int i = 0; i < n; i++){
+        int p = pick(gen);
+        if(p < 80) trace.push_back({Edit::type, 'a' + p % 26});
+        else if(p < 98) trace.push_back({Edit::backspace, 0});
+        else trace.push_back({Edit::jump, distance(gen)});
+    }
+    return trace;
+}
+
+template <typename V>
+void run(const char *name, unsigned long n, const std::vector<Edit> &trace){
+    V doc;
+    for(auto i(0ul); i < n; i++){
+        doc.push_back(char('a' + i % 26));
+    }
+    long cursor = n / 2;
+
+    auto start = std::chrono::steady_clock::now();
+    for(const Edit &e : trace){
+        if(e.kind == Edit::type){
+            doc.insert(doc.begin() + cursor, char(e.arg));
+            cursor++;
+        }
+        else if(e.kind == Edit::backspace){
+            if(cursor > 0){
+                doc.erase(doc.begin() + (cursor-1));
+                cursor--;
+            }
+        }
+        else{
+            cursor += e.arg;
+            if(cursor < 0) cursor = 0;
+            if(cursor > long(doc.size())) cursor = doc.size();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double s = std::chrono::duration<double>(end - start).count();
+    std::cout << "  " << name << ": " << trace.size() / s << " edits/s, final size " << doc.size() << "\n";
+}
+
+int main(void){
+    const unsigned long n = 1000000;
+    auto trace = make_trace(200000);
+    std::cout << "Edit trace of " << trace.size() << " edits on " << n << " chars\n";
+    run<sc::vector<char>>("sc::vector<char>", n, trace);
+    run<sc::gap_vector<char>>("sc::gap_vector<char>", n, trace);
+}
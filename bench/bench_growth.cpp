@@ -0,0 +1,60 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../include/vector.h"
+
+/*!
+ * Growth benchmark: cost of building a vector with repeated `push_back`.
+ *
+ * Reports time per push for sc::vector and std::vector, and how many bytes
+ * each sc::vector growth step relocates compared to the bytes pushed.
+ */
+
+/// Record that counts every byte moved or copied into it.
+struct Record{
+    static unsigned long bytes; //!< Bytes relocated (copied or moved) so far.
+    long payload[4];
+
+    Record(long v = 0) : payload{v, v, v, v}{ }
+    Record(const Record& other){ *this = other; }
+    Record(Record&& other) noexcept{ *this = other; }
+    Record& operator=(const Record& other){
+        std::copy(other.payload, other.payload+4, payload);
+        bytes += sizeof(Record);
+        return *this;
+    }
+};
+unsigned long Record::bytes{0};
+
+template <typename Vector, typename T>
+double time_push(unsigned long n, const T& value){
+    auto start = std::chrono::steady_clock::now();
+    Vector v;
+    for(auto i(0ul); i < n; i++){
+        v.push_back(value);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+int main(void){
+    const unsigned long n = 10000000;
+
+    std::cout << "push_back of " << n << " elements (ns/push)\n";
+    std::cout << "  int          sc::vector " << time_push<sc::vector<int>>(n, 42)
+              << "  std::vector " << time_push<std::vector<int>>(n, 42) << "\n";
+    std::string s(32, 'x');
+    std::cout << "  std::string  sc::vector " << time_push<sc::vector<std::string>>(n/10, s)
+              << "  std::vector " << time_push<std::vector<std::string>>(n/10, s) << "\n";
+
+    sc::vector<Record> records;
+    Record r(7);
+    for(auto i(0ul); i < n; i++){
+        records.push_back(r);
+    }
+    double pushed = double(n) * sizeof(Record);
+    std::cout << "Bytes written per byte pushed (" << sizeof(Record) << "-byte records): "
+              << Record::bytes / pushed << "\n";
+    std::cout << "  (1.0 is the push itself, the rest is relocation on growth)\n";
+}
@@ -0,0 +1,56 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../include/vector.h"
+
+/*!
+ * Growth policy benchmark: push throughput and peak RSS of building one large
+ * sc::vector<uint64_t> with each built-in growth policy.
+ *
+ * Each policy runs in its own child process so that its peak RSS (ru_maxrss)
+ * is not polluted by the others.
+ */
+
+const unsigned long n = 50000000; // 400 MB of payload
+
+template <typename Growth>
+void run(const char *name){
+    std::cout.flush();
+    pid_t pid = fork();
+    if(pid == 0){
+        auto start = std::chrono::steady_clock::now();
+        sc::vector<std::uint64_t, std::allocator<std::uint64_t>, Growth> v;
+        unsigned long reallocations = 0;
+        for(auto i(0ul); i < n; i++){
+            auto cap = v.capacity();
+            v.push_back(i);
+            if(v.capacity() != cap) reallocations++;
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / n;
+        std::cout << std::left << std::setw(28) << name
+                  << std::setw(12) << ns
+                  << std::setw(16) << reallocations
+                  << v.capacity() * sizeof(std::uint64_t) / (1024*1024) << std::flush;
+        _exit(v[n-1] == n-1 ? 0 : 1);
+    }
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    std::cout << "\t" << usage.ru_maxrss / 1024 << "\n";
+}
+
+int main(void){
+    std::cout << "push_back of " << n << " uint64_t\n"
+              << std::left << std::setw(28) << "policy" << std::setw(12) << "ns/push"
+              << std::setw(16) << "reallocations" << "final MB\tpeak RSS MB\n";
+    run<sc::growth::doubling>("doubling");
+    run<sc::growth::one_and_half>("one_and_half");
+    run<sc::growth::size_class<>>("size_class<doubling>");
+    run<sc::growth::page_aligned<sc::growth::one_and_half>>("page_aligned<one_and_half>");
+    run<sc::growth::capped_linear<>>("capped_linear<64MB>");
+}
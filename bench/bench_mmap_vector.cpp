@@ -0,0 +1,98 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include "../include/vector.h"
+#include "../include/mmap_vector.h"
+
+/*!
+ * File-backed vector benchmark: loading a file of 16M 32-byte records
+ * (512 MB) by reading it record by record into sc::vector, by reading it
+ * in one go with resize_for_overwrite(), and by opening it as an
+ * sc::mmap_vector; then 1000 random lookups and a full scan on each.
+ *
+ * The file is written first, so it sits in the page cache: the read times
+ * are a lower bound, a cold disk makes the loads slower still.
+ */
+
+struct Record{
+    std::uint64_t id;
+    double price;
+    std::uint32_t quantity, flags;
+    double weight;
+};
+
+volatile double sink; //!< Keeps the results from being optimized away.
+
+using clock_type = std::chrono::steady_clock;
+
+/// Runs f once and prints its time.
+template <typename F>
+void time(const char *name, F f){
+    auto start = clock_type::now();
+    f();
+    std::cout << "  " << name << std::chrono::duration<double, std::milli>(clock_type::now() - start).count() << " ms\n";
+}
+
+/// Lookups and scan on any vector of records.
+template <typename V>
+void use(const V &v){
+    time("1000 random lookups     ", [&]{
+        double s = 0;
+        std::uint64_t i = 12345;
+        for(int k = 0; k < 1000; k++){
+            i = (i * 6364136223846793005ull + 1442695040888963407ull);
+            s += v[(i >> 20) % v.size()].price;
+        }
+        sink = s;
+    });
+    time("full scan               ", [&]{
+        double s = 0;
+        for(const Record &r : v) s += r.price;
+        sink = s;
+    });
+}
+
+int main(void){
+    const unsigned long n = 16ul << 20;
+    const std::string path = "bench_mmap_vector.bin";
+    {
+        sc::mmap_vector<Record> out(path);
+        out.reserve(n);
+        for(auto i(0ul); i < n; i++){
+            out.push_back(Record{i, double(i % 1000), std::uint32_t(i), 0, 1.0});
+        }
+    }
+    std::cout << n << " records of " << sizeof(Record) << " bytes\n";
+
+    std::cout << "ifstream, push_back per record\n";
+    {
+        sc::vector<Record> v;
+        time("load                    ", [&]{
+            std::ifstream in(path, std::ios::binary);
+            Record r;
+            while(in.read(reinterpret_cast<char*>(&r), sizeof r)) v.push_back(r);
+        });
+        use(v);
+    }
+    std::cout << "ifstream, one read into resize_for_overwrite()\n";
+    {
+        sc::vector<Record> v;
+        time("load                    ", [&]{
+            std::ifstream in(path, std::ios::binary);
+            v.resize_for_overwrite(n);
+            in.read(reinterpret_cast<char*>(v.data()), n * sizeof(Record));
+        });
+        use(v);
+    }
+    std::cout << "sc::mmap_vector, read-only\n";
+    {
+        sc::mmap_view<Record> v;
+        time("open                    ", [&]{ v = sc::mmap_view<Record>(path); });
+        use(v);
+    }
+    std::remove(path.c_str());
+    return 0;
+}
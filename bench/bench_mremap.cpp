@@ -0,0 +1,51 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../include/vector.h"
+#include "../include/mmap_allocator.h"
+
+/*!
+ * mremap benchmark: grow a 1 GB sc::vector<uint64_t> with push_back, then
+ * reserve past it, with the default allocator and with sc::mmap_allocator.
+ *
+ * Each run happens in a child process so that its peak RSS is its own.
+ */
+
+const unsigned long n = 128ul * 1024 * 1024; // 1 GB of payload
+
+template <typename Vector>
+void run(const char *name){
+    std::cout.flush();
+    pid_t pid = fork();
+    if(pid == 0){
+        Vector v;
+        auto start = std::chrono::steady_clock::now();
+        for(auto i(0ul); i < n; i++){
+            v.push_back(i);
+        }
+        auto mid = std::chrono::steady_clock::now();
+        v.reserve(v.capacity() + 1); // one more reallocation of the full 1 GB block
+        auto end = std::chrono::steady_clock::now();
+        std::cout << std::left << std::setw(26) << name
+                  << std::setw(12) << std::chrono::duration<double, std::nano>(mid - start).count() / n
+                  << std::setw(16) << std::chrono::duration<double, std::milli>(end - mid).count() << std::flush;
+        _exit(v[n-1] == n-1 ? 0 : 1);
+    }
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    std::cout << usage.ru_maxrss / 1024 << "\n";
+}
+
+int main(void){
+    std::cout << "push_back of " << n << " uint64_t, then one reallocation of the full block\n"
+              << std::left << std::setw(26) << "allocator" << std::setw(12) << "ns/push"
+              << std::setw(16) << "realloc ms" << "peak RSS MB\n";
+    run<sc::vector<std::uint64_t>>("std::allocator");
+    run<sc::large_vector<std::uint64_t>>("mmap_allocator");
+    run<sc::vector<std::uint64_t, sc::mmap_allocator<std::uint64_t, 1024*1024, true>>>("mmap_allocator+hugepage");
+}
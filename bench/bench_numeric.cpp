@@ -0,0 +1,64 @@
+#include <iostream>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include "../include/vector.h"
+#include "../include/numeric.h"
+
+/*!
+ * Numeric benchmark: sc::numeric reductions and scan against the <numeric>
+ * and <algorithm> loops they replace, on sc::vector<float> and
+ * sc::vector<int> of 1M (cache) and 64M (memory) elements.
+ *
+ * Throughput is in GB/s of input read, so memory-bound kernels can be
+ * compared with the machine's bandwidth.
+ */
+
+volatile double sink; //!< Keeps the results from being optimized away.
+
+/// Runs f `reps` times and prints the throughput over `bytes` of input.
+template <typename F>
+void time(const char *name, double bytes, int reps, F f){
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < reps; r++){
+        sink = double(f());
+    }
+    auto end = std::chrono::steady_clock::now();
+    double s = std::chrono::duration<double>(end - start).count();
+    std::cout << "  " << name << bytes * reps / s / 1e9 << " GB/s\n";
+}
+
+template <typename T>
+void run(const char *type, unsigned long n, int reps){
+    sc::vector<T> a, b, out;
+    a.resize(n);
+    b.resize(n);
+    out.resize(n);
+    for(auto i(0ul); i < n; i++){
+        a[i] = T(i % 1000);
+        b[i] = T(i % 7);
+    }
+    const T *first = a.data(), *last = a.data() + n;
+    double bytes = double(n) * sizeof(T);
+    std::cout << type << ", " << n << " elements\n";
+    time("std::accumulate         ", bytes, reps, [&]{ return std::accumulate(first, last, T(0)); });
+    time("numeric::sum            ", bytes, reps, [&]{ return sc::numeric::sum(a); });
+    time("std::minmax_element     ", bytes, reps, [&]{ return *std::minmax_element(first, last).second; });
+    time("numeric::minmax         ", bytes, reps, [&]{ return sc::numeric::minmax(a).second; });
+    time("std::min_element        ", bytes, reps, [&]{ return *std::min_element(first, last); });
+    time("numeric::argmin         ", bytes, reps, [&]{ return a[sc::numeric::argmin(a)]; });
+    time("std::inner_product      ", 2*bytes, reps, [&]{ return std::inner_product(first, last, b.data(), T(0)); });
+    time("numeric::dot            ", 2*bytes, reps, [&]{ return sc::numeric::dot(a, b); });
+    time("std::count_if           ", bytes, reps, [&]{ return std::count_if(first, last, [](T x){ return x < T(500); }); });
+    time("numeric::count_if       ", bytes, reps, [&]{ return sc::numeric::count_if(a, sc::numeric::less_than<T>{T(500)}); });
+    time("std::partial_sum        ", bytes, reps, [&]{ std::partial_sum(first, last, out.data()); return out[n-1]; });
+    time("numeric::inclusive_scan ", bytes, reps, [&]{ sc::numeric::inclusive_scan(first, last, out.data()); return out[n-1]; });
+}
+
+int main(void){
+    std::cout << (sc::simd::has_avx2() ? "AVX2 kernels\n" : "SSE2 kernels\n");
+    run<float>("float", 1 << 20, 500);
+    run<int>("int", 1 << 20, 500);
+    run<float>("float", 64 << 20, 5);
+    run<int>("int", 64 << 20, 5);
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include "../include/vector.h"
+#include "../include/parallel.h"
+
+/*!
+ * Parallel benchmark: strong scaling of sc::parallel over 1 to N threads
+ * (N = hardware threads), on sc::vector<double> of 32M elements.
+ *
+ * With t threads the pool has t-1 workers, as the calling thread works too.
+ * fill and copy are memory-bound and stop scaling at the memory bandwidth;
+ * transform with a costly function and reduce show the compute scaling.
+ */
+
+volatile double sink; //!< Keeps the results from being optimized away.
+
+/// Runs f `reps` times and returns the mean time in milliseconds.
+template <typename F>
+double time(int reps, F f){
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < reps; r++){
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / reps;
+}
+
+int main(void){
+    const unsigned long n = 32ul << 20;
+    const int reps = 5;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if(max_threads == 0) max_threads = 1;
+
+    sc::vector<double> a, b;
+    a.resize(n);
+    b.resize(n);
+    for(auto i(0ul); i < n; i++){
+        a[i] = double(i % 1000) / 1000;
+    }
+
+    std::cout << n << " doubles, times in ms (speedup over 1 thread)\n";
+    double base[5] = {};
+    for(unsigned t = 1; t <= max_threads; t++){
+        sc::thread_pool pool(t-1);
+        sc::parallel::options opt;
+        opt.pool = &pool;
+        double ms[5] = {
+            time(reps, [&]{ sc::parallel::fill(b.begin(), b.end(), 1.0, opt); }),
+            time(reps, [&]{ sc::parallel::copy(a.cbegin(), a.cend(), b.begin(), opt); }),
+            time(reps, [&]{ sc::parallel::transform(a.cbegin(), a.cend(), b.begin(), [](double x){ return std::exp(std::sin(x)); }, opt); }),
+            time(reps, [&]{ sink = sc::parallel::reduce(a.cbegin(), a.cend(), 0.0, std::plus<>{}, opt); }),
+            time(reps, [&]{ opt.deterministic = true; sink = sc::parallel::reduce(a.cbegin(), a.cend(), 0.0, std::plus<>{}, opt); opt.deterministic = false; }),
+        };
+        const char *names[5] = { "fill", "copy", "transform(exp(sin))", "reduce", "reduce (deterministic)" };
+        std::cout << t << " thread(s)\n";
+        for(int k = 0; k < 5; k++){
+            if(t == 1) base[k] = ms[k];
+            std::cout << "  " << names[k] << ": " << ms[k] << " (" << base[k] / ms[k] << "x)\n";
+        }
+    }
+    return 0;
+}
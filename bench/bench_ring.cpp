@@ -0,0 +1,65 @@
+#include <iostream>
+#include <chrono>
+#include "../include/vector.h"
+#include "../include/devector.h"
+#include "../include/ring_vector.h"
+#include "../include/numeric.h"
+
+/*!
+ * Ring vector benchmark: a sliding window over the last 100K samples of
+ * a stream (push the new sample, drop the oldest one).
+ *
+ * sc::vector shifts the whole window on every pop_front(), so each sample
+ * costs O(window); sc::devector does it in amortized O(1) but moves the
+ * window from time to time; sc::ring_vector in overwrite mode does one
+ * store per sample and never allocates. The window mean is then computed
+ * over the ring's two contiguous runs with sc::numeric::sum.
+ */
+
+volatile double sink; //!< Keeps the results alive.
+
+/// Times `ops` iterations of f and prints the throughput.
+template <typename F>
+void time(const char *name, int ops, F f){
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < ops; i++){
+        f(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double s = std::chrono::duration<double>(end - start).count();
+    std::cout << "  " << name << ": " << ops / s << " ops/s\n";
+}
+
+template <typename V>
+void run(const char *name, unsigned long window, int ops){
+    std::cout << name << "\n";
+    V samples;
+    for(auto i(0ul); i < window; i++){
+        samples.push_back(double(i));
+    }
+    time("slide (push_back + pop_front)", ops, [&](int i){
+        samples.push_back(double(i));
+        samples.pop_front();
+    });
+    sink = samples.front();
+}
+
+int main(void){
+    const unsigned long window = 100000;
+    std::cout << "Sliding window of " << window << " doubles\n";
+    run<sc::vector<double>>("sc::vector<double>", window, 2000);
+    run<sc::devector<double>>("sc::devector<double>", window, 5000000);
+
+    std::cout << "sc::ring_vector<double>, overwrite mode\n";
+    sc::ring_vector<double> ring(window, true);
+    for(auto i(0ul); i < window; i++){
+        ring.push_back(double(i));
+    }
+    time("slide (push_back)", 5000000, [&](int i){
+        ring.push_back(double(i));
+    });
+    time("window mean over as_spans()", 2000, [&](int){
+        auto spans = ring.as_spans();
+        sink = (sc::numeric::sum(spans.first) + sc::numeric::sum(spans.second)) / double(ring.size());
+    });
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/vector.h"
+#include "../include/serialize.h"
+#include "../include/mmap_vector.h"
+
+/*!
+ * Serialization benchmark: writing and reading back 32M doubles (256 MB)
+ * with operator<< (the text dump, parsed back with operator>>), with
+ * sc::save/sc::load through a file descriptor and an fstream, and by
+ * mapping the saved file and wrapping it with sc::view.
+ *
+ * The files stay in the page cache, so the times measure the formatting,
+ * copying and checksumming rather than the disk.
+ */
+
+volatile double sink; //!< Keeps the results from being optimized away.
+
+using clock_type = std::chrono::steady_clock;
+
+/// Runs f once and prints its time and throughput over `bytes`.
+template <typename F>
+void time(const char *name, unsigned long bytes, F f){
+    auto start = clock_type::now();
+    f();
+    double ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    std::cout << "  " << name << ms << " ms, " << bytes / ms / 1e6 << " GB/s\n";
+}
+
+int main(void){
+    const unsigned long n = 32ul << 20;
+    const unsigned long bytes = n * sizeof(double);
+    const std::string text_path = "bench_serialize.txt", path = "bench_serialize.bin";
+    sc::vector<double> v;
+    v.reserve(n);
+    for(auto i(0ul); i < n; i++) v.push_back(i * 0.5);
+    std::cout << n << " doubles (" << (bytes >> 20) << " MB)\n";
+
+    std::cout << "operator<< / operator>>\n";
+    time("save                    ", bytes, [&]{
+        std::ofstream out(text_path);
+        out << v;
+    });
+    time("load                    ", bytes, [&]{
+        std::ifstream in(text_path);
+        sc::vector<double> back;
+        back.reserve(n);
+        in.ignore(1); //the opening bracket of the dump
+        double x;
+        while(back.size() < n && in >> x) back.push_back(x);
+        sink = back.empty() ? 0 : back.back();
+    });
+    std::remove(text_path.c_str());
+
+    std::cout << "sc::save / sc::load, file descriptor\n";
+    time("save                    ", bytes, [&]{
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        sc::save(v, fd);
+        ::close(fd);
+    });
+    time("load                    ", bytes, [&]{
+        int fd = ::open(path.c_str(), O_RDONLY);
+        sc::vector<double> back;
+        sc::load(back, fd);
+        ::close(fd);
+        sink = back.back();
+    });
+
+    std::cout << "sc::save / sc::load, fstream\n";
+    time("save                    ", bytes, [&]{
+        std::ofstream out(path, std::ios::binary);
+        sc::save(v, out);
+    });
+    time("load                    ", bytes, [&]{
+        std::ifstream in(path, std::ios::binary);
+        sc::vector<double> back;
+        sc::load(back, in);
+        sink = back.back();
+    });
+
+    std::cout << "mmap + sc::view\n";
+    {
+        sc::mmap_view<char> file(path);
+        time("view, unverified        ", bytes, [&]{ sink = sc::view<double>(file.data(), file.size()).back(); });
+        time("view, verified          ", bytes, [&]{ sink = sc::view<double>(file.data(), file.size(), true).back(); });
+    }
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <chrono>
+#include "../include/vector.h"
+
+/*!
+ * Shift benchmark: insert and erase at the front of a 10M-element vector.
+ *
+ * Every operation shifts the whole tail. For `int` the shift is a single
+ * memmove; `Boxed` wraps an int with user-provided copy/move operations, so
+ * it takes the element-by-element path.
+ */
+
+/// Int wrapper that is not trivially copyable.
+struct Boxed{
+    int value;
+    Boxed(int v = 0) : value{v}{ }
+    Boxed(const Boxed& other) : value{other.value}{ }
+    Boxed(Boxed&& other) noexcept : value{other.value}{ }
+    Boxed& operator=(const Boxed& other){ value = other.value; return *this; }
+    ~Boxed(){ }
+};
+
+template <typename T>
+void run(const char *name, unsigned long n, int ops){
+    sc::vector<T> v;
+    v.reserve(n + ops);
+    for(auto i(0ul); i < n; i++){
+        v.push_back(T(int(i)));
+    }
+    double bytes = double(n) * sizeof(T) * ops;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < ops; i++){
+        v.erase(v.begin());
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for(int i = 0; i < ops; i++){
+        v.insert(v.begin(), T(i));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double erase_s = std::chrono::duration<double>(mid - start).count();
+    double insert_s = std::chrono::duration<double>(end - mid).count();
+    std::cout << name << "\n"
+              << "  erase(begin()):  " << ops / erase_s << " ops/s, " << bytes / erase_s / 1e9 << " GB/s shifted\n"
+              << "  insert(begin()): " << ops / insert_s << " ops/s, " << bytes / insert_s / 1e9 << " GB/s shifted\n";
+}
+
+int main(void){
+    const unsigned long n = 10000000;
+    std::cout << "Front insert/erase on " << n << " elements\n";
+    run<int>("sc::vector<int> (memmove)", n, 200);
+    run<Boxed>("sc::vector<Boxed> (element-wise)", n, 20);
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <chrono>
+#include "../include/vector.h"
+#include "../include/soa_vector.h"
+#include "../include/numeric.h"
+
+/*!
+ * Structure-of-arrays benchmark: scans over one or two fields of 16M
+ * particles, stored as sc::vector<Particle> (array of structures, 48 bytes
+ * per particle) and as sc::soa_vector with one column per field.
+ *
+ * A field scan on the array of structures pulls whole records through the
+ * cache; on the soa_vector it reads only the column, 4 bytes per particle.
+ */
+
+struct Particle{
+    float x, y, z;
+    float vx, vy, vz;
+    float mass, charge;
+    int id, kind;
+    float age, energy;
+};
+
+volatile double sink; //!< Keeps the results from being optimized away.
+
+/// Runs f `reps` times and prints the time per scan.
+template <typename F>
+void time(const char *name, int reps, F f){
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < reps; r++){
+        sink = f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "  " << name << std::chrono::duration<double, std::milli>(end - start).count() / reps << " ms\n";
+}
+
+int main(void){
+    const unsigned long n = 16ul << 20;
+    const int reps = 10;
+    using particles = sc::soa_vector<float, float, float, float, float, float, float, float, int, int, float, float>;
+    sc::vector<Particle> aos;
+    particles soa;
+    aos.reserve(n);
+    soa.reserve(n);
+    for(auto i(0ul); i < n; i++){
+        float f = float(i % 1000);
+        aos.push_back(Particle{f, f, f, 1, 1, 1, 2, 0, int(i), int(i % 4), 0, 0});
+        soa.emplace_back(f, f, f, 1.0f, 1.0f, 1.0f, 2.0f, 0.0f, int(i), int(i % 4), 0.0f, 0.0f);
+    }
+
+    std::cout << n << " particles, " << sizeof(Particle) << " bytes each\n";
+    std::cout << "sum of x\n";
+    time("vector<Particle>        ", reps, [&]{
+        float s = 0;
+        for(const Particle &p : aos) s += p.x;
+        return s;
+    });
+    time("soa_vector column       ", reps, [&]{
+        float s = 0;
+        for(float x : soa.column<0>()) s += x;
+        return s;
+    });
+    time("soa_vector numeric::sum ", reps, [&]{ return sc::numeric::sum(soa.column<0>()); });
+
+    std::cout << "x += vx (two fields)\n";
+    time("vector<Particle>        ", reps, [&]{
+        for(Particle &p : aos) p.x += p.vx;
+        return aos[0].x;
+    });
+    time("soa_vector columns      ", reps, [&]{
+        auto x = soa.column<0>();
+        auto vx = soa.column<3>();
+        for(unsigned long i = 0; i < x.size(); i++) x[i] += vx[i];
+        return x[0];
+    });
+
+    std::cout << "count kind == 3\n";
+    time("vector<Particle>        ", reps, [&]{
+        long c = 0;
+        for(const Particle &p : aos) c += p.kind == 3;
+        return c;
+    });
+    time("soa_vector count_if     ", reps, [&]{
+        return sc::numeric::count_if(soa.column<9>(), sc::numeric::equal_to<int>{3});
+    });
+    return 0;
+}
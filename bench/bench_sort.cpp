@@ -0,0 +1,55 @@
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include "../include/vector.h"
+#include "../include/sort.h"
+
+/*!
+ * Sort benchmark: sc::sort against std::sort on sc::vector of random keys
+ * (100M by default, or the count given as the first argument).
+ *
+ * sc::sort picks the radix sort for the integer and float keys; the
+ * "comparator" rows force the parallel merge sort with std::less on the
+ * global thread pool. Sorting 100M uint64_t needs about 2.4 GB of memory
+ * (input, working copy and the sort's buffer).
+ */
+
+/// Returns the milliseconds taken to sort a copy of `input` with f.
+template <typename T, typename F>
+double time(const sc::vector<T> &input, sc::vector<T> &work, F f){
+    work = input;
+    auto start = std::chrono::steady_clock::now();
+    f(work);
+    auto end = std::chrono::steady_clock::now();
+    if(!std::is_sorted(work.begin(), work.end())) std::cout << "  NOT SORTED\n";
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename T>
+void run(const char *type, unsigned long n, T (*make)(std::uint64_t)){
+    sc::vector<T> input, work;
+    input.reserve(n);
+    std::uint64_t state = 42;
+    for(auto i(0ul); i < n; i++){
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        input.push_back(make(state));
+    }
+    std::cout << type << ", " << n << " keys\n";
+    double base = time(input, work, [](sc::vector<T> &v){ std::sort(v.begin(), v.end()); });
+    std::cout << "  std::sort              " << base << " ms\n";
+    double ms = time(input, work, [](sc::vector<T> &v){ sc::sort(v.begin(), v.end()); });
+    std::cout << "  sc::sort               " << ms << " ms (" << base / ms << "x)\n";
+    ms = time(input, work, [](sc::vector<T> &v){ sc::sort(v.begin(), v.end(), std::less<>{}); });
+    std::cout << "  sc::sort (comparator)  " << ms << " ms (" << base / ms << "x)\n";
+}
+
+int main(int argc, char *argv[]){
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000000ul;
+    std::cout << sc::thread_pool::global().size() + 1 << " thread(s)\n";
+    run<std::uint64_t>("uint64_t", n, [](std::uint64_t r){ return r; });
+    run<int>("int", n, [](std::uint64_t r){ return int(r >> 32); });
+    run<float>("float", n, [](std::uint64_t r){ return float(std::int64_t(r)) / 1e9f; });
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include "../include/vector.h"
+#include "../include/stable_vector.h"
+
+/*!
+ * Stable vector benchmark: 64M push_back() of uint64_t into sc::vector and
+ * sc::stable_vector, timing every push to find the worst-case latency, then
+ * a full scan by index and (stable_vector) by segments.
+ *
+ * sc::vector's worst push copies the whole buffer when it grows; the
+ * stable_vector's worst push allocates one segment.
+ */
+
+volatile std::uint64_t sink; //!< Keeps the scans from being optimized away.
+
+using clock_type = std::chrono::steady_clock;
+
+/// Pushes n values into an empty V, printing the total time, the slowest push and the pushes over 10 us.
+template <typename V>
+void push(const char *name, V &v, unsigned long n){
+    double worst = 0;
+    unsigned long slow = 0;
+    auto start = clock_type::now();
+    for(auto i(0ul); i < n; i++){
+        auto before = clock_type::now();
+        v.push_back(i);
+        double us = std::chrono::duration<double, std::micro>(clock_type::now() - before).count();
+        if(us > worst) worst = us;
+        if(us > 10) slow++;
+    }
+    double total = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    std::cout << "  " << name << total << " ms total, worst push " << worst << " us, " << slow << " pushes over 10 us\n";
+}
+
+/// Runs f once and prints its time.
+template <typename F>
+void time(const char *name, F f){
+    auto start = clock_type::now();
+    sink = f();
+    std::cout << "  " << name << std::chrono::duration<double, std::milli>(clock_type::now() - start).count() << " ms\n";
+}
+
+int main(void){
+    const unsigned long n = 64ul << 20;
+    std::cout << n << " push_back of uint64_t\n";
+    {
+        sc::vector<std::uint64_t> v;
+        push("sc::vector           ", v, n);
+        time("scan by index        ", [&]{
+            std::uint64_t s = 0;
+            for(auto i(0ul); i < n; i++) s += v[i];
+            return s;
+        });
+    }
+    {
+        sc::stable_vector<std::uint64_t> v;
+        push("sc::stable_vector    ", v, n);
+        time("scan by index        ", [&]{
+            std::uint64_t s = 0;
+            for(auto i(0ul); i < n; i++) s += v[i];
+            return s;
+        });
+        time("scan by segments     ", [&]{
+            std::uint64_t s = 0;
+            for(auto k(0ul); k < v.segment_count(); k++){
+                for(std::uint64_t x : v.segment(k)) s += x;
+            }
+            return s;
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include "../include/vector.h"
+#include "../include/text.h"
+
+/*!
+ * Text benchmark: 10M doubles and 10M ints written as comma-separated text
+ * and read back, with iostreams (operator<< per element into an ostringstream,
+ * operator>> per element from an istringstream) and with sc::to_text and
+ * sc::parse_text.
+ */
+
+volatile double sink; //!< Keeps the results from being optimized away.
+
+using clock_type = std::chrono::steady_clock;
+
+/// Runs f once and returns its time in ms.
+template <typename F>
+double time(F f){
+    auto start = clock_type::now();
+    f();
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+/// Formats and parses v both ways, printing the times and the speedups.
+template <typename T>
+void run(const char *name, const sc::vector<T> &v){
+    std::cout << v.size() << " " << name << "\n";
+    std::string text;
+    double stream_out = time([&]{
+        std::ostringstream out;
+        out.precision(17);
+        for(auto i(0ul); i < v.size(); i++){
+            if(i > 0) out << ',';
+            out << v[i];
+        }
+        out << '\n';
+        text = out.str();
+    });
+    double stream_in = time([&]{
+        std::istringstream in(text);
+        sc::vector<T> back;
+        T x;
+        char comma;
+        while(in >> x){
+            back.push_back(x);
+            in >> comma;
+        }
+        sink = double(back.back());
+    });
+    double fast_out = time([&]{ text = sc::to_text(v); });
+    double fast_in = time([&]{
+        sc::vector<T> back;
+        sc::parse_text(back, text);
+        sink = double(back.back());
+    });
+    std::cout << "  iostream       format " << stream_out << " ms, parse " << stream_in << " ms\n";
+    std::cout << "  to_text/parse  format " << fast_out << " ms, parse " << fast_in << " ms ("
+              << text.size() / 1e6 << " MB of text)\n";
+    std::cout << "  speedup        format " << stream_out / fast_out << "x, parse " << stream_in / fast_in << "x\n";
+}
+
+int main(void){
+    const unsigned long n = 10000000;
+    sc::vector<double> doubles;
+    sc::vector<int> ints;
+    std::uint64_t x = 12345;
+    for(auto i(0ul); i < n; i++){
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        doubles.push_back(double(x >> 11) / double(1ull << 53) * 1000.0);
+        ints.push_back(int(x >> 33) - (1 << 30));
+    }
+    run("doubles", doubles);
+    run("ints", ints);
+    return 0;
+}
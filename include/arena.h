@@ -0,0 +1,209 @@
+/*!
+ * \file arena.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include "vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// Monotonic (bump) allocator made of a chain of memory blocks.
+    /*! Allocating only advances a pointer inside the current block, and a new block is
+     * chained when it is full. Nothing is released individually: the whole arena is
+     * rewound to a marker (or reset) at once, and the blocks are kept for reuse until
+     * the arena is destroyed. Meant for batches of short-lived containers, e.g. all
+     * the temporary vectors built while handling one request.
+     */
+    class arena{
+        public:
+            using size_type = unsigned long; //!< The size type.
+
+            /// A position in the arena that rewind() can return to.
+            struct marker{
+                void *block; //!< Block that was current when the marker was taken.
+                size_type used; //!< Bytes used in that block.
+            };
+
+        //=== Private data
+        private:
+            /// Header of a memory block; the usable bytes follow it.
+            struct alignas(std::max_align_t) block{
+                block *next; //!< Next block in the chain.
+                size_type size; //!< Usable bytes in the block.
+                size_type used; //!< Bytes handed out from the block.
+
+                /// Returns the first usable byte of the block.
+                char* begin(){
+                    return reinterpret_cast<char*>(this+1);
+                }
+            };
+
+            block *first_; //!< First block of the chain.
+            block *current_; //!< Block allocations are bumped from.
+            size_type block_size_; //!< Usable bytes of each new block (bigger requests get their own size).
+
+        //=== Private helpers
+        private:
+            /// Hands out `bytes` aligned to `align` from b, or nullptr if they do not fit.
+            static void* bump(block *b, size_type bytes, size_type align){
+                std::uintptr_t base = reinterpret_cast<std::uintptr_t>(b->begin());
+                std::uintptr_t ptr = (base + b->used + align-1) & ~std::uintptr_t(align-1);
+                if(ptr + bytes > base + b->size) return nullptr;
+                b->used = ptr + bytes - base;
+                return reinterpret_cast<void*>(ptr);
+            }
+
+            /// Allocates a block with `size` usable bytes and links it right after the current one.
+            block* add_block(size_type size){
+                block *b = new (::operator new(sizeof(block) + size)) block{nullptr, size, 0};
+                if(current_ == nullptr){
+                    b->next = first_;
+                    first_ = b;
+                }
+                else{
+                    b->next = current_->next;
+                    current_->next = b;
+                }
+                current_ = b;
+                return b;
+            }
+
+        //=== Public interface
+        public:
+            /// Creates an empty arena; the first block is allocated on the first request.
+            explicit arena(size_type block_size = 64*1024)
+                : first_{nullptr}, current_{nullptr}, block_size_{block_size}{
+                /*empty*/
+            }
+
+            arena(const arena&) = delete;
+            arena& operator=(const arena&) = delete;
+
+            /// Releases every block. Objects still living in the arena are not destroyed.
+            ~arena(){
+                while(first_ != nullptr){
+                    block *next = first_->next;
+                    ::operator delete(first_);
+                    first_ = next;
+                }
+            }
+
+            /// Returns `bytes` of storage aligned to `align` (a power of two).
+            void* allocate(size_type bytes, size_type align = alignof(std::max_align_t)){
+                if(current_ != nullptr){
+                    if(void *ptr = bump(current_, bytes, align)) return ptr;
+                    while(current_->next != nullptr){ //blocks kept by a previous rewind
+                        current_ = current_->next;
+                        current_->used = 0;
+                        if(void *ptr = bump(current_, bytes, align)) return ptr;
+                    }
+                }
+                return bump(add_block(std::max(block_size_, bytes + align)), bytes, align);
+            }
+
+            /// Does nothing: storage is reclaimed only by rewind() and reset().
+            void deallocate(void*, size_type){
+                /*empty*/
+            }
+
+            /// Grows the allocation at ptr from old_bytes to new_bytes without moving it.
+            /*! Succeeds only if it is the last allocation of the current block and the block has room. */
+            bool expand(void *ptr, size_type old_bytes, size_type new_bytes){
+                if(current_ == nullptr) return false;
+                char *base = current_->begin();
+                char *p = static_cast<char*>(ptr);
+                if(p + old_bytes != base + current_->used) return false; //not at the tip
+                if(size_type(p - base) + new_bytes > current_->size) return false;
+                current_->used = (p - base) + new_bytes;
+                return true;
+            }
+
+            /// Returns the current position, to be passed later to rewind().
+            marker mark() const{
+                return marker{current_, current_ == nullptr ? 0 : current_->used};
+            }
+
+            /// Releases everything allocated after the marker m was taken.
+            void rewind(marker m){
+                if(m.block == nullptr){
+                    reset();
+                    return;
+                }
+                current_ = static_cast<block*>(m.block);
+                current_->used = m.used;
+            }
+
+            /// Releases everything allocated from the arena, keeping its blocks for reuse.
+            void reset(){
+                current_ = first_;
+                if(current_ != nullptr) current_->used = 0;
+            }
+    };
+
+    /// Allocator adaptor that lets containers (e.g. sc::vector) take their storage from an sc::arena.
+    template <typename T>
+    class arena_allocator{
+        public:
+            using value_type = T; //!< The value type.
+
+        //=== Private data
+        private:
+            arena *arena_; //!< Arena the storage comes from.
+
+        //=== Public interface
+        public:
+            /// Constructor
+            arena_allocator(arena &a) noexcept : arena_{&a}{
+                /*empty*/
+            }
+
+            /// Rebinding constructor.
+            template <typename U>
+            arena_allocator(const arena_allocator<U> &other) noexcept : arena_{other.resource()}{
+                /*empty*/
+            }
+
+            /// Returns storage for n objects of T.
+            T* allocate(std::size_t n){
+                return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+            }
+
+            /// Does nothing: the arena reclaims its storage all at once.
+            void deallocate(T*, std::size_t) noexcept{
+                /*empty*/
+            }
+
+            /// Grows the block at ptr from old_n to new_n objects in place, if it sits at the arena tip.
+            bool expand(T *ptr, std::size_t old_n, std::size_t new_n){
+                return arena_->expand(ptr, old_n * sizeof(T), new_n * sizeof(T));
+            }
+
+            /// Returns the arena the storage comes from.
+            arena* resource() const noexcept{
+                return arena_;
+            }
+
+            /// Returns true if both allocators use the same arena.
+            friend bool operator==(const arena_allocator &lhs, const arena_allocator &rhs){
+                return lhs.arena_ == rhs.arena_;
+            }
+
+            /// Returns true if the allocators use different arenas.
+            friend bool operator!=(const arena_allocator &lhs, const arena_allocator &rhs){
+                return lhs.arena_ != rhs.arena_;
+            }
+    };
+
+    /// sc::vector that takes its storage from an sc::arena.
+    template <typename T>
+    using arena_vector = vector<T, arena_allocator<T>>;
+}
+
+#endif
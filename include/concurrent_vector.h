@@ -0,0 +1,402 @@
+/*!
+ * \file concurrent_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "stable_vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// Vector that many threads can append to at once, without locks; elements never move.
+    /*! The elements live in segments that double in size: segment 0 holds FirstSegment slots
+     * (a power of two) and segment k > 0 holds FirstSegment << (k-1), so element i is in segment
+     * log2(i / FirstSegment) + 1 and the table of segment pointers has a fixed size. Growing
+     * allocates a new segment and never touches the elements already stored, so references
+     * returned by push_back() stay valid for the life of the vector.
+     *
+     * push_back(), emplace_back() and grow_by() claim their slots with one atomic fetch_add on
+     * the size. The first thread to need a segment allocates it and publishes it with a
+     * compare-and-swap; a thread that loses the race frees its own copy and uses the winner's.
+     * No thread ever waits for another one.
+     *
+     * These members may run concurrently with each other and with reads (operator[], at(),
+     * size(), iterators). size() counts the claimed slots, so it can include elements that
+     * are still being built: a reader should only read an element after the thread that
+     * appended it has handed it over (through the returned reference, a flag, a join...).
+     * Everything else (copy, assignment, clear(), swap()) needs exclusive access.
+     *
+     * A constructor that may throw runs before the slot is claimed, on a temporary that is
+     * then moved in, so an exception never leaves a hole; T must be nothrow move constructible
+     * in that case. For the same reason grow_by() needs nothrow default or copy construction.
+     * If a segment cannot be allocated, std::bad_alloc leaves the slots claimed in it empty;
+     * the vector should then only be destroyed.
+     */
+    template <typename T, std::size_t FirstSegment = detail::stable_segment_size<T>()>
+    class concurrent_vector{
+        static_assert(FirstSegment > 0 && (FirstSegment & (FirstSegment - 1)) == 0, "FirstSegment must be a power of two");
+
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using pointer = value_type*; //!< Pointer to a value stored in the container.
+            using reference = value_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+
+        //=== Private data
+        private:
+            /// log2(FirstSegment).
+            static constexpr unsigned shift = [] {
+                unsigned s = 0;
+                while((size_type(1) << s) < FirstSegment) s++;
+                return s;
+            }();
+            static constexpr unsigned max_segments = 64 - shift + 1; //!< Enough segments for any size_type index.
+
+            std::atomic<T*> segments_[max_segments]; //!< Segment pointers, nullptr until allocated.
+            std::atomic<size_type> size_; //!< Number of slots claimed.
+
+        //=== Raw storage helpers
+        private:
+            /// Returns the segment of element i.
+            static unsigned segment_of(size_type i){
+                if(i < FirstSegment) return 0;
+#if defined(__GNUC__)
+                return unsigned(63 - __builtin_clzl(i)) - shift + 1;
+#else
+                unsigned k = 1;
+                while((i >> shift) >> k) k++;
+                return k;
+#endif
+            }
+
+            /// Returns the index of the first element of segment k.
+            static size_type segment_base(unsigned k){
+                return k == 0 ? 0 : size_type(FirstSegment) << (k - 1);
+            }
+
+            /// Returns the number of slots of segment k.
+            static size_type segment_length(unsigned k){
+                return k == 0 ? FirstSegment : size_type(FirstSegment) << (k - 1);
+            }
+
+            /// Returns segment k, allocating it if no thread has yet.
+            T* ensure_segment(unsigned k){
+                T *segment = segments_[k].load(std::memory_order_acquire);
+                if(segment != nullptr) return segment;
+                T *fresh = std::allocator<T>().allocate(segment_length(k));
+                if(segments_[k].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel, std::memory_order_acquire)){
+                    return fresh;
+                }
+                std::allocator<T>().deallocate(fresh, segment_length(k)); //another thread won: use its segment
+                return segment;
+            }
+
+            /// Returns the slot of element i, whose segment must exist.
+            T* slot(size_type i) const{
+                unsigned k = segment_of(i);
+                return segments_[k].load(std::memory_order_acquire) + (i - segment_base(k));
+            }
+
+            /// Claims n slots at the end; returns the index of the first one. Their segments are allocated.
+            size_type claim(size_type n){
+                size_type first = size_.fetch_add(n, std::memory_order_relaxed);
+                if(n > 0){
+                    for(unsigned k = segment_of(first), last = segment_of(first + n - 1); k <= last; k++){
+                        ensure_segment(k);
+                    }
+                }
+                return first;
+            }
+
+            /// Releases every segment. The objects must be already destroyed.
+            void release(){
+                for(unsigned k = 0; k < max_segments; k++){
+                    T *segment = segments_[k].exchange(nullptr, std::memory_order_relaxed);
+                    if(segment != nullptr) std::allocator<T>().deallocate(segment, segment_length(k));
+                }
+            }
+
+        //=== Public interface
+        public:
+            /// Constructor
+            concurrent_vector() : size_{0}{
+                for(auto &segment : segments_){
+                    segment.store(nullptr, std::memory_order_relaxed);
+                }
+            }
+
+            /// Constructor with a list of values.
+            concurrent_vector(std::initializer_list<T> ilist) : concurrent_vector(){
+                reserve(ilist.size());
+                for(const T &value : ilist){
+                    push_back(value);
+                }
+            }
+
+            /// Copy constructor. other must not be appended to meanwhile.
+            /*! If a copy throws, the delegated-to constructor has finished, so the destructor frees what was built so far. */
+            concurrent_vector(const concurrent_vector& other) : concurrent_vector(){
+                reserve(other.size());
+                for(size_type i = 0; i < other.size(); i++){
+                    push_back(other[i]);
+                }
+            }
+
+            /// Move constructor. Leaves other empty; references to its elements now refer into this one.
+            concurrent_vector(concurrent_vector&& other) noexcept : concurrent_vector(){
+                swap(other);
+            }
+
+            /// Destructor
+            ~concurrent_vector(){
+                clear();
+                release();
+            }
+
+            /// Copy assignment.
+            concurrent_vector& operator=(const concurrent_vector& other){
+                if(this != &other){
+                    concurrent_vector copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            /// Move assignment.
+            concurrent_vector& operator=(concurrent_vector&& other) noexcept{
+                concurrent_vector moved(std::move(other));
+                swap(moved);
+                return *this;
+            }
+
+            /// Returns the number of elements, counting those still being appended.
+            size_type size() const{
+                return size_.load(std::memory_order_acquire);
+            }
+
+            /// Returns true if there are no elements.
+            bool empty() const{
+                return size() == 0;
+            }
+
+            /// Returns the number of slots in the allocated segments.
+            size_type capacity() const{
+                size_type total = 0;
+                for(unsigned k = 0; k < max_segments; k++){
+                    if(segments_[k].load(std::memory_order_acquire) != nullptr) total += segment_length(k);
+                }
+                return total;
+            }
+
+            /// Allocates the segments needed for new_cap elements. Safe to call while other threads append.
+            void reserve(size_type new_cap){
+                if(new_cap == 0) return;
+                for(unsigned k = 0, last = segment_of(new_cap - 1); k <= last; k++){
+                    ensure_segment(k);
+                }
+            }
+
+            /// Removes every element. The segments are kept. Not safe while other threads use the vector.
+            void clear(){
+                size_type n = size_.load(std::memory_order_relaxed);
+                if(!std::is_trivially_destructible<T>::value){
+                    for(unsigned k = 0; k < max_segments && segment_base(k) < n; k++){
+                        T *segment = segments_[k].load(std::memory_order_relaxed);
+                        if(segment == nullptr) continue; //its allocation failed: nothing was built there
+                        size_type end = std::min(segment_length(k), n - segment_base(k));
+                        for(size_type i = 0; i < end; i++){
+                            segment[i].~T();
+                        }
+                    }
+                }
+                size_.store(0, std::memory_order_relaxed);
+            }
+
+            /// Builds an element at the end from args. Returns a reference to it, valid as long as the vector.
+            template <typename... Args>
+            reference emplace_back(Args&&... args){
+                if constexpr(std::is_nothrow_constructible<T, Args&&...>::value){
+                    T *p = slot(claim(1));
+                    new (p) T(std::forward<Args>(args)...);
+                    return *p;
+                }
+                else{
+                    static_assert(std::is_nothrow_move_constructible<T>::value,
+                                  "concurrent_vector needs nothrow move construction when the constructor used may throw");
+                    T item(std::forward<Args>(args)...); //may throw: no slot is claimed yet
+                    T *p = slot(claim(1));
+                    new (p) T(std::move(item));
+                    return *p;
+                }
+            }
+
+            /// Adds a copy of value at the end. Returns a reference to it.
+            reference push_back(const T& value){
+                return emplace_back(value);
+            }
+
+            /// Moves value to the end. Returns a reference to it.
+            reference push_back(T&& value){
+                return emplace_back(std::move(value));
+            }
+
+            /// Returns a reference to the element at pos.
+            reference operator[](size_type pos){
+                return *slot(pos);
+            }
+
+            /// Returns a const reference to the element at pos.
+            const_reference operator[](size_type pos) const{
+                return *slot(pos);
+            }
+
+            /// Returns the object at the index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            reference at(size_type pos){
+                if(pos >= size()){
+                    throw std::out_of_range("[concurrent_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return *slot(pos);
+            }
+
+            /// Returns the object at the index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            const_reference at(size_type pos) const{
+                if(pos >= size()){
+                    throw std::out_of_range("[concurrent_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return *slot(pos);
+            }
+
+            reference front(){ return *slot(0); }
+            const_reference front() const{ return *slot(0); }
+            reference back(){ return *slot(size()-1); }
+            const_reference back() const{ return *slot(size()-1); }
+
+            /// Exchanges the contents with other. No element moves. Not safe while other threads use either vector.
+            void swap(concurrent_vector& other) noexcept{
+                for(unsigned k = 0; k < max_segments; k++){
+                    T *mine = segments_[k].load(std::memory_order_relaxed);
+                    segments_[k].store(other.segments_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    other.segments_[k].store(mine, std::memory_order_relaxed);
+                }
+                size_type mine = size_.load(std::memory_order_relaxed);
+                size_.store(other.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                other.size_.store(mine, std::memory_order_relaxed);
+            }
+
+        //=== Iterators
+            /// Random access iterator: an index into the vector, resolved through the segment table.
+            template <typename V, typename U>
+            class basic_iterator{
+                public:
+                    typedef U& reference; //!< Reference to the value type.
+                    typedef U* pointer; //!< Pointer to the value type.
+                    typedef T value_type; //!< Value type the iterator points to.
+                    /// Difference type used to calculated distance between iterators.
+                    typedef std::ptrdiff_t difference_type;
+                    /// Identifies the iterator category to algorithms from STL
+                    typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+                //=== Private data
+                private:
+                    V *vec; //!< The vector iterated.
+                    size_type pos_; //!< Index of the element the iterator points to.
+
+                    template <typename, typename> friend class basic_iterator;
+                //=== Public interface
+                public:
+                    /// Constructor
+                    basic_iterator(V *v = nullptr, size_type pos = 0) : vec{v}, pos_{pos}{ }
+
+                    /// Converts an iterator to a const_iterator.
+                    template <typename W, typename X, typename = std::enable_if_t<std::is_convertible<X*, U*>::value>>
+                    basic_iterator(const basic_iterator<W, X> &other) : vec{other.vec}, pos_{other.pos_}{ }
+
+                    reference operator*() const{ return (*vec)[pos_]; }
+                    pointer operator->() const{ return &(*vec)[pos_]; }
+                    reference operator[](difference_type n) const{ return (*vec)[pos_ + n]; }
+
+                    basic_iterator& operator++(){ pos_++; return *this; }
+                    basic_iterator operator++(int){ basic_iterator old(*this); pos_++; return old; }
+                    basic_iterator& operator--(){ pos_--; return *this; }
+                    basic_iterator operator--(int){ basic_iterator old(*this); pos_--; return old; }
+                    basic_iterator& operator+=(difference_type n){ pos_ += n; return *this; }
+                    basic_iterator& operator-=(difference_type n){ pos_ -= n; return *this; }
+
+                    friend basic_iterator operator+(basic_iterator it, difference_type n){ return it += n; }
+                    friend basic_iterator operator+(difference_type n, basic_iterator it){ return it += n; }
+                    friend basic_iterator operator-(basic_iterator it, difference_type n){ return it -= n; }
+                    friend difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return difference_type(lhs.pos_) - difference_type(rhs.pos_);
+                    }
+
+                    friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ == rhs.pos_; }
+                    friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ != rhs.pos_; }
+                    friend bool operator<(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ < rhs.pos_; }
+                    friend bool operator>(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ > rhs.pos_; }
+                    friend bool operator<=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ <= rhs.pos_; }
+                    friend bool operator>=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ >= rhs.pos_; }
+            };
+
+            using iterator = basic_iterator<concurrent_vector, T>; //!< Iterator.
+            using const_iterator = basic_iterator<const concurrent_vector, const T>; //!< Const iterator.
+
+            /// Iterators over the elements claimed when begin()/end() is called. Safe while other threads append.
+            iterator begin(){ return iterator(this, 0); }
+            iterator end(){ return iterator(this, size()); }
+            const_iterator begin() const{ return const_iterator(this, 0); }
+            const_iterator end() const{ return const_iterator(this, size()); }
+            const_iterator cbegin() const{ return begin(); }
+            const_iterator cend() const{ return end(); }
+
+        //=== Bulk append
+            /// Appends n value-initialized elements with consecutive indices. Returns an iterator to the first one.
+            iterator grow_by(size_type n){
+                static_assert(std::is_nothrow_default_constructible<T>::value,
+                              "grow_by(n) needs a nothrow default constructor: a throw would leave claimed slots empty");
+                size_type first = claim(n);
+                for(size_type i = first; i < first + n; i++){
+                    new (slot(i)) T();
+                }
+                return iterator(this, first);
+            }
+
+            /// Appends n copies of value with consecutive indices. Returns an iterator to the first one.
+            iterator grow_by(size_type n, const T& value){
+                static_assert(std::is_nothrow_copy_constructible<T>::value,
+                              "grow_by(n, value) needs a nothrow copy constructor: a throw would leave claimed slots empty");
+                size_type first = claim(n);
+                for(size_type i = first; i < first + n; i++){
+                    new (slot(i)) T(value);
+                }
+                return iterator(this, first);
+            }
+    };
+
+    /// Exchanges the contents of lhs and rhs.
+    template <typename T, std::size_t S>
+    void swap(concurrent_vector<T, S> &lhs, concurrent_vector<T, S> &rhs) noexcept{
+        lhs.swap(rhs);
+    }
+}
+
+#endif
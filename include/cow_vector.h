@@ -0,0 +1,252 @@
+/*!
+ * \file cow_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <initializer_list>
+#include "vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// Copy-on-write vector: copies share one buffer, which is cloned on the first change made through a shared copy.
+    /*! The elements live in an sc::vector inside a block with an atomic reference count.
+     * Copying a cow_vector adds a reference, O(1) whatever the size; a member that changes
+     * the elements first checks the count and, if another copy still uses the block, clones
+     * it (one deep copy) and drops its reference to the shared one. So a copy is a snapshot:
+     * later changes to any other copy never show through it.
+     *
+     * Reading never clones: operator[], at(), front(), back(), data() and the iterators
+     * return const references even on a non-const vector. Elements are changed through
+     * set(), modify() (a reference to one element) and mutable_data(). A reference or pointer
+     * from modify() or mutable_data() must not be used after the vector is copied, since the
+     * element it refers to is then shared.
+     *
+     * Different cow_vector objects may be used by different threads at the same time, even
+     * when they share a block: only the reference count is shared state, and it is atomic.
+     * One object used by several threads needs a lock, as with std::shared_ptr.
+     */
+    template <typename T>
+    class cow_vector{
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using reference = value_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+            using const_iterator = typename vector<T>::const_iterator; //!< Same iterators as sc::vector.
+            using iterator = const_iterator; //!< Iterators never allow changes, so they never clone.
+            using const_reverse_iterator = typename vector<T>::const_reverse_iterator; //!< Same iterators as sc::vector.
+
+        //=== Private data
+        private:
+            /// Shared buffer: the elements and the number of cow_vectors using them.
+            struct block{
+                std::atomic<size_type> refs; //!< Number of cow_vectors using the block.
+                vector<T> items; //!< The elements.
+
+                explicit block(vector<T> v) : refs{1}, items(std::move(v)){ }
+            };
+
+            block *block_; //!< The elements, or nullptr while there are none.
+
+        //=== Private helpers
+        private:
+            /// Drops this vector's reference to its block, deleting it if it was the last one.
+            void release() noexcept{
+                if(block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                    delete block_;
+                }
+                block_ = nullptr;
+            }
+
+            /// Makes this vector the only user of its block, cloning it if it is shared. Returns the elements.
+            vector<T>& detach(){
+                if(block_ == nullptr){
+                    block_ = new block(vector<T>());
+                }
+                else if(block_->refs.load(std::memory_order_acquire) != 1){
+                    block *clone = new block(block_->items); //the deep copy happens here, once per snapshot
+                    release();
+                    block_ = clone;
+                }
+                return block_->items;
+            }
+
+        //=== Public interface
+        public:
+            /// Constructor: an empty vector, with no block.
+            cow_vector() noexcept : block_{nullptr}{ }
+
+            /// Constructor with a list of values.
+            cow_vector(std::initializer_list<T> ilist) : block_{new block(vector<T>(ilist))}{ }
+
+            /// Takes the elements of v, without copying them if v is an rvalue.
+            explicit cow_vector(vector<T> v) : block_{new block(std::move(v))}{ }
+
+            /// Copy constructor: shares other's block. O(1).
+            cow_vector(const cow_vector& other) noexcept : block_{other.block_}{
+                if(block_ != nullptr) block_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /// Move constructor. Leaves other empty.
+            cow_vector(cow_vector&& other) noexcept : block_{other.block_}{
+                other.block_ = nullptr;
+            }
+
+            /// Destructor
+            ~cow_vector(){
+                release();
+            }
+
+            /// Copy assignment: shares other's block. O(1).
+            cow_vector& operator=(const cow_vector& other) noexcept{
+                cow_vector copy(other);
+                swap(copy);
+                return *this;
+            }
+
+            /// Move assignment.
+            cow_vector& operator=(cow_vector&& other) noexcept{
+                cow_vector moved(std::move(other));
+                swap(moved);
+                return *this;
+            }
+
+            /// Returns the number of elements.
+            size_type size() const{
+                return block_ == nullptr ? 0 : block_->items.size();
+            }
+
+            /// Returns the number of elements the block can hold without growing.
+            size_type capacity() const{
+                return block_ == nullptr ? 0 : block_->items.capacity();
+            }
+
+            /// Returns true if there are no elements.
+            bool empty() const{
+                return size() == 0;
+            }
+
+            /// Returns how many cow_vectors share this one's elements (0 if it has none).
+            size_type use_count() const{
+                return block_ == nullptr ? 0 : block_->refs.load(std::memory_order_acquire);
+            }
+
+            /// Returns the elements as a read-only sc::vector.
+            const vector<T>& items() const{
+                static const vector<T> none;
+                return block_ == nullptr ? none : block_->items;
+            }
+
+            /// Returns a const reference to the element at pos.
+            const_reference operator[](size_type pos) const{
+                return block_->items[pos];
+            }
+
+            /// Returns a const reference to the element at pos. Throws std::out_of_range if pos >= size().
+            const_reference at(size_type pos) const{
+                if(pos >= size()) throw std::out_of_range("Index out of range.");
+                return block_->items[pos];
+            }
+
+            const_reference front() const{ return block_->items.front(); }
+            const_reference back() const{ return block_->items.back(); }
+
+            /// Returns a pointer to the elements, for reading.
+            const T* data() const{
+                return block_ == nullptr ? nullptr : block_->items.data();
+            }
+
+            /// Replaces the element at pos with value, cloning the block first if it is shared.
+            void set(size_type pos, const T& value){
+                detach()[pos] = value;
+            }
+
+            /// Returns a reference to the element at pos, cloning the block first if it is shared.
+            reference modify(size_type pos){
+                return detach()[pos];
+            }
+
+            /// Returns a pointer to the elements for writing, cloning the block first if it is shared.
+            T* mutable_data(){
+                return detach().data();
+            }
+
+            /// Builds an element at the end from args.
+            template <typename... Args>
+            void emplace_back(Args&&... args){
+                detach().emplace_back(std::forward<Args>(args)...);
+            }
+
+            /// Adds a copy of value at the end.
+            void push_back(const T& value){
+                detach().push_back(value);
+            }
+
+            /// Moves value to the end.
+            void push_back(T&& value){
+                detach().push_back(std::move(value));
+            }
+
+            /// Removes the last element.
+            void pop_back(){
+                detach().pop_back();
+            }
+
+            /// Resizes to count elements. New elements are value-initialized.
+            void resize(size_type count){
+                detach().resize(count);
+            }
+
+            /// Makes room for at least new_cap elements.
+            void reserve(size_type new_cap){
+                if(new_cap > capacity() || use_count() > 1) detach().reserve(new_cap);
+            }
+
+            /// Removes every element. A shared block is just let go, not cloned.
+            void clear(){
+                if(use_count() > 1) release();
+                else if(block_ != nullptr) block_->items.clear();
+            }
+
+            /// Exchanges the contents with other. O(1).
+            void swap(cow_vector& other) noexcept{
+                std::swap(block_, other.block_);
+            }
+
+        //=== Getting an iterator
+            const_iterator begin() const{ return const_iterator(data()); }
+            const_iterator end() const{ return const_iterator(data() + size()); }
+            const_iterator cbegin() const{ return begin(); }
+            const_iterator cend() const{ return end(); }
+            const_reverse_iterator rbegin() const{ return const_reverse_iterator(end()); }
+            const_reverse_iterator rend() const{ return const_reverse_iterator(begin()); }
+    };
+
+    /// Checks if the contents of lhs and rhs are equal. O(1) when they share a block.
+    template <typename T>
+    bool operator==(const cow_vector<T> &lhs, const cow_vector<T> &rhs){
+        if(lhs.data() == rhs.data()) return lhs.size() == rhs.size();
+        return lhs.items() == rhs.items();
+    }
+
+    /// Checks if the contents of lhs and rhs are different.
+    template <typename T>
+    bool operator!=(const cow_vector<T> &lhs, const cow_vector<T> &rhs){
+        return !(lhs == rhs);
+    }
+
+    /// Exchanges the contents of lhs and rhs.
+    template <typename T>
+    void swap(cow_vector<T> &lhs, cow_vector<T> &rhs) noexcept{
+        lhs.swap(rhs);
+    }
+}
+
+#endif
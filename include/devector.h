@@ -0,0 +1,572 @@
+/*!
+ * \file devector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef DEVECTOR_H
+#define DEVECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// Double-ended vector: a contiguous array with spare capacity at both ends.
+    /*! The elements occupy [front_, front_+size_) of the block, so push_front()/pop_front()
+     * cost the same as push_back()/pop_back(): amortized O(1). When one end runs out of room
+     * the elements are recentered if the block is at most half full, or moved to a block
+     * twice as large otherwise; either way the spare room is split between both ends.
+     * Storage stays contiguous, so iterators and operator[] are plain pointers, as in sc::vector.
+     */
+    template <typename T>
+    class devector{
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using pointer = value_type*; //!< Pointer to a value stored in the container.
+            using reference = value_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+            using iterator = typename vector<T>::iterator; //!< Same iterators as sc::vector.
+            using const_iterator = typename vector<T>::const_iterator; //!< Same iterators as sc::vector.
+            using reverse_iterator = typename vector<T>::reverse_iterator; //!< Same iterators as sc::vector.
+            using const_reverse_iterator = typename vector<T>::const_reverse_iterator; //!< Same iterators as sc::vector.
+
+        //=== Private data
+        private:
+            T *block; //!< Storage area. Only [front_, front_+size_) holds live objects.
+            size_type front_; //!< Free slots before the first element.
+            size_type size_; //!< Number of elements currently in the devector.
+            size_type capacity_; //!< Total slots in the block.
+
+        //=== Raw storage helpers
+        private:
+            /// Returns uninitialized storage for `n` objects of T.
+            static T* allocate(size_type n){
+                if(n == 0) return nullptr;
+                return std::allocator<T>().allocate(n);
+            }
+
+            /// Releases the block. The objects in it must be already destroyed.
+            void release(){
+                if(block != nullptr) std::allocator<T>().deallocate(block, capacity_);
+            }
+
+            /// Destroys the objects in [first, last) without releasing their storage.
+            static void destroy(T *first, T *last){
+                if constexpr(!std::is_trivially_destructible<T>::value){
+                    for(; first != last; first++){
+                        first->~T();
+                    }
+                }
+            }
+
+            /// Moves the objects in [first, last) into the uninitialized storage at dest and destroys the originals.
+            /*! The ranges may overlap. Trivially relocatable types are moved with a single memmove. */
+            static void relocate(T *first, T *last, T *dest){
+                if constexpr(is_trivially_relocatable<T>::value){
+                    if(first != last) std::memmove(static_cast<void*>(dest), first, (last-first) * sizeof(T));
+                }
+                else if(dest <= first){
+                    for(; first != last; first++, dest++){
+                        new (dest) T(std::move_if_noexcept(*first));
+                        first->~T();
+                    }
+                }
+                else{ //overlapping shift to the right: walk backwards
+                    for(dest += last-first; last != first; ){
+                        last--; dest--;
+                        new (dest) T(std::move_if_noexcept(*last));
+                        last->~T();
+                    }
+                }
+            }
+
+            /// Returns a pointer to the first element.
+            T* first() const{
+                return block + front_;
+            }
+
+        //=== Growth engine
+            /// Makes room for `n` more elements before the first one (at_front) or after the last one.
+            /*! Recenters the elements if the block is at most half full, so alternating pushes at one end
+             * and pops at the other cost O(1) amortized; otherwise moves them to a block twice as large.
+             * The spare room left after the request is split evenly between both ends.
+             */
+            void make_room(size_type n, bool at_front){
+                if((at_front ? front_ : back_capacity()) >= n) return;
+                if(size_ + n <= capacity_/2){
+                    size_type spare = (capacity_ - size_ - n) / 2;
+                    size_type new_front = at_front ? n + spare : spare;
+                    relocate(first(), first()+size_, block+new_front);
+                    front_ = new_front;
+                    return;
+                }
+                size_type new_cap = capacity_*2 < size_+n ? size_+n : capacity_*2;
+                size_type spare = (new_cap - size_ - n) / 2;
+                rebuild(new_cap, at_front ? n + spare : spare, size_, 0);
+            }
+
+            /// Moves the elements into a new block of new_cap slots starting at new_front, leaving `gap` free slots before position pos.
+            void rebuild(size_type new_cap, size_type new_front, size_type pos, size_type gap){
+                T *new_block = allocate(new_cap);
+                relocate(first(), first()+pos, new_block+new_front);
+                relocate(first()+pos, first()+size_, new_block+new_front+pos+gap);
+                release();
+                block = new_block;
+                front_ = new_front;
+                capacity_ = new_cap;
+            }
+
+            /// Opens `n` uninitialized slots before position pos, shifting whichever side of pos is shorter.
+            void open_gap(size_type pos, size_type n){
+                if(pos < size_-pos && front_ >= n){
+                    relocate(first(), first()+pos, first()-n);
+                    front_ -= n;
+                }
+                else if(back_capacity() >= n){
+                    relocate(first()+pos, first()+size_, first()+pos+n);
+                }
+                else if(front_ >= n){
+                    relocate(first(), first()+pos, first()-n);
+                    front_ -= n;
+                }
+                else{
+                    size_type new_cap = capacity_*2 < size_+n ? size_+n : capacity_*2;
+                    rebuild(new_cap, (new_cap - size_ - n) / 2, pos, n);
+                }
+            }
+
+            /// Destroys the elements in [pos, pos+n) and closes the gap, shifting whichever side is shorter.
+            void close_gap(size_type pos, size_type n){
+                destroy(first()+pos, first()+pos+n);
+                if(pos < size_-pos-n){
+                    relocate(first(), first()+pos, first()+n);
+                    front_ += n;
+                }
+                else{
+                    relocate(first()+pos+n, first()+size_, first()+pos);
+                }
+                size_ -= n;
+            }
+
+        //=== Public interface
+        public:
+        //=== Constructors, Destructors, and Assignment.
+            /// Default constructor that creates an empty list. Never allocates.
+            devector() : block{nullptr}, front_{0}, size_{0}, capacity_{0}{
+                /*empty*/
+            }
+
+            /// Constructs an empty list with room for count elements, split between both ends.
+            explicit devector(size_type count) : devector(){
+                reserve(count);
+            }
+
+            /// Constructs the list with the contents of the range [first, last).
+            template <typename InputIt>
+            devector(InputIt first, InputIt last) : devector(){
+                for(; first != last; first++){
+                    emplace_back(*first);
+                }
+            }
+
+            /// Copy constructor. Constructs the list with the deep copy of the contents of other.
+            devector(const devector& other) : devector(){
+                block = allocate(other.size_);
+                capacity_ = other.size_;
+                for(; size_ < other.size_; size_++){
+                    new (&block[size_]) T(other.first()[size_]);
+                }
+            }
+
+            /// Move constructor. Takes over the storage of other, which is left empty.
+            devector(devector&& other) noexcept : devector(){
+                swap(other);
+            }
+
+            /// Constructs the list with the contents of the initializer list init.
+            devector(std::initializer_list<T> ilist) : devector(ilist.begin(), ilist.end()){
+                /*empty*/
+            }
+
+            /// Destructs the list.
+            ~devector(){
+                destroy(first(), first()+size_);
+                release();
+            }
+
+            /// Copy assignment operator. Replaces the contents with a copy of the contents of other.
+            devector& operator=(const devector& other){
+                if(this != &other){
+                    devector copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            /// Move assignment operator. Replaces the contents with those of other, which is left empty.
+            devector& operator=(devector&& other) noexcept{
+                if(this != &other){
+                    devector moved(std::move(other));
+                    swap(moved);
+                }
+                return *this;
+            }
+
+            /// Replaces the contents with those identified by initializer list ilist
+            devector& operator=(std::initializer_list<T> ilist){
+                assign(ilist);
+                return *this;
+            }
+
+        //=== Common operations to all list implementations
+            /// Return the number of elements in the container.
+            size_type size() const{
+                return size_;
+            }
+
+            /// Remove (either logically or physically) all elements from the container.
+            /*! The spare room is split again between both ends. */
+            void clear(){
+                destroy(first(), first()+size_);
+                size_ = 0;
+                front_ = capacity_/2;
+            }
+
+            /// Returns true if the container contains no elements, and false otherwise.
+            bool empty() const{
+                return size_ == 0;
+            }
+
+            /// Adds value to the front of the list. Amortized O(1).
+            void push_front(const T &value){
+                emplace_front(value);
+            }
+
+            /// Moves value to the front of the list. Amortized O(1).
+            void push_front(T &&value){
+                emplace_front(std::move(value));
+            }
+
+            /// Adds value to the end of the list. Amortized O(1).
+            void push_back(const T &value){
+                emplace_back(value);
+            }
+
+            /// Moves value to the end of the list. Amortized O(1).
+            void push_back(T &&value){
+                emplace_back(std::move(value));
+            }
+
+            /// Constructs a new element at the front of the list from args, in place.
+            template <typename... Args>
+            T& emplace_front(Args&&... args){
+                if(front_ == 0){
+                    T item(std::forward<Args>(args)...); //args may live in the block that is about to move
+                    make_room(1, true);
+                    new (first()-1) T(std::move(item));
+                }
+                else{
+                    new (first()-1) T(std::forward<Args>(args)...);
+                }
+                front_ -= 1;
+                size_ += 1;
+                return *first();
+            }
+
+            /// Constructs a new element at the end of the list from args, in place.
+            template <typename... Args>
+            T& emplace_back(Args&&... args){
+                if(back_capacity() == 0){
+                    T item(std::forward<Args>(args)...); //args may live in the block that is about to move
+                    make_room(1, false);
+                    new (first()+size_) T(std::move(item));
+                }
+                else{
+                    new (first()+size_) T(std::forward<Args>(args)...);
+                }
+                size_ += 1;
+                return first()[size_-1];
+            }
+
+            /// Removes the object at the end of the list. O(1).
+            void pop_back(){
+                if(size_ > 0){
+                    size_ -= 1;
+                    destroy(first()+size_, first()+size_+1);
+                }
+            }
+
+            /// Removes the object at the front of the list. O(1).
+            void pop_front(){
+                if(size_ > 0){
+                    destroy(first(), first()+1);
+                    front_ += 1;
+                    size_ -= 1;
+                }
+            }
+
+            /// Returns the object at the end of the list.
+            const T& back() const{
+                return first()[size_-1];
+            }
+
+            /// Returns the object at the end of the list.
+            T& back(){
+                return first()[size_-1];
+            }
+
+            /// Returns the object at the beginning of the list.
+            const T& front() const{
+                return *first();
+            }
+
+            /// Returns the object at the beginning of the list.
+            T& front(){
+                return *first();
+            }
+
+            /// Replaces the content of the list with count copies of value.
+            void assign(size_type count, const T& value){
+                devector filled;
+                filled.reserve(count);
+                for(auto i(0u); i < count; i++){
+                    filled.emplace_back(value);
+                }
+                swap(filled);
+            }
+
+            /// Replaces the contents of the list with the elements from the initializer list ilist
+            void assign(std::initializer_list<T> ilist){
+                devector filled(ilist);
+                swap(filled);
+            }
+
+        //=== Operations exclusive to dynamic array implementation
+            /// Returns the object at the index pos in the array, with no bounds-checking.
+            T & operator[](size_type pos){
+                return first()[pos];
+            }
+
+            /// Returns the object at the index pos in the array, with no bounds-checking.
+            const T & operator[](size_type pos) const{
+                return first()[pos];
+            }
+
+            /// Returns the object at the index pos in the array, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            T & at(size_type pos){
+                if(pos >= size_){
+                    throw std::out_of_range("[devector::at()] Position entered beyond vector boundaries.");
+                }
+                return first()[pos];
+            }
+
+            /// Returns the object at the index pos in the array, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            const T & at(size_type pos) const{
+                if(pos >= size_){
+                    throw std::out_of_range("[devector::at()] Position entered beyond vector boundaries.");
+                }
+                return first()[pos];
+            }
+
+            /// Return the internal storage capacity of the array (both ends included).
+            size_type capacity() const{
+                return capacity_;
+            }
+
+            /// Returns how many elements push_front() can add before the elements are moved.
+            size_type front_capacity() const{
+                return front_;
+            }
+
+            /// Returns how many elements push_back() can add before the elements are moved.
+            size_type back_capacity() const{
+                return capacity_ - front_ - size_;
+            }
+
+            /// Increase the storage capacity to `new_cap` if it is greater than the current capacity(), splitting the spare room.
+            void reserve(size_type new_cap){
+                if(new_cap <= capacity_) return; //do nothing
+                rebuild(new_cap, (new_cap - size_) / 2, size_, 0);
+            }
+
+            /// Requests the removal of unused capacity at both ends.
+            void shrink_to_fit(){
+                if(size_ == capacity_) return;
+                rebuild(size_, 0, size_, 0);
+            }
+
+        //=== Getting an iterator
+            /// Returns an iterator pointing to the first item in the list
+            iterator begin(){
+                return iterator(first());
+            }
+
+            /// Returns an iterator pointing to the end mark in the list
+            iterator end(){
+                return iterator(first()+size_);
+            }
+
+            /// Returns a constant iterator pointing to the first item in the list.
+            const_iterator cbegin() const{
+                return const_iterator(first());
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the list
+            const_iterator cend() const{
+                return const_iterator(first()+size_);
+            }
+
+            /// Returns a constant iterator pointing to the first item in the list.
+            const_iterator begin() const{
+                return const_iterator(first());
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the list.
+            const_iterator end() const{
+                return const_iterator(first()+size_);
+            }
+
+            /// Returns a reverse iterator pointing to the last item in the list.
+            reverse_iterator rbegin(){
+                return reverse_iterator(end());
+            }
+
+            /// Returns a reverse iterator pointing before the first item in the list.
+            reverse_iterator rend(){
+                return reverse_iterator(begin());
+            }
+
+            /// Returns a constant reverse iterator pointing to the last item in the list.
+            const_reverse_iterator rbegin() const{
+                return const_reverse_iterator(end());
+            }
+
+            /// Returns a constant reverse iterator pointing before the first item in the list.
+            const_reverse_iterator rend() const{
+                return const_reverse_iterator(begin());
+            }
+
+            /// Returns a pointer to the underlying array: [data(), data()+size()) are the elements.
+            T* data(){
+                return first();
+            }
+
+            /// Returns a pointer to the underlying array: [data(), data()+size()) are the elements.
+            const T* data() const{
+                return first();
+            }
+
+        //=== List container operations that require iterators
+            /// Adds value into the list before the position given by the iterator pos
+            iterator insert(iterator pos, const T & value){
+                return emplace(pos, value);
+            }
+
+            /// Moves value into the list before the position given by the iterator pos
+            iterator insert(iterator pos, T && value){
+                return emplace(pos, std::move(value));
+            }
+
+            /// Constructs a new element from args, in place, before the position given by the iterator pos
+            /*! Shifts the shorter side of pos, so insertions near either end are cheap. */
+            template <typename... Args>
+            iterator emplace(iterator pos, Args&&... args){
+                size_type idx = pos - begin();
+                T item(std::forward<Args>(args)...); //args may refer to an element that is about to move
+                open_gap(idx, 1);
+                new (first()+idx) T(std::move(item));
+                size_ += 1;
+                return iterator(first()+idx);
+            }
+
+            /// Inserts elements from the range [first; last) before pos
+            template <typename InItr>
+            iterator insert(iterator pos, InItr first_, InItr last_){
+                if(size_type(pos - begin()) > size_) return end();
+                size_type idx = pos - begin();
+                devector items(first_, last_); //the range may live in this devector
+                open_gap(idx, items.size_);
+                relocate(items.first(), items.first()+items.size_, first()+idx);
+                size_ += items.size_;
+                items.size_ = 0;
+                return iterator(first()+idx);
+            }
+
+            /// Inserts elements from the initializer list ilist before pos
+            iterator insert(iterator pos, std::initializer_list<T> ilist){
+                return insert(pos, ilist.begin(), ilist.end());
+            }
+
+            /// Removes the object at position pos
+            iterator erase(iterator pos){
+                return erase(pos, pos+1);
+            }
+
+            /// Removes elements in the range [first; last)
+            iterator erase(iterator first_, iterator last_){
+                size_type idx = first_ - begin();
+                close_gap(idx, last_ - first_);
+                return iterator(first()+idx);
+            }
+
+            /// Exchanges the contents of the list with those of other, without moving any element.
+            void swap(devector& other) noexcept{
+                std::swap(block, other.block);
+                std::swap(front_, other.front_);
+                std::swap(size_, other.size_);
+                std::swap(capacity_, other.capacity_);
+            }
+
+            friend std::ostream& operator<<(std::ostream& os, const devector& v){
+                os << "[ ";
+                for(size_type i = 0; i < v.size_; i++){
+                    os << v[i] << " ";
+                }
+                os << "]";
+                return os;
+            }
+    };
+
+    //=== Operator overloading — non-member functions
+        /// Checks if the contents of lhs and rhs are equal.
+        template <typename T>
+        bool operator==(const sc::devector<T>& lhs, const sc::devector<T>& rhs){
+            if(lhs.size() != rhs.size()) return false;
+            for(size_t i = 0; i < lhs.size(); i++){
+                if(lhs[i] != rhs[i])
+                    return false;
+            }
+            return true;
+        }
+
+        /// Similar to the previous operator, but the opposite result.
+        template <typename T>
+        bool operator!=(const sc::devector<T>& lhs, const sc::devector<T>& rhs){
+            return !(lhs == rhs);
+        }
+
+        /// Exchanges the contents of lhs and rhs.
+        template <typename T>
+        void swap(sc::devector<T>& lhs, sc::devector<T>& rhs) noexcept{
+            lhs.swap(rhs);
+        }
+}
+
+#endif
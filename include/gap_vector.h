@@ -0,0 +1,558 @@
+/*!
+ * \file gap_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef GAP_VECTOR_H
+#define GAP_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// Gap buffer: an array whose spare capacity is a movable gap inside the elements.
+    /*! The elements live in [0, gap_begin_) and [gap_end_, capacity_) of the block. An
+     * insertion or erasure first moves the gap to its position, shifting only the elements
+     * between the old and the new edit point, and then costs O(1): a run of edits clustered
+     * around one cursor (typing, backspacing) costs O(distance moved) instead of O(n) each.
+     * Iterators and operator[] skip the gap, so the elements look contiguous, but they are
+     * not: use data-pointer based algorithms only on sc::vector.
+     */
+    template <typename T>
+    class gap_vector{
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using pointer = value_type*; //!< Pointer to a value stored in the container.
+            using reference = value_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+
+        //=== Iterators
+            /// Random access iterator over the elements that steps over the gap.
+            template <typename U>
+            class basic_iterator{
+                public:
+                    typedef U& reference; //!< Reference to the value type.
+                    typedef U* pointer; //!< Pointer to the value type.
+                    typedef T value_type; //!< Value type the iterator points to.
+                    /// Difference type used to calculated distance between iterators.
+                    typedef std::ptrdiff_t difference_type;
+                    /// Identifies the iterator category to algorithms from STL
+                    typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+                //=== Private data
+                private:
+                    U *block; //!< Storage area of the gap_vector.
+                    size_type gap_begin_; //!< First slot of the gap.
+                    size_type gap_size_; //!< Slots in the gap.
+                    size_type pos_; //!< Logical position (gap excluded).
+
+                    friend class gap_vector;
+                    template <typename> friend class basic_iterator;
+                //=== Public interface
+                public:
+                    /// Constructor
+                    basic_iterator(U *b = nullptr, size_type gap_begin = 0, size_type gap_size = 0, size_type pos = 0)
+                        : block{b}, gap_begin_{gap_begin}, gap_size_{gap_size}, pos_{pos}{
+                        /*empty*/
+                    }
+
+                    /// Converts an iterator into a const_iterator.
+                    template <typename V, typename = std::enable_if_t<std::is_same<const V, U>::value && !std::is_same<V, U>::value>>
+                    basic_iterator(const basic_iterator<V> &other)
+                        : block{other.block}, gap_begin_{other.gap_begin_}, gap_size_{other.gap_size_}, pos_{other.pos_}{
+                        /*empty*/
+                    }
+
+                //=== Iterator operations
+                    /// Return a reference to the object located at the position pointed by the iterator
+                    reference operator*() const{
+                        return block[pos_ < gap_begin_ ? pos_ : pos_ + gap_size_];
+                    }
+
+                    /// Return a pointer to the object located at the position pointed by the iterator
+                    pointer operator->() const{
+                        return &**this;
+                    }
+
+                    /// Return a reference to the object n positions away from the iterator
+                    reference operator[](difference_type n) const{
+                        return *(*this + n);
+                    }
+
+                    basic_iterator& operator++(){ ++pos_; return *this; }
+                    basic_iterator operator++(int){ basic_iterator temp(*this); ++pos_; return temp; }
+                    basic_iterator& operator--(){ --pos_; return *this; }
+                    basic_iterator operator--(int){ basic_iterator temp(*this); --pos_; return temp; }
+                    basic_iterator& operator+=(difference_type n){ pos_ += n; return *this; }
+                    basic_iterator& operator-=(difference_type n){ pos_ -= n; return *this; }
+
+                    friend basic_iterator operator+(basic_iterator it, difference_type n){ return it += n; }
+                    friend basic_iterator operator+(difference_type n, basic_iterator it){ return it += n; }
+                    friend basic_iterator operator-(basic_iterator it, difference_type n){ return it -= n; }
+
+                    /// Return the difference between two iterators.
+                    friend difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return difference_type(lhs.pos_) - difference_type(rhs.pos_);
+                    }
+
+                    friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ == rhs.pos_; }
+                    friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ != rhs.pos_; }
+                    friend bool operator<(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ < rhs.pos_; }
+                    friend bool operator>(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ > rhs.pos_; }
+                    friend bool operator<=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ <= rhs.pos_; }
+                    friend bool operator>=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ >= rhs.pos_; }
+            };
+
+            using iterator = basic_iterator<T>; //!< Iterator over the elements, gap skipped.
+            using const_iterator = basic_iterator<const T>; //!< Constant iterator over the elements, gap skipped.
+
+        //=== Private data
+        private:
+            T *block; //!< Storage area. Only [0, gap_begin_) and [gap_end_, capacity_) hold live objects.
+            size_type gap_begin_; //!< First slot of the gap; also the number of elements before it.
+            size_type gap_end_; //!< One past the last slot of the gap.
+            size_type capacity_; //!< Total slots in the block.
+
+        //=== Raw storage helpers
+        private:
+            /// Returns uninitialized storage for `n` objects of T.
+            static T* allocate(size_type n){
+                if(n == 0) return nullptr;
+                return std::allocator<T>().allocate(n);
+            }
+
+            /// Releases the block. The objects in it must be already destroyed.
+            void release(){
+                if(block != nullptr) std::allocator<T>().deallocate(block, capacity_);
+            }
+
+            /// Destroys the objects in [first, last) without releasing their storage.
+            static void destroy(T *first, T *last){
+                if constexpr(!std::is_trivially_destructible<T>::value){
+                    for(; first != last; first++){
+                        first->~T();
+                    }
+                }
+            }
+
+            /// Moves the objects in [first, last) into the uninitialized storage at dest and destroys the originals.
+            /*! The ranges may overlap. Trivially relocatable types are moved with a single memmove. */
+            static void relocate(T *first, T *last, T *dest){
+                if constexpr(is_trivially_relocatable<T>::value){
+                    if(first != last) std::memmove(static_cast<void*>(dest), first, (last-first) * sizeof(T));
+                }
+                else if(dest <= first){
+                    for(; first != last; first++, dest++){
+                        new (dest) T(std::move_if_noexcept(*first));
+                        first->~T();
+                    }
+                }
+                else{ //overlapping shift to the right: walk backwards
+                    for(dest += last-first; last != first; ){
+                        last--; dest--;
+                        new (dest) T(std::move_if_noexcept(*last));
+                        last->~T();
+                    }
+                }
+            }
+
+            /// Returns the slot of the element at logical position pos.
+            size_type slot(size_type pos) const{
+                return pos < gap_begin_ ? pos : pos + (gap_end_ - gap_begin_);
+            }
+
+        //=== Gap engine
+            /// Moves the gap so that it starts at logical position pos, shifting only the elements in between.
+            void move_gap(size_type pos){
+                if(pos < gap_begin_){ //elements [pos, gap_begin_) go after the gap
+                    size_type n = gap_begin_ - pos;
+                    relocate(block+pos, block+gap_begin_, block+gap_end_-n);
+                    gap_begin_ -= n;
+                    gap_end_ -= n;
+                }
+                else if(pos > gap_begin_){ //elements after the gap come before it
+                    size_type n = pos - gap_begin_;
+                    relocate(block+gap_end_, block+gap_end_+n, block+gap_begin_);
+                    gap_begin_ += n;
+                    gap_end_ += n;
+                }
+            }
+
+            /// Moves the gap to position pos and makes it at least n slots wide.
+            /*! When the block is full the elements go to a block twice as large, with the gap already at pos. */
+            void open_gap(size_type pos, size_type n){
+                if(gap_end_ - gap_begin_ >= n){
+                    move_gap(pos);
+                    return;
+                }
+                size_type count = size();
+                size_type new_cap = capacity_*2 < count+n ? count+n : capacity_*2;
+                T *new_block = allocate(new_cap);
+                size_type tail = count - pos; //elements that go after the gap
+                if(pos <= gap_begin_){
+                    relocate(block, block+pos, new_block);
+                    relocate(block+pos, block+gap_begin_, new_block+new_cap-tail);
+                    relocate(block+gap_end_, block+capacity_, new_block+new_cap-(capacity_-gap_end_));
+                }
+                else{
+                    relocate(block, block+gap_begin_, new_block);
+                    relocate(block+gap_end_, block+gap_end_+(pos-gap_begin_), new_block+gap_begin_);
+                    relocate(block+gap_end_+(pos-gap_begin_), block+capacity_, new_block+new_cap-tail);
+                }
+                release();
+                block = new_block;
+                gap_begin_ = pos;
+                gap_end_ = new_cap - tail;
+                capacity_ = new_cap;
+            }
+
+        //=== Public interface
+        public:
+        //=== Constructors, Destructors, and Assignment.
+            /// Default constructor that creates an empty list. Never allocates.
+            gap_vector() : block{nullptr}, gap_begin_{0}, gap_end_{0}, capacity_{0}{
+                /*empty*/
+            }
+
+            /// Constructs an empty list whose gap holds count elements.
+            explicit gap_vector(size_type count) : gap_vector(){
+                reserve(count);
+            }
+
+            /// Constructs the list with the contents of the range [first, last).
+            template <typename InputIt>
+            gap_vector(InputIt first, InputIt last) : gap_vector(){
+                for(; first != last; first++){
+                    emplace_back(*first);
+                }
+            }
+
+            /// Copy constructor. The copy has its gap at the end.
+            gap_vector(const gap_vector& other) : gap_vector(){
+                reserve(other.size());
+                for(size_type i = 0; i < other.size(); i++){
+                    new (&block[gap_begin_]) T(other[i]);
+                    gap_begin_ += 1;
+                }
+            }
+
+            /// Move constructor. Takes over the storage of other, which is left empty.
+            gap_vector(gap_vector&& other) noexcept : gap_vector(){
+                swap(other);
+            }
+
+            /// Constructs the list with the contents of the initializer list init.
+            gap_vector(std::initializer_list<T> ilist) : gap_vector(ilist.begin(), ilist.end()){
+                /*empty*/
+            }
+
+            /// Destructs the list.
+            ~gap_vector(){
+                clear();
+                release();
+            }
+
+            /// Copy assignment operator.
+            gap_vector& operator=(const gap_vector& other){
+                if(this != &other){
+                    gap_vector copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            /// Move assignment operator.
+            gap_vector& operator=(gap_vector&& other) noexcept{
+                if(this != &other){
+                    gap_vector moved(std::move(other));
+                    swap(moved);
+                }
+                return *this;
+            }
+
+            /// Replaces the contents with those identified by initializer list ilist
+            gap_vector& operator=(std::initializer_list<T> ilist){
+                gap_vector filled(ilist);
+                swap(filled);
+                return *this;
+            }
+
+        //=== Common operations to all list implementations
+            /// Return the number of elements in the container.
+            size_type size() const{
+                return capacity_ - (gap_end_ - gap_begin_);
+            }
+
+            /// Return the internal storage capacity (elements plus gap).
+            size_type capacity() const{
+                return capacity_;
+            }
+
+            /// Returns true if the container contains no elements, and false otherwise.
+            bool empty() const{
+                return size() == 0;
+            }
+
+            /// Returns the logical position where the gap currently is: edits there cost O(1).
+            size_type gap_position() const{
+                return gap_begin_;
+            }
+
+            /// Remove all elements from the container. The whole block becomes the gap.
+            void clear(){
+                destroy(block, block+gap_begin_);
+                destroy(block+gap_end_, block+capacity_);
+                gap_begin_ = 0;
+                gap_end_ = capacity_;
+            }
+
+            /// Adds value to the end of the list.
+            void push_back(const T &value){
+                emplace(end(), value);
+            }
+
+            /// Moves value to the end of the list.
+            void push_back(T &&value){
+                emplace(end(), std::move(value));
+            }
+
+            /// Constructs a new element at the end of the list from args.
+            template <typename... Args>
+            T& emplace_back(Args&&... args){
+                return *emplace(end(), std::forward<Args>(args)...);
+            }
+
+            /// Adds value to the front of the list.
+            void push_front(const T &value){
+                emplace(begin(), value);
+            }
+
+            /// Moves value to the front of the list.
+            void push_front(T &&value){
+                emplace(begin(), std::move(value));
+            }
+
+            /// Removes the object at the end of the list.
+            void pop_back(){
+                if(!empty()) erase(end()-1);
+            }
+
+            /// Removes the object at the front of the list.
+            void pop_front(){
+                if(!empty()) erase(begin());
+            }
+
+            /// Returns the object at the end of the list.
+            T& back(){
+                return (*this)[size()-1];
+            }
+
+            /// Returns the object at the end of the list.
+            const T& back() const{
+                return (*this)[size()-1];
+            }
+
+            /// Returns the object at the beginning of the list.
+            T& front(){
+                return (*this)[0];
+            }
+
+            /// Returns the object at the beginning of the list.
+            const T& front() const{
+                return (*this)[0];
+            }
+
+        //=== Element access
+            /// Returns the object at the index pos, with no bounds-checking.
+            T & operator[](size_type pos){
+                return block[slot(pos)];
+            }
+
+            /// Returns the object at the index pos, with no bounds-checking.
+            const T & operator[](size_type pos) const{
+                return block[slot(pos)];
+            }
+
+            /// Returns the object at the index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            T & at(size_type pos){
+                if(pos >= size()){
+                    throw std::out_of_range("[gap_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return block[slot(pos)];
+            }
+
+            /// Returns the object at the index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            const T & at(size_type pos) const{
+                if(pos >= size()){
+                    throw std::out_of_range("[gap_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return block[slot(pos)];
+            }
+
+            /// Increase the storage capacity to `new_cap` if it is greater than the current capacity(); the gap keeps its position.
+            void reserve(size_type new_cap){
+                if(new_cap <= capacity_) return; //do nothing
+                T *new_block = allocate(new_cap);
+                size_type tail = capacity_ - gap_end_;
+                relocate(block, block+gap_begin_, new_block);
+                relocate(block+gap_end_, block+capacity_, new_block+new_cap-tail);
+                release();
+                block = new_block;
+                gap_end_ = new_cap - tail;
+                capacity_ = new_cap;
+            }
+
+        //=== Getting an iterator
+            /// Returns an iterator pointing to the first item in the list
+            iterator begin(){
+                return iterator(block, gap_begin_, gap_end_ - gap_begin_, 0);
+            }
+
+            /// Returns an iterator pointing to the end mark in the list
+            iterator end(){
+                return iterator(block, gap_begin_, gap_end_ - gap_begin_, size());
+            }
+
+            /// Returns a constant iterator pointing to the first item in the list.
+            const_iterator begin() const{
+                return cbegin();
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the list.
+            const_iterator end() const{
+                return cend();
+            }
+
+            /// Returns a constant iterator pointing to the first item in the list.
+            const_iterator cbegin() const{
+                return const_iterator(block, gap_begin_, gap_end_ - gap_begin_, 0);
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the list
+            const_iterator cend() const{
+                return const_iterator(block, gap_begin_, gap_end_ - gap_begin_, size());
+            }
+
+        //=== List container operations that require iterators
+        //  Edits invalidate every iterator: the gap moves under them.
+            /// Adds value into the list before the position given by the iterator pos
+            iterator insert(const_iterator pos, const T & value){
+                return emplace(pos, value);
+            }
+
+            /// Moves value into the list before the position given by the iterator pos
+            iterator insert(const_iterator pos, T && value){
+                return emplace(pos, std::move(value));
+            }
+
+            /// Constructs a new element from args, in place, before the position given by the iterator pos
+            /*! Moves the gap to pos first: O(distance from the previous edit), then O(1). */
+            template <typename... Args>
+            iterator emplace(const_iterator pos, Args&&... args){
+                size_type idx = pos.pos_;
+                if(gap_begin_ == gap_end_ || idx != gap_begin_){
+                    T item(std::forward<Args>(args)...); //args may refer to an element that is about to move
+                    open_gap(idx, 1);
+                    new (&block[gap_begin_]) T(std::move(item));
+                }
+                else{
+                    new (&block[gap_begin_]) T(std::forward<Args>(args)...);
+                }
+                gap_begin_ += 1;
+                return begin() + idx;
+            }
+
+            /// Inserts elements from the range [first; last) before pos
+            template <typename InItr>
+            iterator insert(const_iterator pos, InItr first, InItr last){
+                size_type idx = pos.pos_;
+                gap_vector items(first, last); //the range may live in this gap_vector
+                open_gap(idx, items.size());
+                relocate(items.block, items.block+items.gap_begin_, block+gap_begin_);
+                gap_begin_ += items.gap_begin_;
+                items.gap_begin_ = 0; //already moved out
+                return begin() + idx;
+            }
+
+            /// Inserts elements from the initializer list ilist before pos
+            iterator insert(const_iterator pos, std::initializer_list<T> ilist){
+                return insert(pos, ilist.begin(), ilist.end());
+            }
+
+            /// Removes the object at position pos
+            iterator erase(const_iterator pos){
+                return erase(pos, pos+1);
+            }
+
+            /// Removes elements in the range [first; last). The erased slots join the gap.
+            iterator erase(const_iterator first, const_iterator last){
+                size_type idx = first.pos_;
+                size_type n = last.pos_ - first.pos_;
+                move_gap(idx);
+                destroy(block+gap_end_, block+gap_end_+n);
+                gap_end_ += n;
+                return begin() + idx;
+            }
+
+            /// Exchanges the contents of the list with those of other, without moving any element.
+            void swap(gap_vector& other) noexcept{
+                std::swap(block, other.block);
+                std::swap(gap_begin_, other.gap_begin_);
+                std::swap(gap_end_, other.gap_end_);
+                std::swap(capacity_, other.capacity_);
+            }
+
+            friend std::ostream& operator<<(std::ostream& os, const gap_vector& v){
+                os << "[ ";
+                for(size_type i = 0; i < v.size(); i++){
+                    os << v[i] << " ";
+                }
+                os << "]";
+                return os;
+            }
+    };
+
+    //=== Operator overloading — non-member functions
+        /// Checks if the contents of lhs and rhs are equal.
+        template <typename T>
+        bool operator==(const sc::gap_vector<T>& lhs, const sc::gap_vector<T>& rhs){
+            if(lhs.size() != rhs.size()) return false;
+            for(size_t i = 0; i < lhs.size(); i++){
+                if(lhs[i] != rhs[i])
+                    return false;
+            }
+            return true;
+        }
+
+        /// Similar to the previous operator, but the opposite result.
+        template <typename T>
+        bool operator!=(const sc::gap_vector<T>& lhs, const sc::gap_vector<T>& rhs){
+            return !(lhs == rhs);
+        }
+
+        /// Exchanges the contents of lhs and rhs.
+        template <typename T>
+        void swap(sc::gap_vector<T>& lhs, sc::gap_vector<T>& rhs) noexcept{
+            lhs.swap(rhs);
+        }
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*!
+ * \file growth_policy.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+
+/*! Growth policies for sc::vector.
+ *
+ * A policy is a type with a static member
+ *
+ *     size_type next(size_type capacity, size_type min_cap, size_type elem_size)
+ *
+ * that returns the capacity (in elements) a full vector grows to. The result must be
+ * at least `min_cap`, and it should grow geometrically to keep push_back() amortized O(1).
+ */
+namespace sc{ // sc: Sequence container
+    namespace growth{
+        using size_type = unsigned long; //!< The size type.
+
+        /// Doubles the capacity (the default).
+        struct doubling{
+            static constexpr size_type next(size_type capacity, size_type min_cap, size_type){
+                return capacity*2 < min_cap ? min_cap : capacity*2;
+            }
+        };
+
+        /// Grows the capacity by 1.5x.
+        /*! The sum of the previous blocks eventually exceeds the next request, so an
+         * allocator can reuse the freed blocks for it, which 2x growth never allows.
+         */
+        struct one_and_half{
+            static constexpr size_type next(size_type capacity, size_type min_cap, size_type){
+                size_type new_cap = capacity + capacity/2;
+                return new_cap < min_cap ? min_cap : new_cap;
+            }
+        };
+
+        /// Rounds the growth of Base up to the size classes of jemalloc-like allocators.
+        /*! Between 2^k and 2^(k+1) bytes there are four classes, so blocks are requested with
+         * the size the allocator would round them to anyway, and the slack becomes capacity.
+         */
+        template <typename Base = doubling>
+        struct size_class{
+            /// Rounds bytes up to the next size class.
+            static constexpr size_type round(size_type bytes){
+                if(bytes <= 16) return 16;
+                size_type power = 16;
+                while(power*2 < bytes) power *= 2; //power < bytes <= 2*power
+                size_type step = power/4;
+                return (bytes + step-1) / step * step;
+            }
+
+            static constexpr size_type next(size_type capacity, size_type min_cap, size_type elem_size){
+                return round(Base::next(capacity, min_cap, elem_size) * elem_size) / elem_size;
+            }
+        };
+
+        /// Rounds the growth of Base up to whole pages once blocks reach one page.
+        /*! Large blocks come straight from mmap, so the tail of the last page is capacity for free. */
+        template <typename Base = doubling, size_type PageSize = 4096>
+        struct page_aligned{
+            static constexpr size_type next(size_type capacity, size_type min_cap, size_type elem_size){
+                size_type bytes = Base::next(capacity, min_cap, elem_size) * elem_size;
+                if(bytes < PageSize) return bytes / elem_size;
+                return (bytes + PageSize-1) / PageSize * PageSize / elem_size;
+            }
+        };
+
+        /// Grows like Base until a step would exceed MaxStep bytes, then by MaxStep bytes at a time.
+        /*! Bounds the memory a huge vector wastes in spare capacity, at the price of
+         * reallocating every MaxStep bytes instead of amortized O(1) growth.
+         */
+        template <size_type MaxStep = 64ul*1024*1024, typename Base = doubling>
+        struct capped_linear{
+            static constexpr size_type next(size_type capacity, size_type min_cap, size_type elem_size){
+                size_type new_cap = Base::next(capacity, min_cap, elem_size);
+                size_type max_step = MaxStep / elem_size > 0 ? MaxStep / elem_size : 1;
+                if(new_cap - capacity > max_step) new_cap = capacity + max_step;
+                return new_cap < min_cap ? min_cap : new_cap;
+            }
+        };
+    }
+}
+
+#endif
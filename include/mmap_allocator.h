@@ -0,0 +1,132 @@
+/*!
+ * \file mmap_allocator.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef MMAP_ALLOCATOR_H
+#define MMAP_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// Allocator for very large vectors of trivially copyable elements (Linux only).
+    /*! Blocks of at least Threshold bytes are mapped with mmap; smaller ones come from malloc.
+     * sc::vector grows and shrinks through reallocate(), which uses mremap for mapped blocks:
+     * the kernel moves page table entries instead of bytes, so reallocation costs O(pages),
+     * copies no data and never needs the old and the new block at the same time.
+     * With HugePages, mapped blocks are advised MADV_HUGEPAGE to cut TLB misses.
+     */
+    template <typename T, std::size_t Threshold = 1024*1024, bool HugePages = false>
+    class mmap_allocator{
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "mmap_allocator moves blocks bitwise, so it only holds trivially copyable types");
+        public:
+            using value_type = T; //!< The value type.
+            using is_always_equal = std::true_type; //!< Any instance can release any block.
+
+            /// Rebinds the allocator to another value type.
+            template <typename U>
+            struct rebind{
+                using other = mmap_allocator<U, Threshold, HugePages>;
+            };
+
+        //=== Private helpers
+        private:
+            /// Returns true if a block of n objects is (or would be) mapped with mmap.
+            static bool is_mapped(std::size_t n){
+                return n * sizeof(T) >= Threshold;
+            }
+
+            /// Returns the bytes actually mapped for n objects: whole pages.
+            static std::size_t mapped_bytes(std::size_t n){
+                static const std::size_t page = sysconf(_SC_PAGESIZE);
+                return (n * sizeof(T) + page-1) / page * page;
+            }
+
+            /// Maps a fresh block for n objects.
+            static T* map(std::size_t n){
+                void *ptr = mmap(nullptr, mapped_bytes(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if(ptr == MAP_FAILED) throw std::bad_alloc();
+                advise(ptr, mapped_bytes(n));
+                return static_cast<T*>(ptr);
+            }
+
+            /// Asks for transparent huge pages on a mapped range, if enabled.
+            static void advise(void *ptr, std::size_t bytes){
+                if constexpr(HugePages){
+                    madvise(ptr, bytes, MADV_HUGEPAGE); //only a hint: failure is harmless
+                }
+            }
+
+        //=== Public interface
+        public:
+            /// Constructor
+            mmap_allocator() noexcept = default;
+
+            /// Rebinding constructor.
+            template <typename U>
+            mmap_allocator(const mmap_allocator<U, Threshold, HugePages>&) noexcept{
+                /*empty*/
+            }
+
+            /// Returns storage for n objects of T.
+            T* allocate(std::size_t n){
+                if(is_mapped(n)) return map(n);
+                void *ptr = std::malloc(n * sizeof(T));
+                if(ptr == nullptr) throw std::bad_alloc();
+                return static_cast<T*>(ptr);
+            }
+
+            /// Releases the storage of n objects at ptr.
+            void deallocate(T *ptr, std::size_t n) noexcept{
+                if(is_mapped(n)) munmap(ptr, mapped_bytes(n));
+                else std::free(ptr);
+            }
+
+            /// Resizes the block at ptr from old_n to new_n objects, keeping the first min(old_n, new_n) bitwise.
+            /*! Returns the (possibly moved) block. Mapped blocks are resized with mremap. */
+            T* reallocate(T *ptr, std::size_t old_n, std::size_t new_n){
+                if(is_mapped(old_n) && is_mapped(new_n)){
+                    void *moved = mremap(ptr, mapped_bytes(old_n), mapped_bytes(new_n), MREMAP_MAYMOVE);
+                    if(moved == MAP_FAILED) throw std::bad_alloc();
+                    advise(moved, mapped_bytes(new_n));
+                    return static_cast<T*>(moved);
+                }
+                if(!is_mapped(old_n) && !is_mapped(new_n)){
+                    void *moved = std::realloc(ptr, new_n * sizeof(T));
+                    if(moved == nullptr) throw std::bad_alloc();
+                    return static_cast<T*>(moved);
+                }
+                //crossing the threshold: one copy of the smaller block, the one that lives in malloc
+                T *fresh = allocate(new_n);
+                if(is_mapped(new_n)) std::memcpy(fresh, ptr, old_n * sizeof(T));
+                else std::memcpy(fresh, ptr, new_n * sizeof(T));
+                deallocate(ptr, old_n);
+                return fresh;
+            }
+
+            /// All instances are interchangeable.
+            friend bool operator==(const mmap_allocator&, const mmap_allocator&){
+                return true;
+            }
+
+            /// All instances are interchangeable.
+            friend bool operator!=(const mmap_allocator&, const mmap_allocator&){
+                return false;
+            }
+    };
+
+    /// sc::vector of trivially copyable elements whose large blocks are mapped and grown with mremap.
+    template <typename T, typename Growth = growth::doubling>
+    using large_vector = vector<T, mmap_allocator<T>, Growth>;
+}
+
+#endif
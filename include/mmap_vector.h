@@ -0,0 +1,342 @@
+/*!
+ * \file mmap_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// How an mmap_vector opens its file.
+    enum class map_mode{
+        read_only, //!< The file must exist; the elements cannot be changed.
+        read_write //!< The file is created if missing; changes are written back to it.
+    };
+
+    /// Vector of trivially copyable records stored in a file, through a shared memory mapping (POSIX only).
+    /*! The file is the array: its length is size() * sizeof(T) and element i lives at byte
+     * offset i * sizeof(T). Opening maps the file without reading it, so it costs O(1)
+     * whatever the size, and the kernel loads the pages the program touches on demand.
+     *
+     * In read_write mode the vector grows like sc::vector with growth::doubling: push_back()
+     * extends the file with ftruncate() and the mapping with mremap(), so spare capacity
+     * lives at the end of the file, and the destructor truncates the file back to size().
+     * Writes reach the page cache at once and the disk when the kernel decides, or when
+     * flush() (msync) is called.
+     *
+     * The mode is part of the type. mmap_view<T> (mmap_vector<T, map_mode::read_only>) maps
+     * the file without write permission: every accessor, const or not, returns const
+     * references, pointers and iterators, so writing through one does not compile, and the
+     * members that change the size throw std::logic_error. Failed system calls throw
+     * std::system_error.
+     */
+    template <typename T, map_mode Mode = map_mode::read_write>
+    class mmap_vector{
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "mmap_vector stores the bytes of its elements in a file, so it only holds trivially copyable types");
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            static constexpr bool read_only = Mode == map_mode::read_only; //!< True for mmap_view.
+            using element_type = std::conditional_t<read_only, const T, T>; //!< What the accessors expose: const T when read-only.
+            using pointer = element_type*; //!< Pointer to a value stored in the container.
+            using reference = element_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+            using const_iterator = typename vector<T>::const_iterator; //!< Same iterators as sc::vector.
+            using iterator = std::conditional_t<read_only, const_iterator, typename vector<T>::iterator>; //!< Same iterators as sc::vector.
+            using const_reverse_iterator = typename vector<T>::const_reverse_iterator; //!< Same iterators as sc::vector.
+            using reverse_iterator = std::conditional_t<read_only, const_reverse_iterator, typename vector<T>::reverse_iterator>; //!< Same iterators as sc::vector.
+
+        //=== Private data
+        private:
+            T *data_; //!< The mapping: capacity_ elements, the first size_ of them in use.
+            size_type size_; //!< Number of elements currently in the vector.
+            size_type capacity_; //!< Elements the file (and the mapping) currently holds.
+            int fd_; //!< The open file, or -1.
+
+        //=== Private helpers
+        private:
+            /// Throws std::system_error with the current errno.
+            [[noreturn]] static void fail(const char *what){
+                throw std::system_error(errno, std::generic_category(), what);
+            }
+
+            /// Throws std::logic_error if the vector is read-only (a constant, so it costs nothing in read_write mode).
+            void require_writable() const{
+                if(read_only) throw std::logic_error("mmap_vector is read-only.");
+            }
+
+            /// Resizes the file and the mapping to exactly new_cap elements.
+            void remap(size_type new_cap){
+                if(new_cap == capacity_) return;
+                if(ftruncate(fd_, off_t(new_cap * sizeof(T))) != 0) fail("ftruncate");
+                if(new_cap == 0){
+                    munmap(data_, capacity_ * sizeof(T));
+                    data_ = nullptr;
+                }
+                else if(data_ == nullptr){
+                    void *ptr = mmap(nullptr, new_cap * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+                    if(ptr == MAP_FAILED) fail("mmap");
+                    data_ = static_cast<T*>(ptr);
+                }
+                else{
+                    void *ptr = mremap(data_, capacity_ * sizeof(T), new_cap * sizeof(T), MREMAP_MAYMOVE);
+                    if(ptr == MAP_FAILED) fail("mremap");
+                    data_ = static_cast<T*>(ptr);
+                }
+                capacity_ = new_cap;
+            }
+
+            /// Grows, as growth::doubling decides, so that at least `min_cap` elements fit.
+            void grow_for(size_type min_cap){
+                if(min_cap <= capacity_) return;
+                remap(growth::doubling::next(capacity_, min_cap, sizeof(T)));
+            }
+
+            /// Unmaps, trims the spare capacity off the file and closes it.
+            void close() noexcept{
+                if(data_ != nullptr) munmap(data_, capacity_ * sizeof(T));
+                if(fd_ >= 0){
+                    if(!read_only && size_ != capacity_){
+                        if(ftruncate(fd_, off_t(size_ * sizeof(T))) != 0){ /*nothing to do in a destructor*/ }
+                    }
+                    ::close(fd_);
+                }
+                data_ = nullptr;
+                size_ = capacity_ = 0;
+                fd_ = -1;
+            }
+
+        //=== Public interface
+        public:
+            /// Constructor: an empty vector with no file.
+            mmap_vector() : data_{nullptr}, size_{0}, capacity_{0}, fd_{-1}{ }
+
+            /// Opens (or, in read_write mode, creates) the file at path and maps it.
+            /*! Throws std::system_error if the file cannot be opened or mapped, and std::runtime_error
+             * if its length is not a multiple of sizeof(T).
+             */
+            explicit mmap_vector(const std::string &path) : mmap_vector(){
+                fd_ = read_only ? ::open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                                : ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+                if(fd_ < 0) fail(path.c_str());
+                struct stat st;
+                if(fstat(fd_, &st) != 0){
+                    int error = errno;
+                    close();
+                    errno = error;
+                    fail("fstat");
+                }
+                size_type bytes = size_type(st.st_size);
+                if(bytes % sizeof(T) != 0){
+                    close();
+                    throw std::runtime_error(path + ": length is not a multiple of the element size.");
+                }
+                size_ = capacity_ = bytes / sizeof(T);
+                if(bytes > 0){
+                    int prot = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+                    void *ptr = mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+                    if(ptr == MAP_FAILED){
+                        int error = errno;
+                        close();
+                        errno = error;
+                        fail("mmap");
+                    }
+                    data_ = static_cast<T*>(ptr);
+                }
+            }
+
+            mmap_vector(const mmap_vector&) = delete;
+            mmap_vector& operator=(const mmap_vector&) = delete;
+
+            /// Move constructor. Leaves other with no file.
+            mmap_vector(mmap_vector&& other) noexcept : mmap_vector(){
+                swap(other);
+            }
+
+            /// Move assignment. Closes the current file first.
+            mmap_vector& operator=(mmap_vector&& other) noexcept{
+                mmap_vector moved(std::move(other));
+                swap(moved);
+                return *this;
+            }
+
+            /// Destructor: unmaps the file and truncates it to size() elements.
+            ~mmap_vector(){
+                close();
+            }
+
+            /// Returns the number of elements.
+            size_type size() const{
+                return size_;
+            }
+
+            /// Returns the number of elements the file currently has room for.
+            size_type capacity() const{
+                return capacity_;
+            }
+
+            /// Returns true if there are no elements.
+            bool empty() const{
+                return size_ == 0;
+            }
+
+            /// Returns how the file was opened.
+            static constexpr map_mode mode(){
+                return Mode;
+            }
+
+            /// Writes the changed pages back to the file. With async, schedules the writes and returns at once.
+            void flush(bool async = false){
+                if(data_ == nullptr || read_only) return;
+                if(msync(data_, capacity_ * sizeof(T), async ? MS_ASYNC : MS_SYNC) != 0) fail("msync");
+            }
+
+            /// Makes room in the file for exactly new_cap elements, if there is not enough already.
+            void reserve(size_type new_cap){
+                require_writable();
+                if(new_cap <= capacity_) return;
+                remap(new_cap);
+            }
+
+            /// Shrinks the file to size() elements.
+            void shrink_to_fit(){
+                require_writable();
+                remap(size_);
+            }
+
+            /// Removes every element. The file keeps its length until the vector is closed.
+            void clear(){
+                require_writable();
+                size_ = 0;
+            }
+
+            /// Resizes to count elements. New elements are zero bytes.
+            void resize(size_type count){
+                require_writable();
+                grow_for(count);
+                if(count > size_) std::memset(static_cast<void*>(data_ + size_), 0, (count - size_) * sizeof(T));
+                size_ = count;
+            }
+
+            /// Adds value at the end, growing the file if it is full.
+            void push_back(const T& value){
+                require_writable();
+                if(size_ == capacity_){
+                    T item(value); //value may live in the mapping that is about to move
+                    grow_for(size_+1);
+                    data_[size_++] = item;
+                    return;
+                }
+                data_[size_++] = value;
+            }
+
+            /// Adds the n elements at [first, first+n) at the end, growing the file at most once.
+            void append(const T *first, size_type n){
+                require_writable();
+                if(size_ + n > capacity_){
+                    if(first >= data_ && first < data_ + capacity_){ //a range of this vector: copy it before remapping
+                        vector<T> items(first, first + n);
+                        grow_for(size_ + n);
+                        std::memcpy(static_cast<void*>(data_ + size_), items.data(), n * sizeof(T));
+                        size_ += n;
+                        return;
+                    }
+                    grow_for(size_ + n);
+                }
+                if(n > 0) std::memmove(static_cast<void*>(data_ + size_), first, n * sizeof(T));
+                size_ += n;
+            }
+
+            /// Removes the last element.
+            void pop_back(){
+                require_writable();
+                size_--;
+            }
+
+            /// Returns a reference to the element at pos.
+            reference operator[](size_type pos){
+                return data_[pos];
+            }
+
+            /// Returns a const reference to the element at pos.
+            const_reference operator[](size_type pos) const{
+                return data_[pos];
+            }
+
+            /// Returns a reference to the element at pos. Throws std::out_of_range if pos >= size().
+            reference at(size_type pos){
+                if(pos >= size_) throw std::out_of_range("Index out of range.");
+                return data_[pos];
+            }
+
+            /// Returns a const reference to the element at pos. Throws std::out_of_range if pos >= size().
+            const_reference at(size_type pos) const{
+                if(pos >= size_) throw std::out_of_range("Index out of range.");
+                return data_[pos];
+            }
+
+            reference front(){ return data_[0]; }
+            const_reference front() const{ return data_[0]; }
+            reference back(){ return data_[size_-1]; }
+            const_reference back() const{ return data_[size_-1]; }
+
+            /// Returns a pointer to the mapping: [data(), data()+size()) are the elements.
+            pointer data(){
+                return data_;
+            }
+
+            /// Returns a pointer to the mapping: [data(), data()+size()) are the elements.
+            const T* data() const{
+                return data_;
+            }
+
+            /// Exchanges the files of the two vectors.
+            void swap(mmap_vector& other) noexcept{
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                std::swap(capacity_, other.capacity_);
+                std::swap(fd_, other.fd_);
+            }
+
+        //=== Getting an iterator
+            iterator begin(){ return iterator(data_); }
+            iterator end(){ return iterator(data_ + size_); }
+            const_iterator begin() const{ return const_iterator(data_); }
+            const_iterator end() const{ return const_iterator(data_ + size_); }
+            const_iterator cbegin() const{ return begin(); }
+            const_iterator cend() const{ return end(); }
+            reverse_iterator rbegin(){ return reverse_iterator(end()); }
+            reverse_iterator rend(){ return reverse_iterator(begin()); }
+            const_reverse_iterator rbegin() const{ return const_reverse_iterator(end()); }
+            const_reverse_iterator rend() const{ return const_reverse_iterator(begin()); }
+    };
+
+    /// Read-only mmap_vector: the file is mapped without write permission and only const access compiles.
+    template <typename T>
+    using mmap_view = mmap_vector<T, map_mode::read_only>;
+
+    /// Exchanges the files of lhs and rhs.
+    template <typename T, map_mode Mode>
+    void swap(mmap_vector<T, Mode> &lhs, mmap_vector<T, Mode> &rhs) noexcept{
+        lhs.swap(rhs);
+    }
+}
+
+#endif
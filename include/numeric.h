@@ -0,0 +1,626 @@
+/*!
+ * \file numeric.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef NUMERIC_H
+#define NUMERIC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "simd.h"
+
+/*! Reductions and scans over arithmetic arrays: sum, min, max, minmax, argmin,
+ * argmax, dot, inclusive_scan and count_if.
+ *
+ * Every function takes either a pointer range (a subrange of a vector is
+ * `v.data()+i, v.data()+j`) or a contiguous container with data() and size()
+ * (sc::vector, sc::small_vector, sc::devector).
+ *
+ * For float, double and 32/64-bit integers the work is done by SIMD kernels written
+ * with GCC/Clang vector extensions: the same kernel is compiled for 32-byte vectors
+ * inside an AVX2 target function and for 16-byte (SSE2) vectors in a default one,
+ * and the AVX2 version is picked at runtime when the CPU supports it. Other compilers
+ * and element types use plain scalar loops.
+ *
+ * Integer sums and dot products are accumulated in 64 bits. Floating point sums are
+ * accumulated in several lanes, so they may differ from a sequential loop by rounding.
+ * min, max, minmax, argmin and argmax skip NaNs, as std::fmin and std::fmax do, in the
+ * kernels and the scalar loops alike: the result is NaN only if every element is.
+ */
+namespace sc{ // sc: Sequence container
+    namespace numeric{
+        /// Type of the sums and dot products of T: 64-bit integers for integral types, T otherwise.
+        template <typename T>
+        using sum_type = std::conditional_t<std::is_integral<T>::value,
+                                            std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>,
+                                            T>;
+
+        /// count_if() predicate: x < value.
+        template <typename T>
+        struct less_than{
+            T value;
+            bool operator()(const T &x) const{ return x < value; }
+        };
+
+        /// count_if() predicate: x > value.
+        template <typename T>
+        struct greater_than{
+            T value;
+            bool operator()(const T &x) const{ return x > value; }
+        };
+
+        /// count_if() predicate: x == value.
+        template <typename T>
+        struct equal_to{
+            T value;
+            bool operator()(const T &x) const{ return x == value; }
+        };
+
+        namespace detail{
+            /// Returns the first element of [first, last) that is not NaN, or first if they all are.
+            /*! min and max start from it: `x < r` is false for a NaN x, so once r is a number
+             * the NaNs are skipped at no cost, in a scalar loop and in every SIMD lane.
+             */
+            template <typename T>
+            const T* first_number(const T *first, const T *last){
+                for(const T *p = first; p != last; p++){
+                    if(*p == *p) return p;
+                }
+                return first;
+            }
+
+#if defined(__GNUC__) && defined(SC_SIMD_X86)
+#define SC_NUMERIC_KERNELS 1
+#define SC_ALWAYS_INLINE inline __attribute__((always_inline))
+            /// True for the element types with SIMD kernels.
+            template <typename T>
+            struct vectorizable : std::integral_constant<bool,
+                std::is_same<T, float>::value || std::is_same<T, double>::value
+                || std::is_same<T, std::int32_t>::value || std::is_same<T, std::uint32_t>::value
+                || std::is_same<T, std::int64_t>::value || std::is_same<T, std::uint64_t>::value>{ };
+
+            /// SIMD vector of W bytes of T.
+            template <typename T, std::size_t W>
+            struct simd_vec{
+                typedef T type __attribute__((vector_size(W)));
+                /// Same vector, aligned as T and allowed to alias it: how arrays of T are read and written.
+                typedef T unaligned __attribute__((vector_size(W), aligned(alignof(T)), may_alias));
+            };
+
+            /// Views the W bytes at p as a vector. Helpers pass vectors by reference:
+            /// by value they would have a different ABI in the AVX2 and the default targets.
+            template <typename V, typename T>
+            SC_ALWAYS_INLINE const typename simd_vec<T, sizeof(V)>::unaligned& load(const T *p){
+                return *reinterpret_cast<const typename simd_vec<T, sizeof(V)>::unaligned*>(p);
+            }
+
+            /// Stores a vector to possibly unaligned memory.
+            template <typename V, typename T>
+            SC_ALWAYS_INLINE void store(T *p, const V &v){
+                *reinterpret_cast<typename simd_vec<T, sizeof(V)>::unaligned*>(p) = v;
+            }
+
+        //=== Kernels
+        /* The kernels are always inlined into their callers below, so each is compiled
+         * twice: for the AVX2 target (W = 32) and for the default one (W = 16).
+         */
+            /// Sum of p[0..n), accumulated in four vectors of sum_type<T>.
+            template <typename T, std::size_t W>
+            SC_ALWAYS_INLINE sum_type<T> sum_kernel(const T *p, std::size_t n){
+                using A = sum_type<T>;
+                constexpr std::size_t L = W / sizeof(A);
+                using VA = typename simd_vec<A, W>::type;
+                using VT = typename simd_vec<T, L * sizeof(T)>::type;
+                VA a0{}, a1{}, a2{}, a3{};
+                std::size_t i = 0;
+                for(; i + 4*L <= n; i += 4*L){
+                    a0 += __builtin_convertvector(load<VT>(p+i), VA);
+                    a1 += __builtin_convertvector(load<VT>(p+i+L), VA);
+                    a2 += __builtin_convertvector(load<VT>(p+i+2*L), VA);
+                    a3 += __builtin_convertvector(load<VT>(p+i+3*L), VA);
+                }
+                VA a = (a0 + a1) + (a2 + a3);
+                A s = 0;
+                for(std::size_t k = 0; k < L; k++) s += a[k];
+                for(; i < n; i++) s += p[i];
+                return s;
+            }
+
+            /// Dot product of a[0..n) and b[0..n), accumulated in four vectors of sum_type<T>.
+            template <typename T, std::size_t W>
+            SC_ALWAYS_INLINE sum_type<T> dot_kernel(const T *a, const T *b, std::size_t n){
+                using A = sum_type<T>;
+                constexpr std::size_t L = W / sizeof(A);
+                using VA = typename simd_vec<A, W>::type;
+                using VT = typename simd_vec<T, L * sizeof(T)>::type;
+                VA a0{}, a1{}, a2{}, a3{};
+                std::size_t i = 0;
+                for(; i + 4*L <= n; i += 4*L){
+                    a0 += __builtin_convertvector(load<VT>(a+i), VA) * __builtin_convertvector(load<VT>(b+i), VA);
+                    a1 += __builtin_convertvector(load<VT>(a+i+L), VA) * __builtin_convertvector(load<VT>(b+i+L), VA);
+                    a2 += __builtin_convertvector(load<VT>(a+i+2*L), VA) * __builtin_convertvector(load<VT>(b+i+2*L), VA);
+                    a3 += __builtin_convertvector(load<VT>(a+i+3*L), VA) * __builtin_convertvector(load<VT>(b+i+3*L), VA);
+                }
+                VA acc = (a0 + a1) + (a2 + a3);
+                A s = 0;
+                for(std::size_t k = 0; k < L; k++) s += acc[k];
+                for(; i < n; i++) s += A(a[i]) * A(b[i]);
+                return s;
+            }
+
+            /// Smallest and largest of p[0..n), n > 0, skipping NaNs.
+            template <typename T, std::size_t W>
+            SC_ALWAYS_INLINE std::pair<T, T> minmax_kernel(const T *p, std::size_t n){
+                constexpr std::size_t L = W / sizeof(T);
+                using V = typename simd_vec<T, W>::type;
+                T lo = *first_number(p, p + n), hi = lo;
+                std::size_t i = 0;
+                if(n >= 2*L){
+                    V lo0 = V{} + lo, lo1 = lo0; //lanes start from a number, never from a NaN
+                    V hi0 = lo0, hi1 = lo0;
+                    for(; i + 2*L <= n; i += 2*L){
+                        V x0 = load<V>(p+i), x1 = load<V>(p+i+L);
+                        lo0 = x0 < lo0 ? x0 : lo0;
+                        lo1 = x1 < lo1 ? x1 : lo1;
+                        hi0 = x0 > hi0 ? x0 : hi0;
+                        hi1 = x1 > hi1 ? x1 : hi1;
+                    }
+                    lo0 = lo1 < lo0 ? lo1 : lo0;
+                    hi0 = hi1 > hi0 ? hi1 : hi0;
+                    for(std::size_t k = 0; k < L; k++){
+                        if(lo0[k] < lo) lo = lo0[k];
+                        if(hi0[k] > hi) hi = hi0[k];
+                    }
+                }
+                for(; i < n; i++){
+                    if(p[i] < lo) lo = p[i];
+                    if(p[i] > hi) hi = p[i];
+                }
+                return {lo, hi};
+            }
+
+            /// Smallest (or, with Max, largest) of p[0..n), n > 0, skipping NaNs.
+            template <bool Max, typename T, std::size_t W>
+            SC_ALWAYS_INLINE T extreme_kernel(const T *p, std::size_t n){
+                constexpr std::size_t L = W / sizeof(T);
+                using V = typename simd_vec<T, W>::type;
+                T r = *first_number(p, p + n);
+                std::size_t i = 0;
+                if(n >= 4*L){
+                    V m0 = V{} + r, m1 = m0, m2 = m0, m3 = m0; //lanes start from a number, never from a NaN
+                    for(; i + 4*L <= n; i += 4*L){
+                        V x0 = load<V>(p+i), x1 = load<V>(p+i+L), x2 = load<V>(p+i+2*L), x3 = load<V>(p+i+3*L);
+                        if constexpr(Max){
+                            m0 = x0 > m0 ? x0 : m0; m1 = x1 > m1 ? x1 : m1;
+                            m2 = x2 > m2 ? x2 : m2; m3 = x3 > m3 ? x3 : m3;
+                        }
+                        else{
+                            m0 = x0 < m0 ? x0 : m0; m1 = x1 < m1 ? x1 : m1;
+                            m2 = x2 < m2 ? x2 : m2; m3 = x3 < m3 ? x3 : m3;
+                        }
+                    }
+                    for(std::size_t k = 0; k < L; k++){
+                        T lane[] = { m0[k], m1[k], m2[k], m3[k] };
+                        for(T x : lane){
+                            if(Max ? x > r : x < r) r = x;
+                        }
+                    }
+                }
+                for(; i < n; i++){
+                    if(Max ? p[i] > r : p[i] < r) r = p[i];
+                }
+                return r;
+            }
+
+            /// Index of the first element of p[0..n) equal to value, or n if there is none.
+            /*! Compares four vectors per step and only looks at single lanes in the block that has a match. */
+            template <typename T, std::size_t W>
+            SC_ALWAYS_INLINE std::size_t find_kernel(const T *p, std::size_t n, T value){
+                constexpr std::size_t L = W / sizeof(T);
+                using V = typename simd_vec<T, W>::type;
+                using M = decltype(V{} < V{});
+                V s = V{} + value;
+                std::size_t i = 0;
+                for(; i + 4*L <= n; i += 4*L){
+                    M c = (load<V>(p+i) == s) | (load<V>(p+i+L) == s)
+                        | (load<V>(p+i+2*L) == s) | (load<V>(p+i+3*L) == s);
+                    std::uint64_t words[W / 8], any = 0;
+                    std::memcpy(words, &c, W);
+                    for(std::size_t k = 0; k < W / 8; k++) any |= words[k];
+                    if(any != 0) break;
+                }
+                for(; i < n; i++){
+                    if(p[i] == value) return i;
+                }
+                return n;
+            }
+
+            /// Comparisons count_kernel() can count.
+            enum class cmp{ less, greater, equal };
+
+            /// Number of elements of p[0..n) for which `x Op value` holds.
+            template <cmp Op, typename T, std::size_t W>
+            SC_ALWAYS_INLINE std::size_t count_kernel(const T *p, std::size_t n, T value){
+                constexpr std::size_t L = W / sizeof(T);
+                using V = typename simd_vec<T, W>::type;
+                using M = decltype(V{} < V{}); //lanes are -1 where the comparison holds
+                V s = V{} + value;
+                std::size_t count = 0, i = 0;
+                while(i + L <= n){
+                    M c{};
+                    std::size_t chunk_end = i + (std::size_t(1) << 24) * L; //lanes never overflow
+                    for(; i + L <= n && i < chunk_end; i += L){
+                        V x = load<V>(p+i);
+                        if constexpr(Op == cmp::less) c -= (x < s);
+                        else if constexpr(Op == cmp::greater) c -= (x > s);
+                        else c -= (x == s);
+                    }
+                    for(std::size_t k = 0; k < L; k++) count += std::size_t(c[k]);
+                }
+                for(; i < n; i++){
+                    if constexpr(Op == cmp::less) count += p[i] < value;
+                    else if constexpr(Op == cmp::greater) count += p[i] > value;
+                    else count += p[i] == value;
+                }
+                return count;
+            }
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_shufflevector)
+#define SC_NUMERIC_SCAN_KERNEL 1
+            /// Adds to x its own lanes shifted K places up (zeros shifted in).
+            template <std::size_t K, typename V, std::size_t... I>
+            SC_ALWAYS_INLINE void add_shifted(V &x, std::index_sequence<I...>){
+                x += __builtin_shufflevector(x, V{}, (I >= K ? I - K : sizeof...(I))...);
+            }
+
+            /// Turns the lanes of x into their inclusive prefix sums, in log2(L) shift-and-add steps.
+            template <std::size_t K, std::size_t L, typename V>
+            SC_ALWAYS_INLINE void lane_scan(V &x){
+                if constexpr(K < L){
+                    add_shifted<K>(x, std::make_index_sequence<L>());
+                    lane_scan<2*K, L>(x);
+                }
+            }
+
+            /// Sets every lane of c to the last lane of x.
+            template <typename V, std::size_t... I>
+            SC_ALWAYS_INLINE void broadcast_last(V &c, const V &x, std::index_sequence<I...>){
+                c = __builtin_shufflevector(x, x, (I*0 + sizeof...(I)-1)...);
+            }
+
+            /// Writes the inclusive prefix sums of in[0..n) to out (which may be in).
+            /*! The running total is carried as a vector, so blocks chain through one shuffle and one add. */
+            template <typename T, std::size_t W>
+            SC_ALWAYS_INLINE void scan_kernel(const T *in, std::size_t n, T *out){
+                constexpr std::size_t L = W / sizeof(T);
+                using V = typename simd_vec<T, W>::type;
+                V c{};
+                std::size_t i = 0;
+                for(; i + L <= n; i += L){
+                    V x = load<V>(in+i);
+                    lane_scan<1, L>(x);
+                    x += c;
+                    store(out+i, x);
+                    broadcast_last(c, x, std::make_index_sequence<L>());
+                }
+                T carry = c[0];
+                for(; i < n; i++){
+                    carry += in[i];
+                    out[i] = carry;
+                }
+            }
+#endif
+#endif
+
+        //=== Dispatch targets
+            template <typename T>
+            __attribute__((target("avx2"))) sum_type<T> sum_avx2(const T *p, std::size_t n){ return sum_kernel<T, 32>(p, n); }
+            template <typename T>
+            sum_type<T> sum_sse2(const T *p, std::size_t n){ return sum_kernel<T, 16>(p, n); }
+
+            template <typename T>
+            __attribute__((target("avx2"))) sum_type<T> dot_avx2(const T *a, const T *b, std::size_t n){ return dot_kernel<T, 32>(a, b, n); }
+            template <typename T>
+            sum_type<T> dot_sse2(const T *a, const T *b, std::size_t n){ return dot_kernel<T, 16>(a, b, n); }
+
+            template <typename T>
+            __attribute__((target("avx2"))) std::pair<T, T> minmax_avx2(const T *p, std::size_t n){ return minmax_kernel<T, 32>(p, n); }
+            template <typename T>
+            std::pair<T, T> minmax_sse2(const T *p, std::size_t n){ return minmax_kernel<T, 16>(p, n); }
+
+            template <bool Max, typename T>
+            __attribute__((target("avx2"))) T extreme_avx2(const T *p, std::size_t n){ return extreme_kernel<Max, T, 32>(p, n); }
+            template <bool Max, typename T>
+            T extreme_sse2(const T *p, std::size_t n){ return extreme_kernel<Max, T, 16>(p, n); }
+
+            template <typename T>
+            __attribute__((target("avx2"))) std::size_t find_avx2(const T *p, std::size_t n, T v){ return find_kernel<T, 32>(p, n, v); }
+            template <typename T>
+            std::size_t find_sse2(const T *p, std::size_t n, T v){ return find_kernel<T, 16>(p, n, v); }
+
+            template <cmp Op, typename T>
+            __attribute__((target("avx2"))) std::size_t count_avx2(const T *p, std::size_t n, T v){ return count_kernel<Op, T, 32>(p, n, v); }
+            template <cmp Op, typename T>
+            std::size_t count_sse2(const T *p, std::size_t n, T v){ return count_kernel<Op, T, 16>(p, n, v); }
+
+#ifdef SC_NUMERIC_SCAN_KERNEL
+            template <typename T>
+            __attribute__((target("avx2"))) void scan_avx2(const T *in, std::size_t n, T *out){ scan_kernel<T, 32>(in, n, out); }
+            template <typename T>
+            void scan_sse2(const T *in, std::size_t n, T *out){ scan_kernel<T, 16>(in, n, out); }
+#endif
+#undef SC_ALWAYS_INLINE
+#else
+            template <typename T>
+            struct vectorizable : std::false_type{ };
+#endif
+
+            /// Counts the elements of [first, last) that satisfy pred, with the SIMD kernel for cmp Op.
+            template <cmp Op, typename T, typename Pred>
+            std::size_t count(const T *first, const T *last, T value, Pred pred){
+#ifdef SC_NUMERIC_KERNELS
+                if constexpr(vectorizable<T>::value){
+                    if(simd::has_avx2()) return count_avx2<Op>(first, last-first, value);
+                    return count_sse2<Op>(first, last-first, value);
+                }
+#endif
+                (void)value;
+                std::size_t n = 0;
+                for(; first != last; first++){
+                    n += pred(*first) ? 1 : 0;
+                }
+                return n;
+            }
+
+            /// Throws if a min/max range is empty.
+            inline void require_elements(const void *first, const void *last, const char *what){
+                if(first == last) throw std::invalid_argument(what);
+            }
+
+            /// Index of the first smallest (or, with Max, largest) element of [first, last), which is not empty.
+            /*! With the kernels this is two passes, the extreme and then the first element equal
+             * to it, which beats one pass that has to carry an index per lane.
+             */
+            template <bool Max, typename T>
+            std::size_t arg_extreme(const T *first, const T *last){
+#ifdef SC_NUMERIC_KERNELS
+                if constexpr(vectorizable<T>::value){
+                    std::size_t n = last - first, i;
+                    if(simd::has_avx2()) i = find_avx2(first, n, extreme_avx2<Max>(first, n));
+                    else i = find_sse2(first, n, extreme_sse2<Max>(first, n));
+                    return i == n ? 0 : i; //only when every element is NaN, as in the loop below
+                }
+#endif
+                const T *r = first_number(first, last);
+                for(const T *p = first + 1; p != last; p++){
+                    if(Max ? *r < *p : *p < *r) r = p;
+                }
+                return std::size_t(r - first);
+            }
+        }
+
+    //=== Reductions
+        /// Returns the sum of the elements in [first, last) (0 if empty), as sum_type<T>.
+        template <typename T>
+        sum_type<T> sum(const T *first, const T *last){
+#ifdef SC_NUMERIC_KERNELS
+            if constexpr(detail::vectorizable<T>::value){
+                if(simd::has_avx2()) return detail::sum_avx2(first, last-first);
+                return detail::sum_sse2(first, last-first);
+            }
+#endif
+            sum_type<T> s = 0;
+            for(; first != last; first++){
+                s += *first;
+            }
+            return s;
+        }
+
+        /// Returns the dot product of [first1, last1) and the range of the same length at first2.
+        template <typename T>
+        sum_type<T> dot(const T *first1, const T *last1, const T *first2){
+#ifdef SC_NUMERIC_KERNELS
+            if constexpr(detail::vectorizable<T>::value){
+                if(simd::has_avx2()) return detail::dot_avx2(first1, first2, last1-first1);
+                return detail::dot_sse2(first1, first2, last1-first1);
+            }
+#endif
+            sum_type<T> s = 0;
+            for(; first1 != last1; first1++, first2++){
+                s += sum_type<T>(*first1) * sum_type<T>(*first2);
+            }
+            return s;
+        }
+
+        /// Returns the smallest element of [first, last).
+        /*!
+        * @throw Generates `invalid_argument` exception if the range is empty.
+        */
+        template <typename T>
+        T min(const T *first, const T *last){
+            detail::require_elements(first, last, "[numeric::min()] Empty range.");
+#ifdef SC_NUMERIC_KERNELS
+            if constexpr(detail::vectorizable<T>::value){
+                if(simd::has_avx2()) return detail::extreme_avx2<false>(first, last-first);
+                return detail::extreme_sse2<false>(first, last-first);
+            }
+#endif
+            T r = *detail::first_number(first, last);
+            for(; first != last; first++){
+                if(*first < r) r = *first;
+            }
+            return r;
+        }
+
+        /// Returns the largest element of [first, last).
+        /*!
+        * @throw Generates `invalid_argument` exception if the range is empty.
+        */
+        template <typename T>
+        T max(const T *first, const T *last){
+            detail::require_elements(first, last, "[numeric::max()] Empty range.");
+#ifdef SC_NUMERIC_KERNELS
+            if constexpr(detail::vectorizable<T>::value){
+                if(simd::has_avx2()) return detail::extreme_avx2<true>(first, last-first);
+                return detail::extreme_sse2<true>(first, last-first);
+            }
+#endif
+            T r = *detail::first_number(first, last);
+            for(; first != last; first++){
+                if(*first > r) r = *first;
+            }
+            return r;
+        }
+
+        /// Returns the smallest and the largest element of [first, last), in one pass.
+        /*!
+        * @throw Generates `invalid_argument` exception if the range is empty.
+        */
+        template <typename T>
+        std::pair<T, T> minmax(const T *first, const T *last){
+            detail::require_elements(first, last, "[numeric::minmax()] Empty range.");
+#ifdef SC_NUMERIC_KERNELS
+            if constexpr(detail::vectorizable<T>::value){
+                if(simd::has_avx2()) return detail::minmax_avx2(first, last-first);
+                return detail::minmax_sse2(first, last-first);
+            }
+#endif
+            T start = *detail::first_number(first, last);
+            std::pair<T, T> r(start, start);
+            for(; first != last; first++){
+                if(*first < r.first) r.first = *first;
+                if(*first > r.second) r.second = *first;
+            }
+            return r;
+        }
+
+        /// Returns the index of the first smallest element of [first, last), as std::min_element would.
+        /*!
+        * @throw Generates `invalid_argument` exception if the range is empty.
+        */
+        template <typename T>
+        std::size_t argmin(const T *first, const T *last){
+            detail::require_elements(first, last, "[numeric::argmin()] Empty range.");
+            return detail::arg_extreme<false>(first, last);
+        }
+
+        /// Returns the index of the first largest element of [first, last).
+        /*!
+        * @throw Generates `invalid_argument` exception if the range is empty.
+        */
+        template <typename T>
+        std::size_t argmax(const T *first, const T *last){
+            detail::require_elements(first, last, "[numeric::argmax()] Empty range.");
+            return detail::arg_extreme<true>(first, last);
+        }
+
+        /// Counts the elements of [first, last) that satisfy pred.
+        /*! less_than, greater_than and equal_to run on the SIMD kernels; other predicates use a plain loop. */
+        template <typename T, typename Pred>
+        std::size_t count_if(const T *first, const T *last, Pred pred){
+            std::size_t n = 0;
+            for(; first != last; first++){
+                n += pred(*first) ? 1 : 0;
+            }
+            return n;
+        }
+
+        template <typename T>
+        std::size_t count_if(const T *first, const T *last, less_than<T> pred){
+            return detail::count<detail::cmp::less>(first, last, pred.value, pred);
+        }
+
+        template <typename T>
+        std::size_t count_if(const T *first, const T *last, greater_than<T> pred){
+            return detail::count<detail::cmp::greater>(first, last, pred.value, pred);
+        }
+
+        template <typename T>
+        std::size_t count_if(const T *first, const T *last, equal_to<T> pred){
+            return detail::count<detail::cmp::equal>(first, last, pred.value, pred);
+        }
+
+    //=== Scans
+        /// Writes the running sums of [first, last) to d_first (which may be first). Returns the end of the output.
+        template <typename T>
+        T* inclusive_scan(const T *first, const T *last, T *d_first){
+#if defined(SC_NUMERIC_KERNELS) && defined(SC_NUMERIC_SCAN_KERNEL)
+            if constexpr(detail::vectorizable<T>::value){
+                if(simd::has_avx2()) detail::scan_avx2(first, last-first, d_first);
+                else detail::scan_sse2(first, last-first, d_first);
+                return d_first + (last-first);
+            }
+#endif
+            T carry = T();
+            for(; first != last; first++, d_first++){
+                carry = carry + *first;
+                *d_first = carry;
+            }
+            return d_first;
+        }
+
+    //=== Whole containers (anything contiguous with data() and size())
+        /// Returns the sum of the elements of c.
+        template <typename C>
+        auto sum(const C &c){
+            return sum(c.data(), c.data() + c.size());
+        }
+
+        /// Returns the dot product of a and b, which must have the same size.
+        template <typename C>
+        auto dot(const C &a, const C &b){
+            return dot(a.data(), a.data() + a.size(), b.data());
+        }
+
+        /// Returns the smallest element of c.
+        template <typename C>
+        auto min(const C &c){
+            return min(c.data(), c.data() + c.size());
+        }
+
+        /// Returns the largest element of c.
+        template <typename C>
+        auto max(const C &c){
+            return max(c.data(), c.data() + c.size());
+        }
+
+        /// Returns the smallest and the largest element of c.
+        template <typename C>
+        auto minmax(const C &c){
+            return minmax(c.data(), c.data() + c.size());
+        }
+
+        /// Returns the index of the first smallest element of c.
+        template <typename C>
+        std::size_t argmin(const C &c){
+            return argmin(c.data(), c.data() + c.size());
+        }
+
+        /// Returns the index of the first largest element of c.
+        template <typename C>
+        std::size_t argmax(const C &c){
+            return argmax(c.data(), c.data() + c.size());
+        }
+
+        /// Counts the elements of c that satisfy pred.
+        template <typename C, typename Pred>
+        std::size_t count_if(const C &c, Pred pred){
+            return count_if(c.data(), c.data() + c.size(), pred);
+        }
+
+        /// Replaces the elements of c with their running sums.
+        template <typename C>
+        void inclusive_scan(C &c){
+            inclusive_scan(c.data(), c.data() + c.size(), c.data());
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,324 @@
+/*!
+ * \file parallel.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace sc{ // sc: Sequence container
+    /// Work-stealing thread pool.
+    /*! Every worker owns a deque of tasks: it pushes and pops its own tasks at the back
+     * (newest first, which keeps recursively split work cache-friendly) and, when it runs
+     * dry, steals from the front of the other deques (the oldest, hence largest, pieces).
+     * Tasks submitted from outside the pool go to one more, shared, deque.
+     *
+     * A thread that waits for a result (wait_until) runs pending tasks meanwhile, so the
+     * caller works as one more thread and nested parallel calls cannot deadlock.
+     */
+    class thread_pool{
+        public:
+            using task = std::function<void()>; //!< Unit of work.
+
+        //=== Private data
+        private:
+            /// Deque of tasks owned by one worker (the last one is the shared injection queue).
+            struct queue{
+                std::mutex mutex;
+                std::deque<task> tasks;
+            };
+
+            std::vector<std::unique_ptr<queue>> queues_; //!< One per worker, plus the injection queue.
+            std::vector<std::thread> threads_; //!< The workers.
+            std::atomic<std::size_t> pending_; //!< Tasks queued and not yet taken.
+            std::atomic<bool> stop_; //!< Tells the workers to exit.
+            std::mutex sleep_mutex_; //!< Guards the sleep of idle workers.
+            std::condition_variable wake_; //!< Wakes idle workers when tasks arrive.
+
+            inline static thread_local thread_pool *current_pool_ = nullptr; //!< Pool of the calling worker thread.
+            inline static thread_local std::size_t current_index_ = 0; //!< Queue of the calling worker thread.
+
+        //=== Private helpers
+        private:
+            /// Pops a task from the back of queue i, or from its front when stealing.
+            bool take(std::size_t i, bool steal, task &out){
+                queue &q = *queues_[i];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if(q.tasks.empty()) return false;
+                if(steal){
+                    out = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                }
+                else{
+                    out = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                }
+                pending_.fetch_sub(1);
+                return true;
+            }
+
+            /// Body of worker i: run tasks, sleep when there are none.
+            void work(std::size_t i){
+                current_pool_ = this;
+                current_index_ = i;
+                while(!stop_.load()){
+                    if(run_one()) continue;
+                    std::unique_lock<std::mutex> lock(sleep_mutex_);
+                    wake_.wait_for(lock, std::chrono::milliseconds(100), [this]{ return stop_.load() || pending_.load() > 0; });
+                }
+            }
+
+        //=== Public interface
+        public:
+            /// Starts `threads` workers. The thread that waits for results works too.
+            explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+                : pending_{0}, stop_{false}{
+                for(std::size_t i = 0; i <= threads; i++){
+                    queues_.emplace_back(new queue);
+                }
+                for(std::size_t i = 0; i < threads; i++){
+                    threads_.emplace_back([this, i]{ work(i); });
+                }
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            /// Stops the workers once they finish the tasks they are running. Queued tasks are dropped.
+            ~thread_pool(){
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                    stop_.store(true);
+                }
+                wake_.notify_all();
+                for(std::thread &t : threads_){
+                    t.join();
+                }
+            }
+
+            /// Returns the number of worker threads.
+            std::size_t size() const{
+                return threads_.size();
+            }
+
+            /// Queues a task: on the calling worker's own deque, or on the injection queue from outside.
+            void submit(task t){
+                std::size_t i = current_pool_ == this ? current_index_ : queues_.size()-1;
+                {
+                    std::lock_guard<std::mutex> lock(queues_[i]->mutex);
+                    queues_[i]->tasks.push_back(std::move(t));
+                }
+                pending_.fetch_add(1);
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                }
+                wake_.notify_one();
+            }
+
+            /// Runs one pending task, if any: the caller's own newest task first, else one stolen from another queue.
+            bool run_one(){
+                if(pending_.load() == 0) return false;
+                task t;
+                std::size_t n = queues_.size();
+                std::size_t me = current_pool_ == this ? current_index_ : n-1;
+                bool found = take(me, false, t);
+                for(std::size_t k = 1; !found && k < n; k++){
+                    found = take((me + k) % n, true, t);
+                }
+                if(!found) return false;
+                t();
+                return true;
+            }
+
+            /// Runs pending tasks until done() returns true.
+            template <typename Predicate>
+            void wait_until(Predicate done){
+                while(!done()){
+                    if(!run_one()) std::this_thread::yield();
+                }
+            }
+
+            /// Returns the pool used by default: one worker per hardware thread but the caller's.
+            static thread_pool& global(){
+                static thread_pool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency()-1 : 1);
+                return pool;
+            }
+    };
+
+    /// Parallel versions of the common algorithms, run on a thread_pool.
+    /*! The range is split recursively down to `grain` elements; the pieces are spread over
+     * the workers by work stealing. Exceptions thrown by the functions are rethrown in the
+     * caller (the first one, if several are thrown) once every piece has finished.
+     */
+    namespace parallel{
+        /// Tuning knobs shared by all the algorithms.
+        struct options{
+            std::size_t grain = 0; //!< Elements per piece; 0 picks one from the size and the number of threads.
+            bool deterministic = false; //!< reduce() splits and combines in a fixed order, whatever the thread count.
+            thread_pool *pool = nullptr; //!< Pool to run on; nullptr means thread_pool::global().
+        };
+
+        namespace detail{
+            /// Pieces of a fixed size, used for deterministic reductions when no grain is given.
+            constexpr std::size_t deterministic_grain = 16*1024;
+
+            /// Resolves the options for a range of n elements.
+            inline std::size_t grain_for(const options &opt, thread_pool &pool, std::size_t n){
+                if(opt.grain > 0) return opt.grain;
+                if(opt.deterministic) return deterministic_grain;
+                std::size_t pieces = (pool.size() + 1) * 8; //some slack for stealing to even out the load
+                std::size_t grain = n / pieces;
+                return grain < 1024 ? 1024 : grain;
+            }
+
+            /// State shared by the pieces of one parallel_for.
+            template <typename Body>
+            struct job{
+                thread_pool *pool;
+                const Body *body;
+                std::size_t grain;
+                std::atomic<std::size_t> remaining; //!< Elements whose piece has not finished.
+                std::mutex error_mutex;
+                std::exception_ptr error; //!< First exception thrown by a piece.
+
+                /// Runs [lo, hi): hands the upper halves to the pool until the rest fits in a grain.
+                static void run(job *j, std::size_t lo, std::size_t hi){
+                    while(hi - lo > j->grain){
+                        std::size_t mid = lo + (hi - lo) / 2;
+                        j->pool->submit([j, mid, hi]{ run(j, mid, hi); });
+                        hi = mid;
+                    }
+                    try{
+                        (*j->body)(lo, hi);
+                    }
+                    catch(...){
+                        std::lock_guard<std::mutex> lock(j->error_mutex);
+                        if(!j->error) j->error = std::current_exception();
+                    }
+                    j->remaining.fetch_sub(hi - lo); //last access to *j: the caller may return right after
+                }
+            };
+
+            /// Calls body(lo, hi) over pieces of [0, n) in parallel and waits for all of them.
+            template <typename Body>
+            void parallel_for(thread_pool &pool, std::size_t n, std::size_t grain, const Body &body){
+                if(n == 0) return;
+                if(n <= grain){
+                    body(0, n);
+                    return;
+                }
+                job<Body> j{&pool, &body, grain, {n}, {}, {}};
+                job<Body>::run(&j, 0, n);
+                pool.wait_until([&j]{ return j.remaining.load() == 0; });
+                if(j.error) std::rethrow_exception(j.error);
+            }
+        }
+
+        /// Calls f on every element of [first, last).
+        template <typename RandomIt, typename Function>
+        void for_each(RandomIt first, RandomIt last, Function f, const options &opt = {}){
+            thread_pool &pool = opt.pool ? *opt.pool : thread_pool::global();
+            std::size_t n = last - first;
+            detail::parallel_for(pool, n, detail::grain_for(opt, pool, n), [&](std::size_t lo, std::size_t hi){
+                for(RandomIt it = first + lo, end = first + hi; it != end; ++it){
+                    f(*it);
+                }
+            });
+        }
+
+        /// Writes f(x) for every x of [first, last) to the range at d_first. Returns the end of the output.
+        template <typename RandomIt, typename OutputIt, typename Function>
+        OutputIt transform(RandomIt first, RandomIt last, OutputIt d_first, Function f, const options &opt = {}){
+            thread_pool &pool = opt.pool ? *opt.pool : thread_pool::global();
+            std::size_t n = last - first;
+            detail::parallel_for(pool, n, detail::grain_for(opt, pool, n), [&](std::size_t lo, std::size_t hi){
+                OutputIt out = d_first + lo;
+                for(RandomIt it = first + lo, end = first + hi; it != end; ++it, ++out){
+                    *out = f(*it);
+                }
+            });
+            return d_first + n;
+        }
+
+        /// Assigns value to every element of [first, last).
+        template <typename RandomIt, typename T>
+        void fill(RandomIt first, RandomIt last, const T &value, const options &opt = {}){
+            thread_pool &pool = opt.pool ? *opt.pool : thread_pool::global();
+            std::size_t n = last - first;
+            detail::parallel_for(pool, n, detail::grain_for(opt, pool, n), [&](std::size_t lo, std::size_t hi){
+                std::fill(first + lo, first + hi, value);
+            });
+        }
+
+        /// Copies [first, last) to the range at d_first. Returns the end of the output.
+        template <typename RandomIt, typename OutputIt>
+        OutputIt copy(RandomIt first, RandomIt last, OutputIt d_first, const options &opt = {}){
+            thread_pool &pool = opt.pool ? *opt.pool : thread_pool::global();
+            std::size_t n = last - first;
+            detail::parallel_for(pool, n, detail::grain_for(opt, pool, n), [&](std::size_t lo, std::size_t hi){
+                std::copy(first + lo, first + hi, d_first + lo);
+            });
+            return d_first + n;
+        }
+
+        /// Combines init and the elements of [first, last) with op, which must be associative.
+        /*! By default the partial results are combined as the pieces finish, so op must be
+         * commutative too and floating point results may vary from run to run. With
+         * `deterministic`, the pieces have fixed bounds (independent of the thread count)
+         * and are combined left to right: the result is reproducible and op need not commute.
+         */
+        template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+        T reduce(RandomIt first, RandomIt last, T init, BinaryOp op = {}, const options &opt = {}){
+            thread_pool &pool = opt.pool ? *opt.pool : thread_pool::global();
+            std::size_t n = last - first;
+            if(n == 0) return init;
+            std::size_t grain = detail::grain_for(opt, pool, n);
+            /// Folds the piece [lo, hi) starting from its first element.
+            auto fold = [&](std::size_t lo, std::size_t hi){
+                T acc = *(first + lo);
+                for(RandomIt it = first + lo + 1, end = first + hi; it != end; ++it){
+                    acc = op(std::move(acc), *it);
+                }
+                return acc;
+            };
+            if(opt.deterministic){
+                std::size_t pieces = (n + grain - 1) / grain;
+                std::vector<T> partial(pieces, init);
+                detail::parallel_for(pool, pieces, 1, [&](std::size_t lo, std::size_t hi){
+                    for(std::size_t k = lo; k < hi; k++){
+                        partial[k] = fold(k * grain, k + 1 == pieces ? n : (k+1) * grain);
+                    }
+                });
+                for(std::size_t k = 0; k < pieces; k++){
+                    init = op(std::move(init), std::move(partial[k]));
+                }
+                return init;
+            }
+            std::mutex mutex;
+            detail::parallel_for(pool, n, grain, [&](std::size_t lo, std::size_t hi){
+                T acc = fold(lo, hi);
+                std::lock_guard<std::mutex> lock(mutex);
+                init = op(std::move(init), std::move(acc));
+            });
+            return init;
+        }
+    }
+}
+
+#endif
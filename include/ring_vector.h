@@ -0,0 +1,461 @@
+/*!
+ * \file ring_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef RING_VECTOR_H
+#define RING_VECTOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "span.h"
+
+namespace sc{ // sc: Sequence container
+    /// Fixed-capacity circular buffer with the access API of sc::vector.
+    /*! The capacity is allocated once, by the constructor; after that pushes and pops at
+     * either end are O(1) and never allocate, because the elements wrap around the end of
+     * the block. When the buffer is full, a push either throws `length_error` or, in
+     * overwrite mode, drops the element at the opposite end to make room (a sliding window).
+     * The elements occupy at most two contiguous runs of the block; as_spans() exposes them
+     * for bulk processing.
+     */
+    template <typename T>
+    class ring_vector{
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using pointer = value_type*; //!< Pointer to a value stored in the container.
+            using reference = value_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+
+            /// A contiguous run of elements (see span.h).
+            template <typename U>
+            using span = sc::span<U>;
+
+        //=== Iterators
+            /// Random access iterator over the logical order (front to back), wrapping around the block.
+            template <typename U>
+            class basic_iterator{
+                public:
+                    typedef U& reference; //!< Reference to the value type.
+                    typedef U* pointer; //!< Pointer to the value type.
+                    typedef T value_type; //!< Value type the iterator points to.
+                    /// Difference type used to calculated distance between iterators.
+                    typedef std::ptrdiff_t difference_type;
+                    /// Identifies the iterator category to algorithms from STL
+                    typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+                //=== Private data
+                private:
+                    U *block; //!< Storage area of the ring.
+                    size_type capacity_; //!< Slots in the block.
+                    size_type head_; //!< Slot of the first element.
+                    size_type pos_; //!< Logical position (0 is the front).
+
+                    friend class ring_vector;
+                    template <typename> friend class basic_iterator;
+                //=== Public interface
+                public:
+                    /// Constructor
+                    basic_iterator(U *b = nullptr, size_type cap = 0, size_type head = 0, size_type pos = 0)
+                        : block{b}, capacity_{cap}, head_{head}, pos_{pos}{
+                        /*empty*/
+                    }
+
+                    /// Converts an iterator into a const_iterator.
+                    template <typename V, typename = std::enable_if_t<std::is_same<const V, U>::value && !std::is_same<V, U>::value>>
+                    basic_iterator(const basic_iterator<V> &other)
+                        : block{other.block}, capacity_{other.capacity_}, head_{other.head_}, pos_{other.pos_}{
+                        /*empty*/
+                    }
+
+                //=== Iterator operations
+                    /// Return a reference to the object located at the position pointed by the iterator
+                    reference operator*() const{
+                        size_type slot = head_ + pos_;
+                        return block[slot >= capacity_ ? slot - capacity_ : slot];
+                    }
+
+                    /// Return a pointer to the object located at the position pointed by the iterator
+                    pointer operator->() const{
+                        return &**this;
+                    }
+
+                    /// Return a reference to the object n positions away from the iterator
+                    reference operator[](difference_type n) const{
+                        return *(*this + n);
+                    }
+
+                    basic_iterator& operator++(){ ++pos_; return *this; }
+                    basic_iterator operator++(int){ basic_iterator temp(*this); ++pos_; return temp; }
+                    basic_iterator& operator--(){ --pos_; return *this; }
+                    basic_iterator operator--(int){ basic_iterator temp(*this); --pos_; return temp; }
+                    basic_iterator& operator+=(difference_type n){ pos_ += n; return *this; }
+                    basic_iterator& operator-=(difference_type n){ pos_ -= n; return *this; }
+
+                    friend basic_iterator operator+(basic_iterator it, difference_type n){ return it += n; }
+                    friend basic_iterator operator+(difference_type n, basic_iterator it){ return it += n; }
+                    friend basic_iterator operator-(basic_iterator it, difference_type n){ return it -= n; }
+
+                    /// Return the difference between two iterators.
+                    friend difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return difference_type(lhs.pos_) - difference_type(rhs.pos_);
+                    }
+
+                    friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ == rhs.pos_; }
+                    friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ != rhs.pos_; }
+                    friend bool operator<(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ < rhs.pos_; }
+                    friend bool operator>(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ > rhs.pos_; }
+                    friend bool operator<=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ <= rhs.pos_; }
+                    friend bool operator>=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ >= rhs.pos_; }
+            };
+
+            using iterator = basic_iterator<T>; //!< Iterator over the elements, front to back.
+            using const_iterator = basic_iterator<const T>; //!< Constant iterator over the elements, front to back.
+
+        //=== Private data
+        private:
+            T *block; //!< Storage area, allocated once.
+            size_type capacity_; //!< Slots in the block.
+            size_type head_; //!< Slot of the first element.
+            size_type size_; //!< Number of elements currently in the ring.
+            bool overwrite_; //!< If true, pushing into a full ring drops the element at the other end.
+
+        //=== Private helpers
+        private:
+            /// Returns the slot of the element at logical position pos (pos <= capacity_).
+            size_type slot(size_type pos) const{
+                size_type s = head_ + pos;
+                return s >= capacity_ ? s - capacity_ : s;
+            }
+
+            /// Destroys every element, leaving the ring empty.
+            void destroy_all(){
+                if constexpr(!std::is_trivially_destructible<T>::value){
+                    for(size_type i = 0; i < size_; i++){
+                        block[slot(i)].~T();
+                    }
+                }
+                size_ = 0;
+                head_ = 0;
+            }
+
+            /// Makes room for one more element, dropping the one at the opposite end if full and in overwrite mode.
+            /*!
+            * @throw Generates `length_error` if the ring is full and not in overwrite mode.
+            */
+            void make_room(bool at_front){
+                if(size_ < capacity_) return;
+                if(!overwrite_ || capacity_ == 0){
+                    throw std::length_error("[ring_vector::push()] Ring is full.");
+                }
+                if(at_front) pop_back();
+                else pop_front();
+            }
+
+        //=== Public interface
+        public:
+        //=== Constructors, Destructors, and Assignment.
+            /// Constructs an empty ring with room for `capacity` elements. This is the only allocation.
+            explicit ring_vector(size_type capacity = 0, bool overwrite = false)
+                : block{capacity == 0 ? nullptr : std::allocator<T>().allocate(capacity)},
+                  capacity_{capacity}, head_{0}, size_{0}, overwrite_{overwrite}{
+                /*empty*/
+            }
+
+            /// Constructs a ring as large as ilist, holding its elements.
+            ring_vector(std::initializer_list<T> ilist, bool overwrite = false) : ring_vector(ilist.size(), overwrite){
+                for(const T &value : ilist){
+                    push_back(value);
+                }
+            }
+
+            /// Copy constructor. Same capacity, mode and elements as other.
+            ring_vector(const ring_vector& other) : ring_vector(other.capacity_, other.overwrite_){
+                for(size_type i = 0; i < other.size_; i++){
+                    push_back(other[i]);
+                }
+            }
+
+            /// Move constructor. Takes over the block of other, which is left with no capacity.
+            ring_vector(ring_vector&& other) noexcept : ring_vector(0, other.overwrite_){
+                swap(other);
+            }
+
+            /// Destructs the ring.
+            ~ring_vector(){
+                destroy_all();
+                if(block != nullptr) std::allocator<T>().deallocate(block, capacity_);
+            }
+
+            /// Copy assignment operator.
+            ring_vector& operator=(const ring_vector& other){
+                if(this != &other){
+                    ring_vector copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            /// Move assignment operator.
+            ring_vector& operator=(ring_vector&& other) noexcept{
+                if(this != &other){
+                    ring_vector moved(std::move(other));
+                    swap(moved);
+                }
+                return *this;
+            }
+
+        //=== Common operations
+            /// Return the number of elements in the container.
+            size_type size() const{
+                return size_;
+            }
+
+            /// Return the fixed number of slots in the ring.
+            size_type capacity() const{
+                return capacity_;
+            }
+
+            /// Returns true if the container contains no elements, and false otherwise.
+            bool empty() const{
+                return size_ == 0;
+            }
+
+            /// Returns true if a push needs to drop an element (or throw).
+            bool full() const{
+                return size_ == capacity_;
+            }
+
+            /// Returns true if pushing into a full ring drops the element at the other end.
+            bool overwrite() const{
+                return overwrite_;
+            }
+
+            /// Turns the overwrite mode on or off.
+            void overwrite(bool on){
+                overwrite_ = on;
+            }
+
+            /// Remove all elements from the container. Keeps the block.
+            void clear(){
+                destroy_all();
+            }
+
+            /// Adds value to the end of the ring. O(1).
+            void push_back(const T &value){
+                emplace_back(value);
+            }
+
+            /// Moves value to the end of the ring. O(1).
+            void push_back(T &&value){
+                emplace_back(std::move(value));
+            }
+
+            /// Adds value to the front of the ring. O(1).
+            void push_front(const T &value){
+                emplace_front(value);
+            }
+
+            /// Moves value to the front of the ring. O(1).
+            void push_front(T &&value){
+                emplace_front(std::move(value));
+            }
+
+            /// Constructs a new element at the end of the ring from args. In overwrite mode a full ring drops its front.
+            template <typename... Args>
+            T& emplace_back(Args&&... args){
+                if(size_ == capacity_ && overwrite_ && capacity_ > 0){
+                    T item(std::forward<Args>(args)...); //args may refer to the element being dropped
+                    pop_front();
+                    return *new (&block[slot(size_++)]) T(std::move(item));
+                }
+                make_room(false);
+                T *p = new (&block[slot(size_)]) T(std::forward<Args>(args)...);
+                size_ += 1;
+                return *p;
+            }
+
+            /// Constructs a new element at the front of the ring from args. In overwrite mode a full ring drops its back.
+            template <typename... Args>
+            T& emplace_front(Args&&... args){
+                if(size_ == capacity_ && overwrite_ && capacity_ > 0){
+                    T item(std::forward<Args>(args)...); //args may refer to the element being dropped
+                    pop_back();
+                    return emplace_front(std::move(item));
+                }
+                make_room(true);
+                size_type new_head = head_ == 0 ? capacity_-1 : head_-1;
+                T *p = new (&block[new_head]) T(std::forward<Args>(args)...);
+                head_ = new_head;
+                size_ += 1;
+                return *p;
+            }
+
+            /// Removes the object at the end of the ring. O(1).
+            void pop_back(){
+                if(size_ > 0){
+                    size_ -= 1;
+                    block[slot(size_)].~T();
+                }
+            }
+
+            /// Removes the object at the front of the ring. O(1).
+            void pop_front(){
+                if(size_ > 0){
+                    block[head_].~T();
+                    head_ = head_+1 == capacity_ ? 0 : head_+1;
+                    size_ -= 1;
+                }
+            }
+
+            /// Returns the object at the end of the ring.
+            T& back(){
+                return block[slot(size_-1)];
+            }
+
+            /// Returns the object at the end of the ring.
+            const T& back() const{
+                return block[slot(size_-1)];
+            }
+
+            /// Returns the object at the beginning of the ring.
+            T& front(){
+                return block[head_];
+            }
+
+            /// Returns the object at the beginning of the ring.
+            const T& front() const{
+                return block[head_];
+            }
+
+            /// Returns the object at the logical index pos (0 is the front), with no bounds-checking.
+            T & operator[](size_type pos){
+                return block[slot(pos)];
+            }
+
+            /// Returns the object at the logical index pos (0 is the front), with no bounds-checking.
+            const T & operator[](size_type pos) const{
+                return block[slot(pos)];
+            }
+
+            /// Returns the object at the logical index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the ring.
+            */
+            T & at(size_type pos){
+                if(pos >= size_){
+                    throw std::out_of_range("[ring_vector::at()] Position entered beyond ring boundaries.");
+                }
+                return block[slot(pos)];
+            }
+
+            /// Returns the object at the logical index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the ring.
+            */
+            const T & at(size_type pos) const{
+                if(pos >= size_){
+                    throw std::out_of_range("[ring_vector::at()] Position entered beyond ring boundaries.");
+                }
+                return block[slot(pos)];
+            }
+
+            /// Returns the elements, front to back, as at most two contiguous runs.
+            /*! The second run is empty unless the elements wrap around the end of the block. */
+            std::pair<span<T>, span<T>> as_spans(){
+                size_type first_run = capacity_ - head_ < size_ ? capacity_ - head_ : size_;
+                return { span<T>{block + head_, first_run}, span<T>{block, size_ - first_run} };
+            }
+
+            /// Returns the elements, front to back, as at most two contiguous runs.
+            std::pair<span<const T>, span<const T>> as_spans() const{
+                size_type first_run = capacity_ - head_ < size_ ? capacity_ - head_ : size_;
+                return { span<const T>{block + head_, first_run}, span<const T>{block, size_ - first_run} };
+            }
+
+        //=== Getting an iterator
+            /// Returns an iterator pointing to the first item in the ring
+            iterator begin(){
+                return iterator(block, capacity_, head_, 0);
+            }
+
+            /// Returns an iterator pointing to the end mark in the ring
+            iterator end(){
+                return iterator(block, capacity_, head_, size_);
+            }
+
+            /// Returns a constant iterator pointing to the first item in the ring.
+            const_iterator begin() const{
+                return cbegin();
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the ring.
+            const_iterator end() const{
+                return cend();
+            }
+
+            /// Returns a constant iterator pointing to the first item in the ring.
+            const_iterator cbegin() const{
+                return const_iterator(block, capacity_, head_, 0);
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the ring
+            const_iterator cend() const{
+                return const_iterator(block, capacity_, head_, size_);
+            }
+
+            /// Exchanges the contents (block, elements and mode) of the ring with those of other.
+            void swap(ring_vector& other) noexcept{
+                std::swap(block, other.block);
+                std::swap(capacity_, other.capacity_);
+                std::swap(head_, other.head_);
+                std::swap(size_, other.size_);
+                std::swap(overwrite_, other.overwrite_);
+            }
+
+            friend std::ostream& operator<<(std::ostream& os, const ring_vector& v){
+                os << "[ ";
+                for(size_type i = 0; i < v.size_; i++){
+                    os << v[i] << " ";
+                }
+                os << "]";
+                return os;
+            }
+    };
+
+    //=== Operator overloading — non-member functions
+        /// Checks if the contents (in logical order) of lhs and rhs are equal.
+        template <typename T>
+        bool operator==(const sc::ring_vector<T>& lhs, const sc::ring_vector<T>& rhs){
+            if(lhs.size() != rhs.size()) return false;
+            for(size_t i = 0; i < lhs.size(); i++){
+                if(lhs[i] != rhs[i])
+                    return false;
+            }
+            return true;
+        }
+
+        /// Similar to the previous operator, but the opposite result.
+        template <typename T>
+        bool operator!=(const sc::ring_vector<T>& lhs, const sc::ring_vector<T>& rhs){
+            return !(lhs == rhs);
+        }
+
+        /// Exchanges the contents of lhs and rhs.
+        template <typename T>
+        void swap(sc::ring_vector<T>& lhs, sc::ring_vector<T>& rhs) noexcept{
+            lhs.swap(rhs);
+        }
+}
+
+#endif
@@ -0,0 +1,504 @@
+/*!
+ * \file serialize.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "vector.h"
+
+/*! Versioned binary format for sc::vector.
+ *
+ * A file is a 64-byte header followed by the payload:
+ *
+ *     offset  size  field
+ *          0     4  magic "SCVB"
+ *          4     2  format version (1)
+ *          6     2  byte order mark: 0x0102 in the writer's byte order
+ *          8     4  element size: sizeof(T), or 0 for variable-size elements
+ *         12     4  flags (reserved, 0)
+ *         16     8  element count
+ *         24     8  payload checksum (XXH64, seed 0)
+ *         32     8  payload size in bytes
+ *         40    24  reserved, 0
+ *
+ * Trivially copyable elements are stored as their bytes, so save() writes the vector
+ * in one call and load() reads straight into it: the cost is the checksum (several GB/s)
+ * plus the I/O. The payload starts 64 bytes in, so view() can use a mapped file in place.
+ * Arithmetic elements written on a machine with the other byte order are swapped on load.
+ *
+ * Other element types need a specialization of sc::serializer (one is provided for
+ * std::string); their payload is built in memory, then written in one go.
+ *
+ * load() does not trust the header's sizes: it checks them against the bytes left in a
+ * regular file or a seekable stream before allocating, and on pipes and other streams it
+ * grows the vector as the payload arrives, so truncated or hostile input fails with a
+ * serial_error instead of a huge allocation.
+ *
+ * Malformed input throws sc::serial_error; failed system calls throw std::system_error.
+ */
+namespace sc{ // sc: Sequence container
+    /// Thrown when serialized data is malformed, truncated or does not match the element type.
+    class serial_error : public std::runtime_error{
+        public:
+            using std::runtime_error::runtime_error;
+    };
+
+    /// Header of the serialized format; see serialize.h for the layout.
+    struct serial_header{
+        char magic[4]; //!< "SCVB".
+        std::uint16_t version; //!< Format version.
+        std::uint16_t byte_order; //!< 0x0102 as the writer stored it.
+        std::uint32_t element_size; //!< sizeof(T), or 0 for variable-size elements.
+        std::uint32_t flags; //!< Reserved, 0.
+        std::uint64_t count; //!< Number of elements.
+        std::uint64_t checksum; //!< XXH64 of the payload.
+        std::uint64_t payload_bytes; //!< Bytes after the header.
+        unsigned char reserved[24]; //!< Reserved, 0.
+
+        static constexpr std::uint16_t current_version = 1; //!< Version written by save().
+        static constexpr std::uint16_t native_order = 0x0102; //!< Byte order mark as this machine stores it.
+    };
+    static_assert(sizeof(serial_header) == 64, "serial_header must be 64 bytes");
+
+    /// Appends the bytes of variable-size elements to a payload.
+    class serial_writer{
+        private:
+            vector<unsigned char> &bytes; //!< The payload.
+        public:
+            /// Constructor
+            explicit serial_writer(vector<unsigned char> &out) : bytes(out){ }
+
+            /// Appends n raw bytes.
+            void write(const void *data, std::size_t n){
+                const unsigned char *p = static_cast<const unsigned char*>(data);
+                bytes.append_range(p, p + n);
+            }
+
+            /// Appends the bytes of a trivially copyable value.
+            template <typename T>
+            void write_value(const T &value){
+                static_assert(std::is_trivially_copyable<T>::value, "write_value needs a trivially copyable type");
+                write(&value, sizeof value);
+            }
+    };
+
+    /// Reads the bytes of variable-size elements from a payload. Throws serial_error past its end.
+    class serial_reader{
+        private:
+            const unsigned char *next; //!< Next byte to read.
+            const unsigned char *last; //!< End of the payload.
+        public:
+            /// Constructor
+            serial_reader(const void *data, std::size_t n)
+                : next{static_cast<const unsigned char*>(data)}, last{static_cast<const unsigned char*>(data) + n}{ }
+
+            /// Copies the next n bytes to out.
+            void read(void *out, std::size_t n){
+                if(std::size_t(last - next) < n) throw serial_error("Truncated payload.");
+                if(n > 0) std::memcpy(out, next, n);
+                next += n;
+            }
+
+            /// Reads a trivially copyable value.
+            template <typename T>
+            T read_value(){
+                static_assert(std::is_trivially_copyable<T>::value, "read_value needs a trivially copyable type");
+                T value;
+                read(&value, sizeof value);
+                return value;
+            }
+
+            /// Returns true once every byte has been read.
+            bool done() const{
+                return next == last;
+            }
+    };
+
+    /// Writes and reads one element of a type that is not trivially copyable. Specialize it for your types.
+    /*! A specialization provides
+     *
+     *     static void write(serial_writer &out, const T &value);
+     *     static T read(serial_reader &in);
+     */
+    template <typename T>
+    struct serializer;
+
+    /// Strings: a 64-bit length, then the characters.
+    template <typename CharT, typename Traits, typename Alloc>
+    struct serializer<std::basic_string<CharT, Traits, Alloc>>{
+        static void write(serial_writer &out, const std::basic_string<CharT, Traits, Alloc> &value){
+            out.write_value(std::uint64_t(value.size()));
+            out.write(value.data(), value.size() * sizeof(CharT));
+        }
+
+        static std::basic_string<CharT, Traits, Alloc> read(serial_reader &in){
+            std::basic_string<CharT, Traits, Alloc> value;
+            value.resize(in.read_value<std::uint64_t>());
+            in.read(&value[0], value.size() * sizeof(CharT));
+            return value;
+        }
+    };
+
+    namespace detail{
+        /// XXH64 of n bytes, seed 0. Reads words in little-endian order on any machine.
+        inline std::uint64_t xxh64(const void *data, std::size_t n){
+            constexpr std::uint64_t p1 = 11400714785074694791ull, p2 = 14029467366897019727ull,
+                                    p3 = 1609587929392839161ull, p4 = 9650029242287828579ull,
+                                    p5 = 2870177450012600261ull;
+            auto rotl = [](std::uint64_t x, int r){ return (x << r) | (x >> (64 - r)); };
+            auto load64 = [](const unsigned char *p){
+                std::uint64_t v;
+                std::memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                v = __builtin_bswap64(v);
+#endif
+                return v;
+            };
+            auto load32 = [](const unsigned char *p){
+                std::uint32_t v;
+                std::memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                v = __builtin_bswap32(v);
+#endif
+                return std::uint64_t(v);
+            };
+            auto round = [&](std::uint64_t acc, std::uint64_t input){
+                acc += input * p2;
+                return rotl(acc, 31) * p1;
+            };
+            const unsigned char *p = static_cast<const unsigned char*>(data);
+            const unsigned char *end = p + n;
+            std::uint64_t h;
+            if(n >= 32){
+                std::uint64_t v1 = p1 + p2, v2 = p2, v3 = 0, v4 = 0 - p1;
+                for(; end - p >= 32; p += 32){
+                    v1 = round(v1, load64(p));
+                    v2 = round(v2, load64(p + 8));
+                    v3 = round(v3, load64(p + 16));
+                    v4 = round(v4, load64(p + 24));
+                }
+                h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+                for(std::uint64_t v : { v1, v2, v3, v4 }){
+                    h ^= round(0, v);
+                    h = h * p1 + p4;
+                }
+            }
+            else{
+                h = p5;
+            }
+            h += n;
+            for(; end - p >= 8; p += 8){
+                h ^= round(0, load64(p));
+                h = rotl(h, 27) * p1 + p4;
+            }
+            if(end - p >= 4){
+                h ^= load32(p) * p1;
+                h = rotl(h, 23) * p2 + p3;
+                p += 4;
+            }
+            for(; p < end; p++){
+                h ^= *p * p5;
+                h = rotl(h, 11) * p1;
+            }
+            h ^= h >> 33;
+            h *= p2;
+            h ^= h >> 29;
+            h *= p3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        /// Reverses the bytes of every element of an arithmetic array.
+        template <typename T>
+        void byte_swap(T *data, std::size_t n){
+            for(std::size_t i = 0; i < n; i++){
+                unsigned char *b = reinterpret_cast<unsigned char*>(data + i);
+                for(std::size_t lo = 0, hi = sizeof(T) - 1; lo < hi; lo++, hi--){
+                    std::swap(b[lo], b[hi]);
+                }
+            }
+        }
+
+        /// Byte-swaps the multi-byte fields of a header written with the other byte order.
+        inline void byte_swap(serial_header &h){
+            byte_swap(&h.version, 1);
+            byte_swap(&h.element_size, 1);
+            byte_swap(&h.flags, 1);
+            byte_swap(&h.count, 1);
+            byte_swap(&h.checksum, 1);
+            byte_swap(&h.payload_bytes, 1);
+        }
+
+        /// Size stored in the header for elements of type T: 0 if they are variable-size.
+        template <typename T>
+        constexpr std::uint32_t element_size(){
+            return std::is_trivially_copyable<T>::value ? std::uint32_t(sizeof(T)) : 0;
+        }
+
+        /// Returns a header for count elements of T and the given payload.
+        template <typename T>
+        serial_header make_header(std::uint64_t count, const void *payload, std::uint64_t bytes){
+            serial_header h{};
+            std::memcpy(h.magic, "SCVB", 4);
+            h.version = serial_header::current_version;
+            h.byte_order = serial_header::native_order;
+            h.element_size = element_size<T>();
+            h.count = count;
+            h.checksum = xxh64(payload, bytes);
+            h.payload_bytes = bytes;
+            return h;
+        }
+
+        /// Validates a header read for elements of T; returns true if it was written with the other byte order.
+        /*! Swapped headers are converted in place. Throws serial_error if the header does not fit T. */
+        template <typename T>
+        bool check_header(serial_header &h){
+            if(std::memcmp(h.magic, "SCVB", 4) != 0) throw serial_error("Not an sc::vector file.");
+            bool swapped = h.byte_order != serial_header::native_order;
+            if(swapped){
+                byte_swap(&h.byte_order, 1);
+                if(h.byte_order != serial_header::native_order) throw serial_error("Invalid byte order mark.");
+                byte_swap(h);
+                if(!std::is_arithmetic<T>::value){
+                    throw serial_error("Only arithmetic elements can be read with the other byte order.");
+                }
+            }
+            if(h.version > serial_header::current_version) throw serial_error("Unsupported format version.");
+            if(h.element_size != element_size<T>()) throw serial_error("Element size does not match the vector type.");
+            //count is checked against the payload first, so count * element_size cannot wrap around
+            if(h.element_size != 0 && (h.count > h.payload_bytes / h.element_size
+                                       || h.payload_bytes != h.count * h.element_size)){
+                throw serial_error("Payload size does not match the element count.");
+            }
+            return swapped;
+        }
+
+        /// Writes all n bytes to a file descriptor.
+        inline void write_all(int fd, const void *data, std::size_t n){
+            const char *p = static_cast<const char*>(data);
+            while(n > 0){
+                ssize_t done = ::write(fd, p, n < (1ul << 30) ? n : (1ul << 30));
+                if(done < 0){
+                    if(errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), "write");
+                }
+                p += done;
+                n -= std::size_t(done);
+            }
+        }
+
+        /// Reads exactly n bytes from a file descriptor. Throws serial_error at end of file.
+        inline void read_all(int fd, void *data, std::size_t n){
+            char *p = static_cast<char*>(data);
+            while(n > 0){
+                ssize_t done = ::read(fd, p, n < (1ul << 30) ? n : (1ul << 30));
+                if(done < 0){
+                    if(errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), "read");
+                }
+                if(done == 0) throw serial_error("Unexpected end of file.");
+                p += done;
+                n -= std::size_t(done);
+            }
+        }
+
+        /// bytes_left() result for a source that cannot tell how much it holds.
+        constexpr std::uint64_t unknown_size = ~std::uint64_t(0);
+
+        /// Bytes between the position of fd and the end of the file, or unknown_size if fd is not a regular file.
+        inline std::uint64_t bytes_left(int fd){
+            struct stat st;
+            off_t pos = ::lseek(fd, 0, SEEK_CUR);
+            if(pos < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) return unknown_size;
+            return st.st_size > pos ? std::uint64_t(st.st_size - pos) : 0;
+        }
+
+        /// Characters between the position of is and its end, or unknown_size if is cannot seek.
+        inline std::uint64_t bytes_left(std::istream &is){
+            std::istream::pos_type pos = is.tellg();
+            if(pos == std::istream::pos_type(-1)) return unknown_size;
+            is.seekg(0, std::ios::end);
+            std::istream::pos_type end = is.tellg();
+            is.clear();
+            is.seekg(pos);
+            if(end == std::istream::pos_type(-1) || !is) return unknown_size;
+            return end > pos ? std::uint64_t(end - pos) : 0;
+        }
+
+        /// Reads count elements of U into the empty vector out through get(data, bytes).
+        /*! available is what the source has left (or unknown_size): count comes from the header,
+         * so it is checked against it before anything is allocated. When the size is unknown, out
+         * grows as the data arrives, to at most twice what was read plus one 16 MB chunk.
+         */
+        template <typename U, typename Allocator, typename Growth, typename Get>
+        void read_elements(vector<U, Allocator, Growth> &out, std::uint64_t count, std::uint64_t available, Get get){
+            if(count > available / sizeof(U)) throw serial_error("Truncated payload.");
+            constexpr std::uint64_t chunk = (16u << 20) / sizeof(U) > 0 ? (16u << 20) / sizeof(U) : 1;
+            std::uint64_t done = 0;
+            while(done < count){
+                std::uint64_t step = available != unknown_size ? count - done : (done > chunk ? done : chunk);
+                std::uint64_t next = count - done < step ? count : done + step;
+                out.resize_for_overwrite(next);
+                get(out.data() + done, (next - done) * sizeof(U));
+                done = next;
+            }
+        }
+
+        /// Writes v through put(data, bytes), the bulk path for trivially copyable elements.
+        template <typename T, typename Allocator, typename Growth, typename Put>
+        void save(const vector<T, Allocator, Growth> &v, Put put){
+            if constexpr(std::is_trivially_copyable<T>::value){
+                std::uint64_t bytes = std::uint64_t(v.size()) * sizeof(T);
+                serial_header h = make_header<T>(v.size(), v.data(), bytes);
+                put(&h, sizeof h);
+                put(v.data(), bytes);
+            }
+            else{
+                vector<unsigned char> payload;
+                serial_writer out(payload);
+                for(const T &value : v){
+                    serializer<T>::write(out, value);
+                }
+                serial_header h = make_header<T>(v.size(), payload.data(), payload.size());
+                put(&h, sizeof h);
+                put(payload.data(), payload.size());
+            }
+        }
+
+        /// Replaces the contents of v with the data read through get(data, bytes); left() is what the source has left.
+        template <typename T, typename Allocator, typename Growth, typename Get, typename Left>
+        void load(vector<T, Allocator, Growth> &v, Get get, Left left){
+            serial_header h;
+            get(&h, sizeof h);
+            bool swapped = check_header<T>(h);
+            std::uint64_t available = left();
+            if constexpr(std::is_trivially_copyable<T>::value){
+                vector<T, Allocator, Growth> fresh(v.get_allocator());
+                read_elements(fresh, h.count, available, get);
+                if(xxh64(fresh.data(), h.payload_bytes) != h.checksum) throw serial_error("Checksum mismatch.");
+                if constexpr(std::is_arithmetic<T>::value){
+                    if(swapped) byte_swap(fresh.data(), fresh.size());
+                }
+                v.swap(fresh);
+            }
+            else{
+                (void)swapped;
+                vector<unsigned char> payload;
+                read_elements(payload, h.payload_bytes, available, get);
+                if(xxh64(payload.data(), payload.size()) != h.checksum) throw serial_error("Checksum mismatch.");
+                serial_reader in(payload.data(), payload.size());
+                vector<T, Allocator, Growth> fresh(v.get_allocator());
+                fresh.reserve(h.count < h.payload_bytes ? h.count : h.payload_bytes); //count is not trusted yet
+                for(std::uint64_t i = 0; i < h.count; i++){
+                    fresh.push_back(serializer<T>::read(in));
+                }
+                if(!in.done()) throw serial_error("Trailing bytes after the last element.");
+                v.swap(fresh);
+            }
+        }
+    }
+
+    /// Writes v to the file descriptor fd in the binary format.
+    template <typename T, typename Allocator, typename Growth>
+    void save(const vector<T, Allocator, Growth> &v, int fd){
+        detail::save(v, [fd](const void *data, std::size_t n){ detail::write_all(fd, data, n); });
+    }
+
+    /// Writes v to os in the binary format. Throws serial_error if the stream fails.
+    template <typename T, typename Allocator, typename Growth>
+    void save(const vector<T, Allocator, Growth> &v, std::ostream &os){
+        detail::save(v, [&os](const void *data, std::size_t n){
+            if(!os.write(static_cast<const char*>(data), std::streamsize(n))) throw serial_error("Stream write failed.");
+        });
+    }
+
+    /// Replaces the contents of v with a vector read from the file descriptor fd. v is unchanged if it throws.
+    template <typename T, typename Allocator, typename Growth>
+    void load(vector<T, Allocator, Growth> &v, int fd){
+        detail::load(v, [fd](void *data, std::size_t n){ detail::read_all(fd, data, n); },
+                     [fd]{ return detail::bytes_left(fd); });
+    }
+
+    /// Replaces the contents of v with a vector read from is. v is unchanged if it throws.
+    template <typename T, typename Allocator, typename Growth>
+    void load(vector<T, Allocator, Growth> &v, std::istream &is){
+        detail::load(v, [&is](void *data, std::size_t n){
+            if(!is.read(static_cast<char*>(data), std::streamsize(n))) throw serial_error("Unexpected end of stream.");
+        }, [&is]{ return detail::bytes_left(is); });
+    }
+
+    /// Read-only vector over serialized elements that stay where they are (e.g. in a mapped file).
+    template <typename T>
+    class vector_view{
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+            using const_iterator = typename vector<T>::const_iterator; //!< Same iterators as sc::vector.
+            using iterator = const_iterator; //!< The view cannot change the elements.
+
+        //=== Private data
+        private:
+            const T *data_; //!< First element.
+            size_type size_; //!< Number of elements.
+
+        //=== Public interface
+        public:
+            /// Constructor
+            vector_view(const T *data = nullptr, size_type size = 0) : data_{data}, size_{size}{ }
+
+            size_type size() const{ return size_; }
+            bool empty() const{ return size_ == 0; }
+            const T* data() const{ return data_; }
+            const_reference operator[](size_type pos) const{ return data_[pos]; }
+            const_reference front() const{ return data_[0]; }
+            const_reference back() const{ return data_[size_-1]; }
+
+            /// Returns the element at pos. Throws std::out_of_range if pos >= size().
+            const_reference at(size_type pos) const{
+                if(pos >= size_) throw std::out_of_range("Index out of range.");
+                return data_[pos];
+            }
+
+            const_iterator begin() const{ return const_iterator(data_); }
+            const_iterator end() const{ return const_iterator(data_ + size_); }
+            const_iterator cbegin() const{ return begin(); }
+            const_iterator cend() const{ return end(); }
+    };
+
+    /// Returns a view of the vector serialized at buffer (bytes long), without copying it.
+    /*! The buffer must hold a vector of trivially copyable T written with this machine's byte
+     * order, and buffer + 64 must be aligned for T (a mapped file always is). The checksum is
+     * only verified with verify, since that reads every page of the payload.
+     */
+    template <typename T>
+    vector_view<T> view(const void *buffer, std::size_t bytes, bool verify = false){
+        static_assert(std::is_trivially_copyable<T>::value, "view needs trivially copyable elements");
+        if(bytes < sizeof(serial_header)) throw serial_error("Buffer smaller than the header.");
+        serial_header h;
+        std::memcpy(&h, buffer, sizeof h);
+        if(detail::check_header<T>(h)) throw serial_error("A view cannot convert the byte order.");
+        if(h.payload_bytes > bytes - sizeof h) throw serial_error("Truncated payload.");
+        const unsigned char *payload = static_cast<const unsigned char*>(buffer) + sizeof h;
+        if(reinterpret_cast<std::uintptr_t>(payload) % alignof(T) != 0) throw serial_error("Payload misaligned for the element type.");
+        if(verify && detail::xxh64(payload, h.payload_bytes) != h.checksum) throw serial_error("Checksum mismatch.");
+        return vector_view<T>(reinterpret_cast<const T*>(payload), h.count);
+    }
+}
+
+#endif
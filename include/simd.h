@@ -0,0 +1,168 @@
+/*!
+ * \file simd.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__SSE2__)) && defined(__GNUC__)
+#define SC_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/*! Vector kernels shared by the containers, with runtime dispatch.
+ *
+ * On x86 with GCC or Clang each kernel has an AVX2 version, compiled with a target
+ * attribute so the rest of the program needs no -mavx2, and an SSE2 version (always
+ * available on x86-64). The AVX2 one is picked on the first call if the CPU supports it.
+ * Elsewhere the kernels fall back to portable scalar code.
+ */
+namespace sc{ // sc: Sequence container
+    namespace simd{
+        /// Returns true if the CPU running the program supports AVX2.
+        inline bool has_avx2(){
+#ifdef SC_SIMD_X86
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+#else
+            return false;
+#endif
+        }
+
+        namespace detail{
+            /// Portable version of mismatch_bytes(): memcmp on 64-byte chunks, then bytes.
+            inline std::size_t mismatch_bytes_scalar(const unsigned char *a, const unsigned char *b, std::size_t n){
+                std::size_t i = 0;
+                while(i + 64 <= n && std::memcmp(a+i, b+i, 64) == 0) i += 64;
+                while(i < n && a[i] == b[i]) i++;
+                return i;
+            }
+
+#ifdef SC_SIMD_X86
+            /// SSE2 version of mismatch_bytes(): 16 bytes per step.
+            inline std::size_t mismatch_bytes_sse2(const unsigned char *a, const unsigned char *b, std::size_t n){
+                std::size_t i = 0;
+                for(; i + 16 <= n; i += 16){
+                    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a+i));
+                    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b+i));
+                    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+                    if(mask != 0xFFFF) return i + __builtin_ctz(~mask);
+                }
+                while(i < n && a[i] == b[i]) i++;
+                return i;
+            }
+
+            /// AVX2 version of mismatch_bytes(): 64 bytes per step, 32 in the last ones.
+            __attribute__((target("avx2")))
+            inline std::size_t mismatch_bytes_avx2(const unsigned char *a, const unsigned char *b, std::size_t n){
+                std::size_t i = 0;
+                for(; i + 64 <= n; i += 64){
+                    __m256i eq0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i)),
+                                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i)));
+                    __m256i eq1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i+32)),
+                                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i+32)));
+                    if(unsigned(_mm256_movemask_epi8(_mm256_and_si256(eq0, eq1))) != 0xFFFFFFFFu){
+                        unsigned mask = _mm256_movemask_epi8(eq0);
+                        if(mask != 0xFFFFFFFFu) return i + __builtin_ctz(~mask);
+                        return i + 32 + __builtin_ctz(~unsigned(_mm256_movemask_epi8(eq1)));
+                    }
+                }
+                for(; i + 32 <= n; i += 32){
+                    unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i)),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i))));
+                    if(mask != 0xFFFFFFFFu) return i + __builtin_ctz(~mask);
+                }
+                return i + mismatch_bytes_sse2(a+i, b+i, n-i);
+            }
+#endif
+
+            /// True for the bytes that end a field: the separator and whitespace.
+            inline bool is_field_delimiter(unsigned char c, unsigned char separator){
+                return c == separator || c == ' ' || c == '\n' || c == '\t' || c == '\r';
+            }
+
+            /// Portable version of count_fields(). after_delimiter says whether the byte before p was a delimiter.
+            inline std::size_t count_fields_scalar(const unsigned char *p, std::size_t n, unsigned char separator,
+                                                   bool after_delimiter = true){
+                std::size_t count = 0;
+                for(std::size_t i = 0; i < n; i++){
+                    bool delimiter = is_field_delimiter(p[i], separator);
+                    count += after_delimiter && !delimiter;
+                    after_delimiter = delimiter;
+                }
+                return count;
+            }
+
+#ifdef SC_SIMD_X86
+            /// SSE2 version of count_fields(): a delimiter bit mask per 16 bytes, field starts are the 0 bits after a 1 bit.
+            inline std::size_t count_fields_sse2(const unsigned char *p, std::size_t n, unsigned char separator){
+                const __m128i sep = _mm_set1_epi8(char(separator)), space = _mm_set1_epi8(' '),
+                              newline = _mm_set1_epi8('\n'), tab = _mm_set1_epi8('\t'), cr = _mm_set1_epi8('\r');
+                std::size_t count = 0, i = 0;
+                unsigned carry = 1; //the start of the text counts as a delimiter
+                for(; i + 16 <= n; i += 16){
+                    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p+i));
+                    __m128i d = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sep), _mm_cmpeq_epi8(x, space)),
+                                             _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, newline), _mm_cmpeq_epi8(x, tab)),
+                                                          _mm_cmpeq_epi8(x, cr)));
+                    unsigned mask = unsigned(_mm_movemask_epi8(d));
+                    count += __builtin_popcount(~mask & ((mask << 1) | carry) & 0xFFFFu);
+                    carry = mask >> 15;
+                }
+                return count + count_fields_scalar(p+i, n-i, separator, carry != 0);
+            }
+
+            /// AVX2 version of count_fields(): 32 bytes per step.
+            __attribute__((target("avx2,popcnt")))
+            inline std::size_t count_fields_avx2(const unsigned char *p, std::size_t n, unsigned char separator){
+                const __m256i sep = _mm256_set1_epi8(char(separator)), space = _mm256_set1_epi8(' '),
+                              newline = _mm256_set1_epi8('\n'), tab = _mm256_set1_epi8('\t'), cr = _mm256_set1_epi8('\r');
+                std::size_t count = 0, i = 0;
+                unsigned carry = 1;
+                for(; i + 32 <= n; i += 32){
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p+i));
+                    __m256i d = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sep), _mm256_cmpeq_epi8(x, space)),
+                                                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, newline),
+                                                                                _mm256_cmpeq_epi8(x, tab)),
+                                                                _mm256_cmpeq_epi8(x, cr)));
+                    unsigned mask = unsigned(_mm256_movemask_epi8(d));
+                    count += __builtin_popcount(~mask & ((mask << 1) | carry));
+                    carry = mask >> 31;
+                }
+                return count + count_fields_scalar(p+i, n-i, separator, carry != 0);
+            }
+#endif
+        }
+
+        /// Returns the offset of the first byte that differs between a and b, or n if the n bytes are equal.
+        inline std::size_t mismatch_bytes(const void *a, const void *b, std::size_t n){
+            const unsigned char *x = static_cast<const unsigned char*>(a);
+            const unsigned char *y = static_cast<const unsigned char*>(b);
+#ifdef SC_SIMD_X86
+            if(has_avx2()) return detail::mismatch_bytes_avx2(x, y, n);
+            return detail::mismatch_bytes_sse2(x, y, n);
+#else
+            return detail::mismatch_bytes_scalar(x, y, n);
+#endif
+        }
+
+        /// Returns the number of fields in n bytes of delimited text: the runs of bytes other than separator and whitespace.
+        inline std::size_t count_fields(const char *text, std::size_t n, char separator){
+            const unsigned char *p = reinterpret_cast<const unsigned char*>(text);
+#ifdef SC_SIMD_X86
+            if(has_avx2()) return detail::count_fields_avx2(p, n, static_cast<unsigned char>(separator));
+            return detail::count_fields_sse2(p, n, static_cast<unsigned char>(separator));
+#else
+            return detail::count_fields_scalar(p, n, static_cast<unsigned char>(separator));
+#endif
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,700 @@
+/*!
+ * \file small_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "vector.h"
+
+namespace sc{ // sc: Sequence container
+    /// sc::vector with room for N elements inside the object itself.
+    /*! Up to N elements live in an inline buffer, so small lists never touch the heap;
+     * past that the elements spill to heap storage obtained from std::allocator, and the
+     * heap block grows as Growth (see growth_policy.h) decides, as in sc::vector. Heap
+     * storage changes hands in O(1) when converting to and from sc::vector<T>; inline
+     * elements (at most N) are moved one by one.
+     *
+     * It has the element access, iterator, insertion, erasure, resize() and append_range()
+     * members of sc::vector, and the same comparison operators. It has no allocator
+     * parameter and none of the storage hooks of sc::vector (expand, reallocate, pmr).
+     */
+    template <typename T, std::size_t N, typename Growth = growth::doubling>
+    class small_vector{
+        static_assert(N > 0, "small_vector needs room for at least one inline element");
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using pointer = value_type*; //!< Pointer to a value stored in the container.
+            using reference = value_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+            using growth_policy = Growth; //!< The growth policy type.
+            using iterator = typename vector<T>::iterator; //!< Same iterators as sc::vector.
+            using const_iterator = typename vector<T>::const_iterator; //!< Same iterators as sc::vector.
+            using reverse_iterator = typename vector<T>::reverse_iterator; //!< Same iterators as sc::vector.
+            using const_reverse_iterator = typename vector<T>::const_reverse_iterator; //!< Same iterators as sc::vector.
+            static constexpr size_type inline_capacity = N; //!< Elements that fit without a heap allocation.
+
+        //=== Private data
+        private:
+            T *data_; //!< Storage area: the inline buffer or a heap block.
+            size_type size_; //!< Number of elements currently in the vector.
+            size_type capacity_; //!< Maximum current capacity (N while inline).
+            alignas(T) unsigned char buffer_[N * sizeof(T)]; //!< Inline storage for the first N elements.
+
+        //=== Raw storage helpers
+        private:
+            /// Returns the inline buffer.
+            T* inline_data(){
+                return reinterpret_cast<T*>(buffer_);
+            }
+
+            /// Returns uninitialized heap storage for `n` objects of T.
+            static T* allocate(size_type n){
+                return std::allocator<T>().allocate(n);
+            }
+
+            /// Releases the heap block, if the elements live in one. The objects in it must be already destroyed.
+            void release(){
+                if(!is_inline()) std::allocator<T>().deallocate(data_, capacity_);
+            }
+
+            /// Destroys the objects in [first, last) without releasing their storage.
+            static void destroy(T *first, T *last){
+                if constexpr(!std::is_trivially_destructible<T>::value){
+                    for(; first != last; first++){
+                        first->~T();
+                    }
+                }
+            }
+
+            /// Copy-constructs the objects in [first, last) into the uninitialized storage at dest.
+            static void copy_construct(const T *first, const T *last, T *dest){
+                if constexpr(std::is_trivially_copyable<T>::value){
+                    if(first != last) std::memcpy(dest, first, (last-first) * sizeof(T));
+                }
+                else{
+                    for(; first != last; first++, dest++){
+                        new (dest) T(*first);
+                    }
+                }
+            }
+
+            /// Moves the objects in [first, last) into the uninitialized storage at dest and destroys the originals.
+            /*! The ranges may overlap. Trivially relocatable types are moved with a single memmove. */
+            static void relocate(T *first, T *last, T *dest){
+                if constexpr(is_trivially_relocatable<T>::value){
+                    if(first != last) std::memmove(static_cast<void*>(dest), first, (last-first) * sizeof(T));
+                }
+                else if(dest <= first){
+                    for(; first != last; first++, dest++){
+                        new (dest) T(std::move_if_noexcept(*first));
+                        first->~T();
+                    }
+                }
+                else{ //overlapping shift to the right: walk backwards
+                    for(dest += last-first; last != first; ){
+                        last--; dest--;
+                        new (dest) T(std::move_if_noexcept(*last));
+                        last->~T();
+                    }
+                }
+            }
+
+            /// Opens `n` uninitialized slots at position pos by shifting the tail to the right. Capacity must suffice.
+            void open_gap(size_type pos, size_type n){
+                relocate(&data_[pos], &data_[size_], &data_[pos+n]);
+            }
+
+            /// Destroys the elements in [first, last) and shifts the tail to the left to close the gap.
+            void close_gap(size_type first, size_type last){
+                destroy(&data_[first], &data_[last]);
+                relocate(&data_[last], &data_[size_], &data_[first]);
+                size_ -= last - first;
+            }
+
+        //=== Growth engine (same contract as sc::vector's)
+            /// Returns the capacity to grow to so that at least `min_cap` elements fit.
+            size_type next_capacity(size_type min_cap) const{
+                size_type new_cap = Growth::next(capacity_, min_cap, sizeof(T));
+                return new_cap < min_cap ? min_cap : new_cap;
+            }
+
+            /// Relocates the elements into new_data, leaving `gap` slots before position `pos`, and releases the old block.
+            void adopt(T *new_data, size_type new_cap, size_type pos, size_type gap){
+                relocate(&data_[0], &data_[pos], &new_data[0]);
+                relocate(&data_[pos], &data_[size_], &new_data[pos+gap]);
+                release();
+                data_ = new_data;
+                capacity_ = new_cap;
+            }
+
+            /// Moves the elements into the inline buffer if they fit, or into a heap block of exactly `new_cap` elements.
+            void reallocate(size_type new_cap){
+                if(new_cap <= N){
+                    if(!is_inline()) adopt(inline_data(), N, size_, 0);
+                }
+                else{
+                    adopt(allocate(new_cap), new_cap, size_, 0);
+                }
+            }
+
+            /// Takes the elements of an sc::vector: its heap block if it outgrew N, one by one otherwise.
+            void take(vector<T> &other){
+                if(other.capacity_ > N){
+                    data_ = other.data_;
+                    size_ = other.size_;
+                    capacity_ = other.capacity_;
+                    other.data_ = nullptr;
+                    other.capacity_ = 0;
+                }
+                else{
+                    relocate(other.data_, other.data_+other.size_, data_);
+                    size_ = other.size_;
+                }
+                other.size_ = 0;
+            }
+
+            /// Takes the elements of another small_vector: its heap block, or its inline elements one by one.
+            void take(small_vector &other){
+                if(other.is_inline()){
+                    relocate(other.data_, other.data_+other.size_, data_);
+                    size_ = other.size_;
+                }
+                else{
+                    data_ = other.data_;
+                    size_ = other.size_;
+                    capacity_ = other.capacity_;
+                    other.data_ = other.inline_data();
+                    other.capacity_ = N;
+                }
+                other.size_ = 0;
+            }
+
+        //=== Public interface
+        public:
+        //=== Constructors, Destructors, and Assignment.
+            /// Default constructor that creates an empty list. Never allocates.
+            small_vector() : data_{inline_data()}, size_{0}, capacity_{N}{
+                /*empty*/
+            }
+
+            /// Constructs an empty list with room for at least count elements.
+            explicit small_vector(size_type count) : small_vector(){
+                reserve(count);
+            }
+
+            /// Constructs the list with the contents of the range [first, last).
+            template <typename InputIt>
+            small_vector(InputIt first, InputIt last) : small_vector(){
+                insert(end(), first, last);
+            }
+
+            /// Copy constructor. Constructs the list with the deep copy of the contents of other.
+            small_vector(const small_vector& other) : small_vector(){
+                reserve(other.size_);
+                copy_construct(other.data_, other.data_+other.size_, data_);
+                size_ = other.size_;
+            }
+
+            /// Move constructor. Takes over the heap block of other, or moves its inline elements.
+            small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : small_vector(){
+                take(other);
+            }
+
+            /// Constructs the list with the contents of the initializer list init.
+            small_vector(std::initializer_list<T> ilist) : small_vector(){
+                reserve(ilist.size());
+                copy_construct(ilist.begin(), ilist.end(), data_);
+                size_ = ilist.size();
+            }
+
+            /// Copies the contents of an sc::vector.
+            explicit small_vector(const vector<T>& other) : small_vector(){
+                reserve(other.size_);
+                copy_construct(other.data_, other.data_+other.size_, data_);
+                size_ = other.size_;
+            }
+
+            /// Takes over the contents of an sc::vector, which is left empty. O(1) if it outgrew N.
+            small_vector(vector<T>&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : small_vector(){
+                take(other);
+            }
+
+            /// Destructs the list.
+            ~small_vector(){
+                destroy(data_, data_+size_);
+                release();
+            }
+
+            /// Copy assignment operator. Replaces the contents with a copy of the contents of other.
+            small_vector& operator=(const small_vector& other){
+                if(this == &other) return *this;
+                clear();
+                reserve(other.size_);
+                copy_construct(other.data_, other.data_+other.size_, data_);
+                size_ = other.size_;
+                return *this;
+            }
+
+            /// Move assignment operator. Replaces the contents with those of other, which is left empty.
+            small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value){
+                if(this == &other) return *this;
+                clear();
+                release();
+                data_ = inline_data();
+                capacity_ = N;
+                take(other);
+                return *this;
+            }
+
+            /// Replaces the contents with those identified by initializer list ilist
+            small_vector& operator=(std::initializer_list<T> ilist){
+                clear();
+                reserve(ilist.size());
+                copy_construct(ilist.begin(), ilist.end(), data_);
+                size_ = ilist.size();
+                return *this;
+            }
+
+            /// Moves the contents into an sc::vector. The heap block changes hands in O(1); inline elements are moved.
+            operator vector<T>() &&{
+                vector<T> result;
+                if(is_inline()){
+                    result.reserve(size_);
+                    relocate(data_, data_+size_, result.data_);
+                    result.size_ = size_;
+                }
+                else{
+                    result.data_ = data_;
+                    result.size_ = size_;
+                    result.capacity_ = capacity_;
+                    data_ = inline_data();
+                    capacity_ = N;
+                }
+                size_ = 0;
+                return result;
+            }
+
+            /// Copies the contents into an sc::vector.
+            operator vector<T>() const &{
+                return vector<T>(data_, data_+size_);
+            }
+
+        //=== Common operations to all list implementations
+            /// Return the number of elements in the container.
+            size_type size() const{
+                return size_;
+            }
+
+            /// Remove (either logically or physically) all elements from the container.
+            void clear(){
+                destroy(data_, data_+size_);
+                size_ = 0;
+            }
+
+            /// Returns true if the container contains no elements, and false otherwise.
+            bool empty() const{
+                return size_ == 0;
+            }
+
+            /// Returns true while the elements live in the inline buffer.
+            bool is_inline() const{
+                return data_ == reinterpret_cast<const T*>(buffer_);
+            }
+
+            /// Adds value to the front of the list.
+            void push_front(const T &value){
+                insert(begin(), value);
+            }
+
+            /// Moves value to the front of the list.
+            void push_front(T &&value){
+                insert(begin(), std::move(value));
+            }
+
+            /// Adds value to the end of the list.
+            void push_back(const T &value){
+                emplace_back(value);
+            }
+
+            /// Moves value to the end of the list.
+            void push_back(T &&value){
+                emplace_back(std::move(value));
+            }
+
+            /// Constructs a new element at the end of the list from args, in place.
+            template <typename... Args>
+            T& emplace_back(Args&&... args){
+                if(size_ < capacity_){
+                    new (&data_[size_]) T(std::forward<Args>(args)...);
+                }
+                else{
+                    size_type new_cap = next_capacity(size_+1);
+                    T *new_data = allocate(new_cap);
+                    new (&new_data[size_]) T(std::forward<Args>(args)...); //args may live in the old buffer
+                    adopt(new_data, new_cap, size_, 0);
+                }
+                size_ += 1;
+                return data_[size_-1];
+            }
+
+            /// Removes the object at the end of the list.
+            void pop_back(){
+                if(size_ > 0){
+                    size_ -= 1;
+                    destroy(&data_[size_], &data_[size_+1]);
+                }
+            }
+
+            /// Removes the object at the front of the list.
+            void pop_front(){
+                if(size_ > 0){
+                    close_gap(0, 1);
+                }
+            }
+
+            /// Returns the object at the end of the list.
+            const T& back() const{
+                return data_[size_-1];
+            }
+
+            /// Returns the object at the end of the list.
+            T& back(){
+                return data_[size_-1];
+            }
+
+            /// Returns the object at the beginning of the list.
+            const T& front() const{
+                return data_[0];
+            }
+
+            /// Returns the object at the beginning of the list.
+            T& front(){
+                return data_[0];
+            }
+
+            /// Resizes the list to count elements. New elements are value-initialized (zeroed for trivial types).
+            void resize(size_type count){
+                if(count <= size_){
+                    destroy(&data_[count], &data_[size_]);
+                    size_ = count;
+                    return;
+                }
+                if(count > capacity_) reallocate(next_capacity(count));
+                for(; size_ < count; size_++){
+                    new (&data_[size_]) T();
+                }
+            }
+
+            /// Resizes the list to count elements. New elements are copies of value.
+            void resize(size_type count, const T& value){
+                if(count <= size_){
+                    destroy(&data_[count], &data_[size_]);
+                    size_ = count;
+                    return;
+                }
+                T item(value); //value may live in the block that is about to move
+                if(count > capacity_) reallocate(next_capacity(count));
+                for(; size_ < count; size_++){
+                    new (&data_[size_]) T(item);
+                }
+            }
+
+            /// Appends the elements of the range [first, last) to the end of the list.
+            /*! Forward ranges grow the list at most once; single-pass (input) ranges are appended one element at a time. */
+            template <typename InItr>
+            void append_range(InItr first, InItr last){
+                using category = typename std::iterator_traits<InItr>::iterator_category;
+                if constexpr(std::is_base_of<std::forward_iterator_tag, category>::value){
+                    insert(end(), first, last);
+                }
+                else{
+                    for(; first != last; first++){
+                        emplace_back(*first);
+                    }
+                }
+            }
+
+            /// Replaces the content of the list with count copies of value.
+            void assign(size_type count, const T& value){
+                clear();
+                reserve(count);
+                for(auto i(0u); i < count; i++){
+                    new (&data_[i]) T(value);
+                }
+                size_ = count;
+            }
+
+            /// Replaces the contents of the list with the elements from the initializer list ilist
+            void assign(std::initializer_list<T> ilist){
+                *this = ilist;
+            }
+
+        //=== Operations exclusive to dynamic array implementation
+            /// Returns the object at the index pos in the array, with no bounds-checking.
+            T & operator[](size_type pos){
+                return data_[pos];
+            }
+
+            /// Returns the object at the index pos in the array, with no bounds-checking.
+            const T & operator[](size_type pos) const{
+                return data_[pos];
+            }
+
+            /// Returns the object at the index pos in the array, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            T & at(size_type pos){
+                if(pos >= size_){
+                    throw std::out_of_range("[small_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return data_[pos];
+            }
+
+            /// Returns the object at the index pos in the array, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            const T & at(size_type pos) const{
+                if(pos >= size_){
+                    throw std::out_of_range("[small_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return data_[pos];
+            }
+
+            /// Return the internal storage capacity of the array.
+            size_type capacity() const{
+                return capacity_;
+            }
+
+            /// Increase the storage capacity of the array to the value `new_cap` if it is greater than the current capacity()
+            void reserve(size_type new_cap){
+                if(new_cap <= capacity_) return; //do nothing
+                reallocate(new_cap);
+            }
+
+            /// Releases unused heap capacity, moving the elements back inline if they fit.
+            void shrink_to_fit(){
+                if(is_inline() || size_ == capacity_) return;
+                reallocate(size_);
+            }
+
+        //=== Getting an iterator
+            /// Returns an iterator pointing to the first item in the list
+            iterator begin(){
+                return iterator(data_);
+            }
+
+            /// Returns an iterator pointing to the end mark in the list
+            iterator end(){
+                return iterator(data_+size_);
+            }
+
+            /// Returns a constant iterator pointing to the first item in the list.
+            const_iterator cbegin() const{
+                return const_iterator(data_);
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the list
+            const_iterator cend() const{
+                return const_iterator(data_+size_);
+            }
+
+            /// Returns a constant iterator pointing to the first item in the list.
+            const_iterator begin() const{
+                return const_iterator(data_);
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the list.
+            const_iterator end() const{
+                return const_iterator(data_+size_);
+            }
+
+            /// Returns a reverse iterator pointing to the last item in the list.
+            reverse_iterator rbegin(){
+                return reverse_iterator(end());
+            }
+
+            /// Returns a reverse iterator pointing before the first item in the list.
+            reverse_iterator rend(){
+                return reverse_iterator(begin());
+            }
+
+            /// Returns a constant reverse iterator pointing to the last item in the list.
+            const_reverse_iterator rbegin() const{
+                return const_reverse_iterator(end());
+            }
+
+            /// Returns a constant reverse iterator pointing before the first item in the list.
+            const_reverse_iterator rend() const{
+                return const_reverse_iterator(begin());
+            }
+
+            /// Returns a pointer to the underlying array: [data(), data()+size()) are the elements.
+            T* data(){
+                return data_;
+            }
+
+            /// Returns a pointer to the underlying array: [data(), data()+size()) are the elements.
+            const T* data() const{
+                return data_;
+            }
+
+        //=== List container operations that require iterators
+            /// Adds value into the list before the position given by the iterator pos
+            iterator insert(iterator pos, const T & value){
+                return emplace(pos, value);
+            }
+
+            /// Moves value into the list before the position given by the iterator pos
+            iterator insert(iterator pos, T && value){
+                return emplace(pos, std::move(value));
+            }
+
+            /// Constructs a new element from args, in place, before the position given by the iterator pos
+            template <typename... Args>
+            iterator emplace(iterator pos, Args&&... args){
+                size_type tamanho = pos - begin();
+                if(size_ == capacity_){
+                    size_type new_cap = next_capacity(size_+1);
+                    T *new_data = allocate(new_cap);
+                    new (&new_data[tamanho]) T(std::forward<Args>(args)...); //args may live in the old buffer
+                    adopt(new_data, new_cap, tamanho, 1);
+                }
+                else if(tamanho == size_){
+                    new (&data_[size_]) T(std::forward<Args>(args)...);
+                }
+                else{
+                    T item(std::forward<Args>(args)...); //args may refer to one of the tail elements
+                    open_gap(tamanho, 1);
+                    new (&data_[tamanho]) T(std::move(item));
+                }
+                size_ += 1;
+                return iterator(&data_[tamanho]);
+            }
+
+            /// Inserts elements from the range [first; last) before pos
+            template <typename InItr>
+            iterator insert(iterator pos, InItr first, InItr last){
+                if(size_type(pos - begin()) > size_) return end();
+                size_type tamanho = pos - begin();
+                size_type diff = std::distance(first, last);
+                if(size_+diff > capacity_){
+                    size_type new_cap = next_capacity(size_+diff);
+                    T *new_data = allocate(new_cap);
+                    for(size_type i = tamanho; first != last; first++, i++){ //the range may live in the old buffer
+                        new (&new_data[i]) T(*first);
+                    }
+                    adopt(new_data, new_cap, tamanho, diff);
+                }
+                else{
+                    open_gap(tamanho, diff);
+                    for(size_type i = tamanho; first != last; first++, i++){
+                        new (&data_[i]) T(*first);
+                    }
+                }
+                size_ += diff;
+                return iterator(&data_[tamanho]);
+            }
+
+            /// Inserts elements from the initializer list ilist before pos
+            iterator insert(iterator pos, std::initializer_list<T> ilist){
+                return insert(pos, ilist.begin(), ilist.end());
+            }
+
+            /// Removes the object at position pos
+            iterator erase(iterator pos){
+                size_type tamanho = pos - begin();
+                close_gap(tamanho, tamanho+1);
+                return pos;
+            }
+
+            /// Removes elements in the range [first; last)
+            iterator erase(iterator first, iterator last){
+                close_gap(first - begin(), last - begin());
+                return first;
+            }
+
+            /// Exchanges the contents of the list with those of other.
+            /*! O(1) when both lists live on the heap; inline elements are moved one by one. */
+            void swap(small_vector& other){
+                small_vector tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+            }
+
+            friend std::ostream& operator<<(std::ostream& os, const small_vector& v){
+                os << "[ ";
+                for(size_type i = 0; i < v.size_; i++){
+                    os << v.data_[i] << " ";
+                }
+                os << "]";
+                return os;
+            }
+    };
+
+    //=== Operator overloading — non-member functions
+        /// Checks if the contents of lhs and rhs are equal.
+        template <typename T, std::size_t N, typename G>
+        bool operator==(const sc::small_vector<T, N, G>& lhs, const sc::small_vector<T, N, G>& rhs){
+            if(lhs.size() != rhs.size()) return false;
+            for(size_t i = 0; i < lhs.size(); i++){
+                if(lhs[i] != rhs[i])
+                    return false;
+            }
+            return true;
+        }
+
+        /// Similar to the previous operator, but the opposite result.
+        template <typename T, std::size_t N, typename G>
+        bool operator!=(const sc::small_vector<T, N, G>& lhs, const sc::small_vector<T, N, G>& rhs){
+            return !(lhs == rhs);
+        }
+
+        /// Checks if lhs is lexicographically less than rhs.
+        template <typename T, std::size_t N, typename G>
+        bool operator<(const sc::small_vector<T, N, G>& lhs, const sc::small_vector<T, N, G>& rhs){
+            return detail::compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+        }
+
+        /// Checks if lhs is lexicographically greater than rhs.
+        template <typename T, std::size_t N, typename G>
+        bool operator>(const sc::small_vector<T, N, G>& lhs, const sc::small_vector<T, N, G>& rhs){
+            return rhs < lhs;
+        }
+
+        /// Checks if lhs is lexicographically less than or equal to rhs.
+        template <typename T, std::size_t N, typename G>
+        bool operator<=(const sc::small_vector<T, N, G>& lhs, const sc::small_vector<T, N, G>& rhs){
+            return !(rhs < lhs);
+        }
+
+        /// Checks if lhs is lexicographically greater than or equal to rhs.
+        template <typename T, std::size_t N, typename G>
+        bool operator>=(const sc::small_vector<T, N, G>& lhs, const sc::small_vector<T, N, G>& rhs){
+            return !(lhs < rhs);
+        }
+
+        /// Exchanges the contents of lhs and rhs.
+        template <typename T, std::size_t N, typename G>
+        void swap(sc::small_vector<T, N, G>& lhs, sc::small_vector<T, N, G>& rhs){
+            lhs.swap(rhs);
+        }
+}
+
+#endif
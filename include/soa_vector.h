@@ -0,0 +1,457 @@
+/*!
+ * \file soa_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "vector.h"
+#include "span.h"
+
+namespace sc{ // sc: Sequence container
+    /// Structure-of-arrays vector: one contiguous array per field, under a shared size and capacity.
+    /*! Rows are std::tuple<Ts...>, but each field lives in its own array (a column), so a loop
+     * over one field reads only that field's bytes instead of whole records: column<I>()
+     * returns the field as a contiguous span, ready for sc::numeric or vectorized loops.
+     * Row access goes through proxy references, std::tuple<Ts&...>, which read and assign
+     * every field of the row in place (and work with structured bindings).
+     *
+     * Growth and reserve() behave as in sc::vector with growth::doubling: the capacity
+     * doubles when full and reserve() allocates exactly what is asked. Every column is
+     * reallocated at once, so all of them always have the same capacity.
+     */
+    template <typename... Ts>
+    class soa_vector{
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = std::tuple<Ts...>; //!< A row, by value.
+            using reference = std::tuple<Ts&...>; //!< Proxy reference to a row.
+            using const_reference = std::tuple<const Ts&...>; //!< Proxy const reference to a row.
+            template <std::size_t I>
+            using column_type = typename std::tuple_element<I, value_type>::type; //!< Type of field I.
+
+            /// A contiguous column of elements (see span.h).
+            template <typename U>
+            using span = sc::span<U>;
+
+        //=== Private data
+        private:
+            using indices = std::index_sequence_for<Ts...>; //!< 0, 1, ..., one per column.
+
+            std::tuple<Ts*...> data_; //!< One storage area per column. Only the first size_ slots hold live objects.
+            size_type size_; //!< Number of rows currently in the vector.
+            size_type capacity_; //!< Rows every column has room for.
+
+        //=== Raw storage helpers
+        private:
+            /// Returns uninitialized storage for `n` objects of T.
+            template <typename T>
+            static T* allocate(size_type n){
+                if(n == 0) return nullptr;
+                return std::allocator<T>().allocate(n);
+            }
+
+            /// Releases storage of `n` objects obtained from allocate(). The objects in it must be already destroyed.
+            template <typename T>
+            static void deallocate(T *ptr, size_type n){
+                if(ptr != nullptr) std::allocator<T>().deallocate(ptr, n);
+            }
+
+            /// Destroys the objects in [first, last) without releasing their storage.
+            template <typename T>
+            static void destroy(T *first, T *last){
+                if constexpr(!std::is_trivially_destructible<T>::value){
+                    for(; first != last; first++){
+                        first->~T();
+                    }
+                }
+            }
+
+            /// Moves the objects in [first, last) into the uninitialized, non-overlapping storage at dest and destroys the originals.
+            template <typename T>
+            static void relocate(T *first, T *last, T *dest){
+                if constexpr(is_trivially_relocatable<T>::value){
+                    if(first != last) std::memcpy(static_cast<void*>(dest), first, (last-first) * sizeof(T));
+                }
+                else{
+                    for(; first != last; first++, dest++){
+                        new (dest) T(std::move_if_noexcept(*first));
+                        first->~T();
+                    }
+                }
+            }
+
+            /// Returns a new block of `n` slots for every column; nothing leaks if one of them fails.
+            template <std::size_t... I>
+            static std::tuple<Ts*...> allocate_columns(size_type n, std::index_sequence<I...>){
+                std::tuple<Ts*...> columns{};
+                try{
+                    ((std::get<I>(columns) = allocate<Ts>(n)), ...);
+                }
+                catch(...){
+                    (deallocate(std::get<I>(columns), n), ...);
+                    throw;
+                }
+                return columns;
+            }
+
+            /// Destroys the rows in [first, last) of every column.
+            template <std::size_t... I>
+            void destroy_rows(size_type first, size_type last, std::index_sequence<I...>){
+                (destroy(std::get<I>(data_) + first, std::get<I>(data_) + last), ...);
+            }
+
+            /// Destroys the rows and releases every column.
+            template <std::size_t... I>
+            void release(std::index_sequence<I...>){
+                destroy_rows(0, size_, indices{});
+                (deallocate(std::get<I>(data_), capacity_), ...);
+            }
+
+            /// Builds row `pos` from one argument per column. If a field throws, the ones already built are destroyed.
+            template <std::size_t... I, typename... Args>
+            void construct_row(size_type pos, std::index_sequence<I...>, Args&&... args){
+                std::size_t done = 0;
+                try{
+                    ((new (std::get<I>(data_) + pos) Ts(std::forward<Args>(args)), done++), ...);
+                }
+                catch(...){
+                    ((I < done ? std::get<I>(data_)[pos].~Ts() : void()), ...);
+                    throw;
+                }
+            }
+
+            /// Value-initializes the rows in [first, last) column by column.
+            template <std::size_t... I>
+            void construct_rows(size_type first, size_type last, std::index_sequence<I...>){
+                std::size_t done = 0;
+                try{
+                    ((std::uninitialized_value_construct(std::get<I>(data_) + first, std::get<I>(data_) + last), done++), ...);
+                }
+                catch(...){
+                    ((I < done ? destroy(std::get<I>(data_) + first, std::get<I>(data_) + last) : void()), ...);
+                    throw;
+                }
+            }
+
+        //=== Growth engine
+            /// Moves every column into blocks with room for exactly `new_cap` rows.
+            template <std::size_t... I>
+            void reallocate(size_type new_cap, std::index_sequence<I...>){
+                std::tuple<Ts*...> fresh = allocate_columns(new_cap, indices{});
+                (relocate(std::get<I>(data_), std::get<I>(data_) + size_, std::get<I>(fresh)), ...);
+                (deallocate(std::get<I>(data_), capacity_), ...);
+                data_ = fresh;
+                capacity_ = new_cap;
+            }
+
+            /// Grows, as growth::doubling decides, so that at least `min_cap` rows fit.
+            void grow_for(size_type min_cap){
+                if(min_cap <= capacity_) return;
+                reallocate(growth::doubling::next(capacity_, min_cap, row_size), indices{});
+            }
+
+        //=== Public interface
+        public:
+            static constexpr std::size_t columns = sizeof...(Ts); //!< Number of fields per row.
+            static constexpr std::size_t row_size = (sizeof(Ts) + ...); //!< Bytes of one row over all columns.
+
+            /// Constructor
+            soa_vector() : data_{}, size_{0}, capacity_{0}{ }
+
+            /// Constructor with a list of rows.
+            soa_vector(std::initializer_list<value_type> ilist) : soa_vector(){
+                reserve(ilist.size());
+                for(const value_type &row : ilist){
+                    push_back(row);
+                }
+            }
+
+            /// Copy constructor. The copy has capacity() == other.size().
+            /*! If a copy throws, the delegated-to constructor has finished, so the destructor frees the rows built so far. */
+            soa_vector(const soa_vector& other) : soa_vector(){
+                reserve(other.size_);
+                for(size_type i = 0; i < other.size_; i++){
+                    push_back(value_type(other[i]));
+                }
+            }
+
+            /// Move constructor. Leaves other empty.
+            soa_vector(soa_vector&& other) noexcept : soa_vector(){
+                swap(other);
+            }
+
+            /// Destructor
+            ~soa_vector(){
+                release(indices{});
+            }
+
+            /// Copy assignment.
+            soa_vector& operator=(const soa_vector& other){
+                if(this != &other){
+                    soa_vector copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            /// Move assignment.
+            soa_vector& operator=(soa_vector&& other) noexcept{
+                soa_vector moved(std::move(other));
+                swap(moved);
+                return *this;
+            }
+
+            /// Returns the number of rows.
+            size_type size() const{
+                return size_;
+            }
+
+            /// Returns the number of rows every column has room for.
+            size_type capacity() const{
+                return capacity_;
+            }
+
+            /// Returns true if there are no rows.
+            bool empty() const{
+                return size_ == 0;
+            }
+
+            /// Makes room for exactly `new_cap` rows in every column, if there is not enough already.
+            void reserve(size_type new_cap){
+                if(new_cap <= capacity_) return;
+                reallocate(new_cap, indices{});
+            }
+
+            /// Shrinks every column to size().
+            void shrink_to_fit(){
+                if(size_ == capacity_) return;
+                reallocate(size_, indices{});
+            }
+
+            /// Removes every row. The capacity is kept.
+            void clear(){
+                destroy_rows(0, size_, indices{});
+                size_ = 0;
+            }
+
+            /// Resizes to count rows. New rows are value-initialized (zeroed for trivial fields).
+            void resize(size_type count){
+                if(count <= size_){
+                    destroy_rows(count, size_, indices{});
+                    size_ = count;
+                    return;
+                }
+                grow_for(count);
+                construct_rows(size_, count, indices{});
+                size_ = count;
+            }
+
+            /// Adds a row built from one argument per column. Returns a reference to it.
+            template <typename... Args>
+            reference emplace_back(Args&&... args){
+                static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+                if(size_ == capacity_){
+                    value_type row(std::forward<Args>(args)...); //the arguments may live in the columns that are about to move
+                    grow_for(size_+1);
+                    std::apply([this](Ts&... field){ construct_row(size_, indices{}, std::move(field)...); }, row);
+                }
+                else{
+                    construct_row(size_, indices{}, std::forward<Args>(args)...);
+                }
+                return (*this)[size_++];
+            }
+
+            /// Adds a copy of row at the end.
+            void push_back(const value_type& row){
+                std::apply([this](const Ts&... field){ emplace_back(field...); }, row);
+            }
+
+            /// Moves row to the end.
+            void push_back(value_type&& row){
+                std::apply([this](Ts&... field){ emplace_back(std::move(field)...); }, row);
+            }
+
+            /// Removes the last row. Does nothing if the vector is empty.
+            void pop_back(){
+                if(size_ > 0){
+                    destroy_rows(size_-1, size_, indices{});
+                    size_--;
+                }
+            }
+
+            /// Returns a proxy reference to row pos.
+            reference operator[](size_type pos){
+                return std::apply([pos](Ts*... column){ return reference(column[pos]...); }, data_);
+            }
+
+            /// Returns a proxy const reference to row pos.
+            const_reference operator[](size_type pos) const{
+                return std::apply([pos](Ts*... column){ return const_reference(column[pos]...); }, data_);
+            }
+
+            /// Returns a proxy reference to row pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            reference at(size_type pos){
+                if(pos >= size_){
+                    throw std::out_of_range("[soa_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return (*this)[pos];
+            }
+
+            /// Returns a proxy const reference to row pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            const_reference at(size_type pos) const{
+                if(pos >= size_){
+                    throw std::out_of_range("[soa_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return (*this)[pos];
+            }
+
+            /// Returns a proxy reference to the first row.
+            reference front(){ return (*this)[0]; }
+            /// Returns a proxy const reference to the first row.
+            const_reference front() const{ return (*this)[0]; }
+            /// Returns a proxy reference to the last row.
+            reference back(){ return (*this)[size_-1]; }
+            /// Returns a proxy const reference to the last row.
+            const_reference back() const{ return (*this)[size_-1]; }
+
+            /// Returns the array of field I.
+            template <std::size_t I>
+            column_type<I>* data(){
+                return std::get<I>(data_);
+            }
+
+            /// Returns the array of field I.
+            template <std::size_t I>
+            const column_type<I>* data() const{
+                return std::get<I>(data_);
+            }
+
+            /// Returns field I of every row as a contiguous span.
+            template <std::size_t I>
+            span<column_type<I>> column(){
+                return { std::get<I>(data_), size_ };
+            }
+
+            /// Returns field I of every row as a contiguous span.
+            template <std::size_t I>
+            span<const column_type<I>> column() const{
+                return { std::get<I>(data_), size_ };
+            }
+
+            /// Exchanges the contents with other.
+            void swap(soa_vector& other) noexcept{
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                std::swap(capacity_, other.capacity_);
+            }
+
+        //=== Iterators
+            /// Random access iterator over rows; dereferencing yields a proxy reference.
+            template <typename V, typename Ref>
+            class basic_iterator{
+                public:
+                    typedef Ref reference; //!< Proxy reference to a row.
+                    typedef void pointer; //!< Rows are proxies: there is no pointer to them.
+                    typedef std::tuple<Ts...> value_type; //!< A row, by value.
+                    /// Difference type used to calculated distance between iterators.
+                    typedef std::ptrdiff_t difference_type;
+                    /// Identifies the iterator category to algorithms from STL
+                    typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+                //=== Private data
+                private:
+                    V *vec; //!< The vector iterated.
+                    size_type pos_; //!< Row the iterator points to.
+
+                    template <typename, typename> friend class basic_iterator;
+                //=== Public interface
+                public:
+                    /// Constructor
+                    basic_iterator(V *v = nullptr, size_type pos = 0) : vec{v}, pos_{pos}{ }
+
+                    /// Converts an iterator to a const_iterator.
+                    template <typename W, typename R, typename = std::enable_if_t<std::is_convertible<W*, V*>::value>>
+                    basic_iterator(const basic_iterator<W, R> &other) : vec{other.vec}, pos_{other.pos_}{ }
+
+                    reference operator*() const{ return (*vec)[pos_]; }
+                    reference operator[](difference_type n) const{ return (*vec)[pos_ + n]; }
+
+                    basic_iterator& operator++(){ pos_++; return *this; }
+                    basic_iterator operator++(int){ basic_iterator old(*this); pos_++; return old; }
+                    basic_iterator& operator--(){ pos_--; return *this; }
+                    basic_iterator operator--(int){ basic_iterator old(*this); pos_--; return old; }
+                    basic_iterator& operator+=(difference_type n){ pos_ += n; return *this; }
+                    basic_iterator& operator-=(difference_type n){ pos_ -= n; return *this; }
+
+                    friend basic_iterator operator+(basic_iterator it, difference_type n){ return it += n; }
+                    friend basic_iterator operator+(difference_type n, basic_iterator it){ return it += n; }
+                    friend basic_iterator operator-(basic_iterator it, difference_type n){ return it -= n; }
+                    friend difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return difference_type(lhs.pos_) - difference_type(rhs.pos_);
+                    }
+
+                    friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ == rhs.pos_; }
+                    friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ != rhs.pos_; }
+                    friend bool operator<(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ < rhs.pos_; }
+                    friend bool operator>(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ > rhs.pos_; }
+                    friend bool operator<=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ <= rhs.pos_; }
+                    friend bool operator>=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ >= rhs.pos_; }
+            };
+
+            using iterator = basic_iterator<soa_vector, reference>; //!< Iterator over rows.
+            using const_iterator = basic_iterator<const soa_vector, const_reference>; //!< Const iterator over rows.
+
+            iterator begin(){ return iterator(this, 0); }
+            iterator end(){ return iterator(this, size_); }
+            const_iterator begin() const{ return const_iterator(this, 0); }
+            const_iterator end() const{ return const_iterator(this, size_); }
+            const_iterator cbegin() const{ return begin(); }
+            const_iterator cend() const{ return end(); }
+    };
+
+    /// Checks if the contents of lhs and rhs are equal, row by row.
+    template <typename... Ts>
+    bool operator==(const soa_vector<Ts...> &lhs, const soa_vector<Ts...> &rhs){
+        if(lhs.size() != rhs.size()) return false;
+        for(typename soa_vector<Ts...>::size_type i = 0; i < lhs.size(); i++){
+            if(lhs[i] != rhs[i]) return false;
+        }
+        return true;
+    }
+
+    /// Checks if the contents of lhs and rhs are different.
+    template <typename... Ts>
+    bool operator!=(const soa_vector<Ts...> &lhs, const soa_vector<Ts...> &rhs){
+        return !(lhs == rhs);
+    }
+
+    /// Exchanges the contents of lhs and rhs.
+    template <typename... Ts>
+    void swap(soa_vector<Ts...> &lhs, soa_vector<Ts...> &rhs) noexcept{
+        lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,255 @@
+/*!
+ * \file sort.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef SORT_H
+#define SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "parallel.h"
+
+/*! Sorting for random-access ranges, such as those of sc::vector.
+ *
+ * - radix_sort(): LSD radix sort on integer and floating point keys, one byte per pass.
+ *   Passes where every key has the same byte are skipped, so small keys in wide types
+ *   cost only the passes they need. Stable. Needs a buffer as large as the range.
+ * - sort() with a comparator: parallel merge sort on a sc::thread_pool. The range is cut
+ *   into runs sorted independently, then merged pairwise; each round of merges is split
+ *   into even pieces of output (by binary search on the merge path), so the last rounds
+ *   use every thread too. Not stable.
+ * - sort() without a comparator: radix_sort() if the elements are integers or floats,
+ *   the merge sort with std::less otherwise.
+ *
+ * Every entry point falls back to insertion sort for small ranges.
+ */
+namespace sc{ // sc: Sequence container
+    namespace detail{
+        /// Ranges up to this size are insertion sorted.
+        constexpr std::size_t insertion_sort_threshold = 32;
+
+        /// Sorts [first, last) by insertion. Stable.
+        template <typename RandomIt, typename Compare>
+        void insertion_sort(RandomIt first, RandomIt last, Compare comp){
+            if(first == last) return;
+            for(RandomIt i = first + 1; i != last; ++i){
+                if(!comp(*i, *(i - 1))) continue;
+                auto value = std::move(*i);
+                RandomIt j = i;
+                do{
+                    *j = std::move(*(j - 1));
+                    --j;
+                } while(j != first && comp(value, *(j - 1)));
+                *j = std::move(value);
+            }
+        }
+
+        /// True for the key types radix_sort() understands.
+        template <typename K>
+        struct is_radix_key : std::integral_constant<bool,
+            (std::is_integral<K>::value && !std::is_same<K, bool>::value) ||
+            std::is_same<K, float>::value || std::is_same<K, double>::value>{};
+
+        /// Maps a key to an unsigned integer with the same order.
+        template <typename K, typename std::enable_if<std::is_integral<K>::value, int>::type = 0>
+        typename std::make_unsigned<K>::type radix_bits(K key){
+            using U = typename std::make_unsigned<K>::type;
+            U bits = U(key);
+            if(std::is_signed<K>::value) bits ^= U(U(1) << (sizeof(U)*8 - 1)); //negatives below positives
+            return bits;
+        }
+
+        /// Floats: flips all bits of negatives (reversing their order) and the sign bit of positives.
+        inline std::uint32_t radix_bits(float key){
+            std::uint32_t bits;
+            std::memcpy(&bits, &key, sizeof bits);
+            return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+        }
+
+        /// Doubles: as floats.
+        inline std::uint64_t radix_bits(double key){
+            std::uint64_t bits;
+            std::memcpy(&bits, &key, sizeof bits);
+            return bits & 0x8000000000000000ull ? ~bits : bits | 0x8000000000000000ull;
+        }
+
+        /// LSD radix sort of the n elements at data by key(element), using scratch as the other half of the ping-pong.
+        /*! Returns true if the sorted elements ended up in scratch. */
+        template <typename DataIt, typename ScratchIt, typename Key>
+        bool radix_sort(DataIt data, ScratchIt scratch, std::size_t n, Key &key){
+            using bits_type = decltype(radix_bits(key(*data)));
+            constexpr std::size_t passes = sizeof(bits_type);
+            //Counts every byte of every key in a single read of the range.
+            std::vector<std::size_t> count(passes * 256, 0);
+            for(std::size_t i = 0; i < n; i++){
+                bits_type bits = radix_bits(key(data[i]));
+                for(std::size_t p = 0; p < passes; p++){
+                    count[p*256 + ((bits >> (8*p)) & 0xFF)]++;
+                }
+            }
+            /// Moves src to dst ordered by byte p, with c holding the bucket starts.
+            auto scatter = [&key, n](auto src, auto dst, std::size_t p, std::size_t *c){
+                for(std::size_t i = 0; i < n; i++){
+                    dst[c[(radix_bits(key(src[i])) >> (8*p)) & 0xFF]++] = std::move(src[i]);
+                }
+            };
+            bool in_scratch = false;
+            for(std::size_t p = 0; p < passes; p++){
+                std::size_t *c = &count[p*256];
+                if(*std::max_element(c, c + 256) == n) continue; //every key has the same byte here
+                std::size_t offset = 0;
+                for(std::size_t d = 0; d < 256; d++){
+                    std::size_t k = c[d];
+                    c[d] = offset;
+                    offset += k;
+                }
+                if(in_scratch) scatter(scratch, data, p, c);
+                else scatter(data, scratch, p, c);
+                in_scratch = !in_scratch;
+            }
+            return in_scratch;
+        }
+
+        /// Number of elements of a that come first in the first k of the merge of a and b.
+        template <typename It, typename Compare>
+        std::size_t merge_split(It a, std::size_t na, It b, std::size_t nb, std::size_t k, Compare &comp){
+            std::size_t lo = k > nb ? k - nb : 0;
+            std::size_t hi = k < na ? k : na;
+            while(lo < hi){
+                std::size_t i = lo + (hi - lo) / 2;
+                if(comp(b[k - i - 1], a[i])) hi = i;
+                else lo = i + 1;
+            }
+            return lo;
+        }
+
+        /// Merges the consecutive sorted runs of `run` elements in src into runs twice as long in dst.
+        /*! The output is cut into pieces of `grain` elements. Where each piece starts in its
+         * merge is found first, for all of them: the searches read elements around the cut,
+         * which the neighbouring piece moves from once it runs.
+         */
+        template <typename SrcIt, typename DstIt, typename Compare>
+        void merge_round(thread_pool &pool, SrcIt src, DstIt dst, std::size_t n, std::size_t run,
+                         std::size_t grain, Compare &comp){
+            std::size_t pieces = (n + grain - 1) / grain;
+            /// Start of the merge holding output position k, and the sizes of its two runs.
+            auto merge_of = [n, run](std::size_t k, std::size_t &na, std::size_t &nb){
+                std::size_t start = k / (2*run) * (2*run);
+                na = std::min(run, n - start);
+                nb = std::min(run, n - start - na);
+                return start;
+            };
+            std::vector<std::size_t> split(pieces); //elements of the first run before each cut
+            parallel::detail::parallel_for(pool, pieces, 1024, [&](std::size_t lo, std::size_t hi){
+                for(std::size_t p = lo; p < hi; p++){
+                    std::size_t na, nb;
+                    std::size_t start = merge_of(p*grain, na, nb);
+                    split[p] = merge_split(src + start, na, src + start + na, nb, p*grain - start, comp);
+                }
+            });
+            parallel::detail::parallel_for(pool, pieces, 1, [&](std::size_t lo, std::size_t hi){
+                for(std::size_t p = lo; p < hi; p++){
+                    //The piece may span several merges: do its part of each one.
+                    std::size_t first = p*grain, last = std::min(n, first + grain);
+                    for(std::size_t k = first; k < last;){
+                        std::size_t na, nb;
+                        std::size_t start = merge_of(k, na, nb);
+                        std::size_t end = std::min(last, start + na + nb);
+                        std::size_t i0 = k == first ? split[p] : 0;
+                        std::size_t i1 = end == start + na + nb ? na : split[p+1];
+                        SrcIt a = src + start, b = a + na;
+                        std::merge(std::make_move_iterator(a + i0), std::make_move_iterator(a + i1),
+                                   std::make_move_iterator(b + (k - start - i0)), std::make_move_iterator(b + (end - start - i1)),
+                                   dst + k, comp);
+                        k = end;
+                    }
+                }
+            });
+        }
+    }
+
+    /// Sorts [first, last) by insertion: the fastest for a few dozen elements. Stable.
+    template <typename RandomIt, typename Compare = std::less<>>
+    void insertion_sort(RandomIt first, RandomIt last, Compare comp = {}){
+        detail::insertion_sort(first, last, comp);
+    }
+
+    /// Sorts [first, last) in ascending order of key(element), an integer or float. Stable.
+    template <typename RandomIt, typename Key>
+    void radix_sort(RandomIt first, RandomIt last, Key key){
+        using value_type = typename std::iterator_traits<RandomIt>::value_type;
+        static_assert(detail::is_radix_key<typename std::decay<decltype(key(*first))>::type>::value,
+                      "radix_sort keys must be integers or floating point numbers");
+        std::size_t n = last - first;
+        if(n <= detail::insertion_sort_threshold){
+            detail::insertion_sort(first, last, [&key](const value_type &a, const value_type &b){ return key(a) < key(b); });
+            return;
+        }
+        //The elements start in the buffer, so that the first pass fills the range.
+        std::vector<value_type> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+        if(!detail::radix_sort(buffer.begin(), first, n, key)){
+            std::move(buffer.begin(), buffer.end(), first);
+        }
+    }
+
+    /// Sorts [first, last) of integers or floats in ascending order. Stable.
+    template <typename RandomIt>
+    void radix_sort(RandomIt first, RandomIt last){
+        using value_type = typename std::iterator_traits<RandomIt>::value_type;
+        radix_sort(first, last, [](const value_type &x){ return x; });
+    }
+
+    /// Sorts [first, last) with comp, in parallel on opt.pool. Not stable.
+    template <typename RandomIt, typename Compare>
+    void sort(RandomIt first, RandomIt last, Compare comp, const parallel::options &opt = {}){
+        using value_type = typename std::iterator_traits<RandomIt>::value_type;
+        std::size_t n = last - first;
+        if(n <= detail::insertion_sort_threshold){
+            detail::insertion_sort(first, last, comp);
+            return;
+        }
+        thread_pool &pool = opt.pool ? *opt.pool : thread_pool::global();
+        std::size_t grain = parallel::detail::grain_for(opt, pool, n);
+        //Sorted runs of one grain each; the merges then double them.
+        std::size_t run = grain;
+        std::size_t runs = (n + run - 1) / run;
+        parallel::detail::parallel_for(pool, runs, 1, [&](std::size_t lo, std::size_t hi){
+            for(std::size_t r = lo; r < hi; r++){
+                std::sort(first + r*run, first + std::min(n, (r+1)*run), comp);
+            }
+        });
+        if(runs == 1) return;
+        std::vector<value_type> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+        bool in_buffer = true;
+        for(; run < n; run *= 2){
+            if(in_buffer) detail::merge_round(pool, buffer.begin(), first, n, run, grain, comp);
+            else detail::merge_round(pool, first, buffer.begin(), n, run, grain, comp);
+            in_buffer = !in_buffer;
+        }
+        if(in_buffer) parallel::copy(std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()), first, opt);
+    }
+
+    /// Sorts [first, last) in ascending order: radix sort for integers and floats, parallel merge sort otherwise.
+    template <typename RandomIt>
+    void sort(RandomIt first, RandomIt last, const parallel::options &opt = {}){
+        using value_type = typename std::iterator_traits<RandomIt>::value_type;
+        if constexpr(detail::is_radix_key<value_type>::value){
+            (void)opt;
+            radix_sort(first, last);
+        }
+        else{
+            sort(first, last, std::less<>{}, opt);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,35 @@
+/*!
+ * \file span.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef SPAN_H
+#define SPAN_H
+
+/*! A contiguous run of elements that a container lends out: the two runs of a
+ * ring_vector, a column of an soa_vector, a segment of a stable_vector.
+ *
+ * It is a pointer and a count with the usual range members, so it works with
+ * range-for and with sc::numeric (which needs data() and size()). It does not own
+ * the elements and is invalidated by whatever invalidates the container's iterators.
+ */
+namespace sc{ // sc: Sequence container
+    /// A contiguous run of elements: [first, first+count).
+    template <typename U>
+    struct span{
+        using size_type = unsigned long; //!< The size type.
+
+        U *first; //!< First element of the run.
+        size_type count; //!< Number of elements in the run.
+
+        U* data() const{ return first; }
+        U* begin() const{ return first; }
+        U* end() const{ return first + count; }
+        size_type size() const{ return count; }
+        bool empty() const{ return count == 0; }
+        U& operator[](size_type pos) const{ return first[pos]; }
+    };
+}
+
+#endif
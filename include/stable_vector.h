@@ -0,0 +1,411 @@
+/*!
+ * \file stable_vector.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef STABLE_VECTOR_H
+#define STABLE_VECTOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "span.h"
+
+namespace sc{ // sc: Sequence container
+    namespace detail{
+        /// Default segment size of stable_vector: the power of two elements closest below 4 KiB, at least 16.
+        template <typename T>
+        constexpr std::size_t stable_segment_size(){
+            std::size_t n = 16;
+            while(n * 2 * sizeof(T) <= 4096) n *= 2;
+            return n;
+        }
+    }
+
+    /// Segmented vector: elements never move, so pointers and references to them stay valid.
+    /*! The elements live in segments of SegmentSize slots (a power of two) listed by a
+     * directory, so operator[] is a shift, a mask and two loads. Growing adds one segment
+     * and never touches the elements already stored: there is no big reallocation, and a
+     * pointer to an element is valid until that element is erased.
+     *
+     * The directory itself doubles when full, but its entries are copied a few at a time,
+     * two per segment added, while reads use the old directory for the entries not copied
+     * yet. So every push_back() costs at most one segment allocation and two pointer copies,
+     * whatever the size: the worst-case latency is bounded, not just the amortized one.
+     *
+     * segment_count() and segment() expose the storage as contiguous blocks for bulk loops.
+     */
+    template <typename T, std::size_t SegmentSize = detail::stable_segment_size<T>()>
+    class stable_vector{
+        static_assert(SegmentSize > 0 && (SegmentSize & (SegmentSize - 1)) == 0, "SegmentSize must be a power of two");
+
+        public:
+            using size_type = unsigned long; //!< The size type.
+            using value_type = T; //!< The value type.
+            using pointer = value_type*; //!< Pointer to a value stored in the container.
+            using reference = value_type&; //!< Reference to a value stored in the container.
+            using const_reference = const value_type&; //!< Const reference to a value stored
+
+            static constexpr size_type segment_size = SegmentSize; //!< Slots per segment.
+
+            /// A contiguous block of elements (see span.h).
+            template <typename U>
+            using span = sc::span<U>;
+
+        //=== Private data
+        private:
+            /// log2(SegmentSize): the segment of element i is i >> shift.
+            static constexpr unsigned shift = [] {
+                unsigned s = 0;
+                while((size_type(1) << s) < SegmentSize) s++;
+                return s;
+            }();
+            static constexpr size_type mask = SegmentSize - 1; //!< The slot of element i is i & mask.
+
+            T **directory; //!< Segment pointers; [0, old_count_) may still be only in old_directory.
+            size_type directory_capacity; //!< Slots in the directory.
+            T **old_directory; //!< Previous directory while its entries are copied, or nullptr.
+            size_type old_count_; //!< Entries of old_directory (0 when there is none).
+            size_type copied_; //!< Entries of old_directory already copied to directory.
+            size_type segments_; //!< Segments allocated (used or spare).
+            size_type size_; //!< Number of elements currently in the vector.
+
+        //=== Raw storage helpers
+        private:
+            /// Returns segment k.
+            T* segment_at(size_type k) const{
+                return k < old_count_ ? old_directory[k] : directory[k];
+            }
+
+            /// Returns the slot of element pos.
+            T* slot(size_type pos) const{
+                return segment_at(pos >> shift) + (pos & mask);
+            }
+
+            /// Copies up to n entries of the old directory; releases it once all are copied.
+            void copy_entries(size_type n){
+                for(; n > 0 && copied_ < old_count_; n--, copied_++){
+                    directory[copied_] = old_directory[copied_];
+                }
+                if(old_directory != nullptr && copied_ == old_count_){
+                    std::allocator<T*>().deallocate(old_directory, old_count_);
+                    old_directory = nullptr;
+                    old_count_ = 0;
+                }
+            }
+
+            /// Appends an uninitialized segment, doubling the directory if it is full.
+            void add_segment(){
+                if(segments_ == directory_capacity){
+                    //The previous copy is over: it copied two entries per segment since it started.
+                    size_type new_capacity = directory_capacity == 0 ? 8 : directory_capacity * 2;
+                    T **fresh = std::allocator<T*>().allocate(new_capacity);
+                    old_directory = directory;
+                    old_count_ = segments_;
+                    copied_ = 0;
+                    directory = fresh;
+                    directory_capacity = new_capacity;
+                }
+                directory[segments_] = std::allocator<T>().allocate(SegmentSize);
+                segments_++;
+                copy_entries(2);
+            }
+
+            /// Releases every segment and the directories. The objects must be already destroyed.
+            void release(){
+                for(size_type k = 0; k < segments_; k++){
+                    std::allocator<T>().deallocate(segment_at(k), SegmentSize);
+                }
+                if(old_directory != nullptr) std::allocator<T*>().deallocate(old_directory, old_count_);
+                if(directory != nullptr) std::allocator<T*>().deallocate(directory, directory_capacity);
+            }
+
+        //=== Public interface
+        public:
+            /// Constructor
+            stable_vector() : directory{nullptr}, directory_capacity{0}, old_directory{nullptr},
+                              old_count_{0}, copied_{0}, segments_{0}, size_{0}{ }
+
+            /// Constructor with a list of values.
+            stable_vector(std::initializer_list<T> ilist) : stable_vector(){
+                reserve(ilist.size());
+                for(const T &value : ilist){
+                    push_back(value);
+                }
+            }
+
+            /// Copy constructor.
+            /*! If a copy throws, the delegated-to constructor has finished, so the destructor frees what was built so far. */
+            stable_vector(const stable_vector& other) : stable_vector(){
+                reserve(other.size_);
+                for(size_type i = 0; i < other.size_; i++){
+                    push_back(other[i]);
+                }
+            }
+
+            /// Move constructor. Leaves other empty; pointers to its elements now point into this one.
+            stable_vector(stable_vector&& other) noexcept : stable_vector(){
+                swap(other);
+            }
+
+            /// Destructor
+            ~stable_vector(){
+                clear();
+                release();
+            }
+
+            /// Copy assignment.
+            stable_vector& operator=(const stable_vector& other){
+                if(this != &other){
+                    stable_vector copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            /// Move assignment.
+            stable_vector& operator=(stable_vector&& other) noexcept{
+                stable_vector moved(std::move(other));
+                swap(moved);
+                return *this;
+            }
+
+            /// Returns the number of elements.
+            size_type size() const{
+                return size_;
+            }
+
+            /// Returns the number of elements the allocated segments can hold.
+            size_type capacity() const{
+                return segments_ * SegmentSize;
+            }
+
+            /// Returns true if there are no elements.
+            bool empty() const{
+                return size_ == 0;
+            }
+
+            /// Allocates segments until at least new_cap elements fit. Existing elements do not move.
+            void reserve(size_type new_cap){
+                while(capacity() < new_cap){
+                    add_segment();
+                }
+            }
+
+            /// Releases the segments no element uses.
+            void shrink_to_fit(){
+                copy_entries(old_count_);
+                size_type used = (size_ + mask) >> shift;
+                for(; segments_ > used; segments_--){
+                    std::allocator<T>().deallocate(directory[segments_-1], SegmentSize);
+                }
+            }
+
+            /// Removes every element. The segments are kept.
+            void clear(){
+                while(size_ > 0){
+                    pop_back();
+                }
+            }
+
+            /// Resizes to count elements. New elements are value-initialized.
+            void resize(size_type count){
+                while(size_ > count){
+                    pop_back();
+                }
+                while(size_ < count){
+                    emplace_back();
+                }
+            }
+
+            /// Builds an element at the end from args. Returns a reference to it.
+            template <typename... Args>
+            reference emplace_back(Args&&... args){
+                if(size_ == capacity()) add_segment(); //no element moves, so args stay valid
+                T *p = slot(size_);
+                new (p) T(std::forward<Args>(args)...);
+                size_++;
+                return *p;
+            }
+
+            /// Adds a copy of value at the end.
+            void push_back(const T& value){
+                emplace_back(value);
+            }
+
+            /// Moves value to the end.
+            void push_back(T&& value){
+                emplace_back(std::move(value));
+            }
+
+            /// Removes the last element. Its segment is kept for later pushes. Does nothing if the vector is empty.
+            void pop_back(){
+                if(size_ > 0){
+                    size_--;
+                    slot(size_)->~T();
+                }
+            }
+
+            /// Returns a reference to the element at pos.
+            reference operator[](size_type pos){
+                return *slot(pos);
+            }
+
+            /// Returns a const reference to the element at pos.
+            const_reference operator[](size_type pos) const{
+                return *slot(pos);
+            }
+
+            /// Returns the object at the index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            reference at(size_type pos){
+                if(pos >= size_){
+                    throw std::out_of_range("[stable_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return *slot(pos);
+            }
+
+            /// Returns the object at the index pos, with bounds-checking.
+            /*!
+            * @throw Generates `out_of_range` exception if you enter the position
+            * beyond the bounds of the list.
+            */
+            const_reference at(size_type pos) const{
+                if(pos >= size_){
+                    throw std::out_of_range("[stable_vector::at()] Position entered beyond vector boundaries.");
+                }
+                return *slot(pos);
+            }
+
+            reference front(){ return *slot(0); }
+            const_reference front() const{ return *slot(0); }
+            reference back(){ return *slot(size_-1); }
+            const_reference back() const{ return *slot(size_-1); }
+
+            /// Returns the number of segments holding elements.
+            size_type segment_count() const{
+                return (size_ + mask) >> shift;
+            }
+
+            /// Returns the elements of segment k, a contiguous block (only the last one may be partial).
+            span<T> segment(size_type k){
+                return { segment_at(k), k+1 < segment_count() ? SegmentSize : size_ - k * SegmentSize };
+            }
+
+            /// Returns the elements of segment k, a contiguous block (only the last one may be partial).
+            span<const T> segment(size_type k) const{
+                return { segment_at(k), k+1 < segment_count() ? SegmentSize : size_ - k * SegmentSize };
+            }
+
+            /// Exchanges the contents with other. No element moves.
+            void swap(stable_vector& other) noexcept{
+                std::swap(directory, other.directory);
+                std::swap(directory_capacity, other.directory_capacity);
+                std::swap(old_directory, other.old_directory);
+                std::swap(old_count_, other.old_count_);
+                std::swap(copied_, other.copied_);
+                std::swap(segments_, other.segments_);
+                std::swap(size_, other.size_);
+            }
+
+        //=== Iterators
+            /// Random access iterator: an index into the vector, resolved through the directory.
+            template <typename V, typename U>
+            class basic_iterator{
+                public:
+                    typedef U& reference; //!< Reference to the value type.
+                    typedef U* pointer; //!< Pointer to the value type.
+                    typedef T value_type; //!< Value type the iterator points to.
+                    /// Difference type used to calculated distance between iterators.
+                    typedef std::ptrdiff_t difference_type;
+                    /// Identifies the iterator category to algorithms from STL
+                    typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+                //=== Private data
+                private:
+                    V *vec; //!< The vector iterated.
+                    size_type pos_; //!< Index of the element the iterator points to.
+
+                    template <typename, typename> friend class basic_iterator;
+                //=== Public interface
+                public:
+                    /// Constructor
+                    basic_iterator(V *v = nullptr, size_type pos = 0) : vec{v}, pos_{pos}{ }
+
+                    /// Converts an iterator to a const_iterator.
+                    template <typename W, typename X, typename = std::enable_if_t<std::is_convertible<X*, U*>::value>>
+                    basic_iterator(const basic_iterator<W, X> &other) : vec{other.vec}, pos_{other.pos_}{ }
+
+                    reference operator*() const{ return (*vec)[pos_]; }
+                    pointer operator->() const{ return &(*vec)[pos_]; }
+                    reference operator[](difference_type n) const{ return (*vec)[pos_ + n]; }
+
+                    basic_iterator& operator++(){ pos_++; return *this; }
+                    basic_iterator operator++(int){ basic_iterator old(*this); pos_++; return old; }
+                    basic_iterator& operator--(){ pos_--; return *this; }
+                    basic_iterator operator--(int){ basic_iterator old(*this); pos_--; return old; }
+                    basic_iterator& operator+=(difference_type n){ pos_ += n; return *this; }
+                    basic_iterator& operator-=(difference_type n){ pos_ -= n; return *this; }
+
+                    friend basic_iterator operator+(basic_iterator it, difference_type n){ return it += n; }
+                    friend basic_iterator operator+(difference_type n, basic_iterator it){ return it += n; }
+                    friend basic_iterator operator-(basic_iterator it, difference_type n){ return it -= n; }
+                    friend difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return difference_type(lhs.pos_) - difference_type(rhs.pos_);
+                    }
+
+                    friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ == rhs.pos_; }
+                    friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ != rhs.pos_; }
+                    friend bool operator<(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ < rhs.pos_; }
+                    friend bool operator>(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ > rhs.pos_; }
+                    friend bool operator<=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ <= rhs.pos_; }
+                    friend bool operator>=(const basic_iterator &lhs, const basic_iterator &rhs){ return lhs.pos_ >= rhs.pos_; }
+            };
+
+            using iterator = basic_iterator<stable_vector, T>; //!< Iterator.
+            using const_iterator = basic_iterator<const stable_vector, const T>; //!< Const iterator.
+
+            iterator begin(){ return iterator(this, 0); }
+            iterator end(){ return iterator(this, size_); }
+            const_iterator begin() const{ return const_iterator(this, 0); }
+            const_iterator end() const{ return const_iterator(this, size_); }
+            const_iterator cbegin() const{ return begin(); }
+            const_iterator cend() const{ return end(); }
+    };
+
+    /// Checks if the contents of lhs and rhs are equal.
+    template <typename T, std::size_t S>
+    bool operator==(const stable_vector<T, S> &lhs, const stable_vector<T, S> &rhs){
+        if(lhs.size() != rhs.size()) return false;
+        for(typename stable_vector<T, S>::size_type k = 0; k < lhs.segment_count(); k++){
+            auto a = lhs.segment(k);
+            auto b = rhs.segment(k);
+            for(typename stable_vector<T, S>::size_type i = 0; i < a.size(); i++){
+                if(a[i] != b[i]) return false;
+            }
+        }
+        return true;
+    }
+
+    /// Checks if the contents of lhs and rhs are different.
+    template <typename T, std::size_t S>
+    bool operator!=(const stable_vector<T, S> &lhs, const stable_vector<T, S> &rhs){
+        return !(lhs == rhs);
+    }
+
+    /// Exchanges the contents of lhs and rhs.
+    template <typename T, std::size_t S>
+    void swap(stable_vector<T, S> &lhs, stable_vector<T, S> &rhs) noexcept{
+        lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*!
+ * \file text.h
+ * \author Camila
+ * \date May, 2
+ */
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include "vector.h"
+#include "mmap_vector.h"
+#include "simd.h"
+
+/*! Delimited text (CSV, TSV, one value per line) for vectors of numbers.
+ *
+ * write_text() and to_text() format the elements with std::to_chars into a 64 KB
+ * buffer that is handed to the stream in one write() whenever it fills up, so there
+ * is no per-element stream call, locale lookup or sentry. Floating point values get
+ * the shortest text that reads back to the same value.
+ *
+ * parse_text() reads the values with std::from_chars. It counts the values first, in
+ * a SIMD pass (simd::count_fields), sizes the vector once with resize_for_overwrite(),
+ * and then parses straight into it. Values may be separated by the separator and by
+ * any whitespace, so rows of a CSV file and blank lines need no special handling.
+ * read_text() maps the file with mmap_view and parses it in place.
+ *
+ * Malformed values throw std::invalid_argument and values that do not fit T throw
+ * std::out_of_range; both report the offset of the value in the text.
+ */
+namespace sc{ // sc: Sequence container
+    /// How write_text() lays out the values.
+    struct text_format{
+        char separator = ','; //!< Between the values of a line.
+        unsigned long columns = 0; //!< Values per line; 0 puts every value on one line.
+    };
+
+    namespace detail{
+        /// Arithmetic types that are read and written as numbers (bool is not one of them).
+        template <typename T>
+        struct text_number : std::integral_constant<bool,
+            std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>{ };
+
+        /// Longest text std::to_chars writes for one value, with some slack.
+        constexpr std::size_t max_number_chars = 64;
+
+        /// Formats [first, last) and passes the text to put(data, n) in chunks of at most 64 KB.
+        template <typename T, typename Put>
+        void format_text(const T *first, const T *last, text_format format, Put put){
+            static_assert(text_number<T>::value, "only arithmetic types can be formatted as text");
+            constexpr std::size_t buffer_size = 64 * 1024;
+            char buffer[buffer_size];
+            char *out = buffer;
+            unsigned long column = 0;
+            for(; first != last; first++){
+                if(out > buffer + buffer_size - max_number_chars){
+                    put(buffer, std::size_t(out - buffer));
+                    out = buffer;
+                }
+                out = std::to_chars(out, buffer + buffer_size, *first).ptr;
+                if(++column == format.columns || first + 1 == last){
+                    *out++ = '\n';
+                    column = 0;
+                }
+                else{
+                    *out++ = format.separator;
+                }
+            }
+            if(out != buffer) put(buffer, std::size_t(out - buffer));
+        }
+
+        /// True for the characters that separate values: the separator and whitespace.
+        inline bool is_text_delimiter(char c, char separator){
+            return simd::detail::is_field_delimiter(static_cast<unsigned char>(c), static_cast<unsigned char>(separator));
+        }
+
+        /// Throws the exception for a from_chars error at the given offset.
+        [[noreturn]] inline void text_error(std::errc ec, std::size_t offset){
+            std::string where = " at offset " + std::to_string(offset) + ".";
+            if(ec == std::errc::result_out_of_range) throw std::out_of_range("Number out of range" + where);
+            throw std::invalid_argument("Invalid number" + where);
+        }
+    }
+
+    /// Writes the elements of v to os as delimited text, ending every line with '\n'.
+    template <typename T, typename Allocator, typename Growth>
+    void write_text(std::ostream &os, const vector<T, Allocator, Growth> &v, text_format format = text_format()){
+        detail::format_text(v.data(), v.data() + v.size(), format, [&os](const char *data, std::size_t n){
+            os.write(data, std::streamsize(n));
+        });
+    }
+
+    /// Returns the elements of v as delimited text, ending every line with '\n'.
+    template <typename T, typename Allocator, typename Growth>
+    std::string to_text(const vector<T, Allocator, Growth> &v, text_format format = text_format()){
+        std::string text;
+        detail::format_text(v.data(), v.data() + v.size(), format, [&text](const char *data, std::size_t n){
+            text.append(data, n);
+        });
+        return text;
+    }
+
+    /// Replaces the contents of v with the numbers in [first, last), separated by separator or whitespace.
+    /*! v is unchanged if the text holds a malformed number (std::invalid_argument) or one that
+     * does not fit T (std::out_of_range). A leading '+' is accepted, as operator>> does.
+     */
+    template <typename T, typename Allocator, typename Growth>
+    void parse_text(vector<T, Allocator, Growth> &v, const char *first, const char *last, char separator = ','){
+        static_assert(detail::text_number<T>::value, "only arithmetic types can be parsed from text");
+        using size_type = typename vector<T, Allocator, Growth>::size_type;
+        size_type count = simd::count_fields(first, std::size_t(last - first), separator);
+        vector<T, Allocator, Growth> fresh(v.get_allocator());
+        fresh.resize_for_overwrite(count);
+        T *out = fresh.data();
+        const char *p = first;
+        for(size_type i = 0; i < count; i++){
+            while(detail::is_text_delimiter(*p, separator)) p++;
+            const char *value = p;
+            if(*p == '+' && p + 1 != last && p[1] != '-' && !detail::is_text_delimiter(p[1], separator)) p++;
+            std::from_chars_result result = std::from_chars(p, last, out[i]);
+            if(result.ec != std::errc()) detail::text_error(result.ec, std::size_t(value - first));
+            if(result.ptr != last && !detail::is_text_delimiter(*result.ptr, separator)){
+                detail::text_error(std::errc::invalid_argument, std::size_t(value - first));
+            }
+            p = result.ptr;
+        }
+        v.swap(fresh);
+    }
+
+    /// Replaces the contents of v with the numbers in text, separated by separator or whitespace.
+    template <typename T, typename Allocator, typename Growth>
+    void parse_text(vector<T, Allocator, Growth> &v, std::string_view text, char separator = ','){
+        parse_text(v, text.data(), text.data() + text.size(), separator);
+    }
+
+    /// Replaces the contents of v with the numbers in the file at path, which is mapped rather than read.
+    /*! Throws std::system_error if the file cannot be opened or mapped. */
+    template <typename T, typename Allocator, typename Growth>
+    void read_text(vector<T, Allocator, Growth> &v, const std::string &path, char separator = ','){
+        mmap_view<char> file(path);
+        parse_text(v, file.data(), file.data() + file.size(), separator);
+    }
+}
+
+#endif
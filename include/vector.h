@@ -8,107 +8,450 @@
 #define VECTOR_H
 
 #include <cstdlib>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <exception>
 #include <algorithm>
 #include <initializer_list>
 #include <iterator>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <memory>
+#include <memory_resource>
+#if __cplusplus > 201703L
+#include <compare>
+#endif
+#include "growth_policy.h"
+#include "simd.h"
 
 /*! Implementing a list ADT based on a dynamic arrays data
  * structure. This versions of a list is equivalent to the std::vector.
  */
 namespace sc{ // sc: Sequence container
+    /// Tells whether moving a T and then destroying the source is equivalent to a raw memcpy.
+    /*! True for trivially copyable types. Specialize it to `std::true_type` for user types
+     * known to be relocatable (e.g. types that only own heap pointers and do not point to
+     * themselves), so that sc::vector shifts and reallocates them with memmove/memcpy.
+     */
     template <typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>{ };
+
+    /// Tells whether Allocator builds and destroys objects with plain placement new and destructor calls.
+    /*! True for allocators without `construct`/`destroy` members, for std::allocator (whose
+     * members, removed in C++20, only do placement new and call the destructor) and for
+     * std::pmr::polymorphic_allocator. Only then may sc::vector bypass allocator_traits with
+     * memcpy/memmove for trivially copyable or relocatable elements.
+     */
+    template <typename Allocator, typename = void>
+    struct uses_default_construct : std::true_type{ };
+
+    template <typename Allocator>
+    struct uses_default_construct<Allocator, std::void_t<decltype(std::declval<Allocator&>().construct(
+        std::declval<typename Allocator::value_type*>(), std::declval<typename Allocator::value_type&&>()))>>
+        : std::false_type{ };
+
+    template <typename U>
+    struct uses_default_construct<std::allocator<U>> : std::true_type{ };
+
+    template <typename U>
+    struct uses_default_construct<std::pmr::polymorphic_allocator<U>> : std::true_type{ };
+
+    /// Tells whether Allocator can grow a block in place through `bool expand(ptr, old_n, new_n)`.
+    /*! sc::vector tries it before reallocating, so growth keeps every element where it is. */
+    template <typename Allocator, typename = void>
+    struct has_expand : std::false_type{ };
+
+    template <typename Allocator>
+    struct has_expand<Allocator, std::void_t<decltype(std::declval<Allocator&>().expand(
+        std::declval<typename Allocator::value_type*>(), std::size_t(), std::size_t()))>>
+        : std::true_type{ };
+
+    /// Tells whether Allocator can resize a block, possibly moving it bitwise, through `T* reallocate(ptr, old_n, new_n)`.
+    /*! sc::vector uses it instead of allocate + relocate + deallocate when its elements are trivially relocatable. */
+    template <typename Allocator, typename = void>
+    struct has_reallocate : std::false_type{ };
+
+    template <typename Allocator>
+    struct has_reallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+        std::declval<typename Allocator::value_type*>(), std::size_t(), std::size_t()))>>
+        : std::true_type{ };
+
+    template <typename T, std::size_t N, typename Growth>
+    class small_vector;
+
+    /// Dynamic array. Allocator provides the storage; Growth (see growth_policy.h) decides how much it grows.
+    template <typename T, typename Allocator = std::allocator<T>, typename Growth = growth::doubling>
     class vector{
+        //=== small_vector exchanges heap blocks with sc::vector<T> directly.
+        template <typename U, std::size_t M, typename G>
+        friend class small_vector;
+
         public:
             using size_type = unsigned long; //!< The size type.
             using value_type = T; //!< The value type.
+            using allocator_type = Allocator; //!< The allocator type.
+            using growth_policy = Growth; //!< The growth policy type.
             using pointer = value_type*; //!< Pointer to a value stored in the container.
             using reference = value_type&; //!< Reference to a value stored in the container.
             using const_reference = const value_type&; //!< Const reference to a value stored
         //=== Private data
         private:
-            T *data; //!< Storage area. Allocates on the builder.
+            using alloc_traits = std::allocator_traits<Allocator>; //!< Access point to every allocator operation.
+
+            /// True when elements may be copied with memcpy instead of allocator_traits::construct.
+            static constexpr bool copy_bitwise = std::is_trivially_copyable<T>::value
+                                                 && uses_default_construct<Allocator>::value;
+            /// True when elements may be relocated with memmove instead of being moved one at a time.
+            static constexpr bool relocate_bitwise = is_trivially_relocatable<T>::value
+                                                     && uses_default_construct<Allocator>::value;
+            /// True when the allocator resizes blocks itself (e.g. with mremap), moving the elements bitwise.
+            static constexpr bool remap_growth = relocate_bitwise && has_reallocate<Allocator>::value;
+
+        //=== Private data
+        private:
+            T *data_; //!< Storage area. Allocates on the builder.
             size_type size_; //!< Number of elements currently in the vector.
-            size_type capacity_; //!< Maximum current vector capacity (if complete, doubles capacity).
-        
+            size_type capacity_; //!< Maximum current vector capacity (if complete, grows as Growth says).
+            Allocator alloc_; //!< Allocator that owns the storage area.
+
+        //=== Raw storage helpers
+        /* Only the first `size_` slots of `data_` hold live objects, the rest of the
+         * capacity is uninitialized memory: elements are built with
+         * allocator_traits::construct and destroyed explicitly, so reserving capacity
+         * never calls a constructor.
+         */
+        private:
+            /// Returns uninitialized storage for `n` objects of T (no constructor is called).
+            T* allocate(size_type n){
+                if(n == 0) return nullptr;
+                return alloc_traits::allocate(alloc_, n);
+            }
+
+            /// Releases storage of `n` objects obtained from allocate(). The objects in it must be already destroyed.
+            void deallocate(T *ptr, size_type n){
+                if(ptr != nullptr) alloc_traits::deallocate(alloc_, ptr, n);
+            }
+
+            /// Constructs an object from args in the uninitialized slot ptr.
+            template <typename... Args>
+            void construct(T *ptr, Args&&... args){
+                alloc_traits::construct(alloc_, ptr, std::forward<Args>(args)...);
+            }
+
+            /// Destroys the objects in [first, last) without releasing their storage.
+            void destroy(T *first, T *last){
+                if constexpr(!std::is_trivially_destructible<T>::value || !uses_default_construct<Allocator>::value){
+                    for(; first != last; first++){
+                        alloc_traits::destroy(alloc_, first);
+                    }
+                }
+            }
+
+            /// Copy-constructs the objects in [first, last) into the uninitialized storage at dest.
+            /*! If a copy throws, the copies already made are destroyed before the exception leaves. */
+            void copy_construct(const T *first, const T *last, T *dest){
+                if constexpr(copy_bitwise){
+                    if(first != last) std::memcpy(dest, first, (last-first) * sizeof(T));
+                }
+                else{
+                    T *start = dest;
+                    try{
+                        for(; first != last; first++, dest++){
+                            construct(dest, *first);
+                        }
+                    }
+                    catch(...){
+                        destroy(start, dest);
+                        throw;
+                    }
+                }
+            }
+
+            /// Copy-constructs the objects of the range [first, last) into the uninitialized storage at dest.
+            /*! Ranges given by plain pointers to T go through copy_construct(), hence memcpy when possible. */
+            template <typename InItr>
+            void construct_range(InItr first, InItr last, T *dest){
+                if constexpr(std::is_pointer<InItr>::value
+                             && std::is_same<std::remove_cv_t<std::remove_pointer_t<InItr>>, T>::value){
+                    copy_construct(first, last, dest);
+                }
+                else{
+                    for(; first != last; first++, dest++){
+                        construct(dest, *first);
+                    }
+                }
+            }
+
+            /// Moves the objects in [first, last) into the uninitialized storage at dest and destroys the originals.
+            /*! The ranges may overlap. Trivially relocatable types are moved with a single memmove;
+             * other types are moved one at a time (copied if their move constructor may throw).
+             */
+            void relocate(T *first, T *last, T *dest){
+                if constexpr(relocate_bitwise){
+                    if(first != last) std::memmove(static_cast<void*>(dest), first, (last-first) * sizeof(T));
+                }
+                else if(dest <= first){
+                    for(; first != last; first++, dest++){
+                        construct(dest, std::move_if_noexcept(*first));
+                        alloc_traits::destroy(alloc_, first);
+                    }
+                }
+                else{ //overlapping shift to the right: walk backwards
+                    for(dest += last-first; last != first; ){
+                        last--; dest--;
+                        construct(dest, std::move_if_noexcept(*last));
+                        alloc_traits::destroy(alloc_, last);
+                    }
+                }
+            }
+
+            /// Opens `n` uninitialized slots at position pos by shifting the tail to the right. Capacity must suffice.
+            void open_gap(size_type pos, size_type n){
+                relocate(&data_[pos], &data_[size_], &data_[pos+n]);
+            }
+
+            /// Destroys the elements in [first, last) and shifts the tail to the left to close the gap.
+            void close_gap(size_type first, size_type last){
+                destroy(&data_[first], &data_[last]);
+                relocate(&data_[last], &data_[size_], &data_[first]);
+                size_ -= last - first;
+            }
+
+        //=== Growth engine
+        /* Every operation that outgrows the current block goes through here: the new
+         * block is allocated once, each element is relocated once and the old block is
+         * released. Callers that add elements build them in the new block *before*
+         * calling adopt(), since the arguments may refer to the old buffer.
+         */
+            /// Returns the capacity to grow to so that at least `min_cap` elements fit, as the Growth policy decides.
+            size_type next_capacity(size_type min_cap) const{
+                size_type new_cap = Growth::next(capacity_, min_cap, sizeof(T));
+                return new_cap < min_cap ? min_cap : new_cap;
+            }
+
+            /// Relocates the elements into new_data, leaving `gap` slots before position `pos`, and releases the old block.
+            void adopt(T *new_data, size_type new_cap, size_type pos, size_type gap){
+                relocate(&data_[0], &data_[pos], &new_data[0]);
+                relocate(&data_[pos], &data_[size_], &new_data[pos+gap]);
+                deallocate(data_, capacity_);
+                data_ = new_data;
+                capacity_ = new_cap;
+            }
+
+            /// Grows the block, as the Growth policy decides, so that at least `min_cap` elements fit.
+            void grow_for(size_type min_cap){
+                if(min_cap <= capacity_) return;
+                size_type new_cap = next_capacity(min_cap);
+                if(!try_expand(new_cap)) reallocate(new_cap);
+            }
+
+            /// Tries to grow the current block in place to `new_cap` elements. Returns false if it must be reallocated.
+            bool try_expand(size_type new_cap){
+                if constexpr(has_expand<Allocator>::value){
+                    if(data_ != nullptr && alloc_.expand(data_, capacity_, new_cap)){
+                        capacity_ = new_cap;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /// Moves the elements into a block with room for exactly `new_cap` elements.
+            /*! Allocators with reallocate() resize the block themselves; elements are never touched one by one. */
+            void reallocate(size_type new_cap){
+                if constexpr(remap_growth){
+                    if(data_ != nullptr && new_cap != 0){
+                        data_ = alloc_.reallocate(data_, capacity_, new_cap);
+                        capacity_ = new_cap;
+                        return;
+                    }
+                }
+                adopt(allocate(new_cap), new_cap, size_, 0);
+            }
+
+            /// Takes over the storage of other, which is left empty. Our own storage must be already released.
+            void steal(vector& other) noexcept{
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+                other.capacity_ = 0;
+            }
+
         //=== Public interface
         public:
         //=== Constructors, Destructors, and Assignment.
             /// Default constructor that creates an empty list.
-            vector(){
-                data = new T[0];
+            vector() : vector(Allocator()){
+                /*empty*/
+            }
+
+            /// Creates an empty list that will obtain its storage from alloc.
+            explicit vector(const Allocator& alloc) : alloc_(alloc){
+                data_ = nullptr;
                 size_ = 0;
                 capacity_ = 0;
             }
 
             /// Constructs the list with count default-inserted instances of T.
-            explicit vector(size_type count){
-                data = new T[count];
+            explicit vector(size_type count, const Allocator& alloc = Allocator()) : alloc_(alloc){
+                data_ = allocate(count);
                 capacity_ = count;
                 size_ = 0;
             }
 
             /// Constructs the list with the contents of the range [first, last).
             template <typename InputIt>
-            vector(InputIt first, InputIt last){
-                data = new T[(last-first)*2]; //*2 because would end the capacity of the vector.
+            vector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : alloc_(alloc){
                 size_ = last-first;
-                capacity_ = size_*2; //*2 because would end the capacity of the vector.
+                capacity_ = size_;
+                data_ = allocate(capacity_);
                 for(auto i(0u); i < size_; i++){
-                    data[i] = *first;
+                    construct(&data_[i], *first);
                     first++;
                 }
             }
 
             /// Copy constructor. Constructs the list with the deep copy of the contents of other.
-            vector(const vector& other){
-                data = new T[other.capacity_];
+            vector(const vector& other)
+                : vector(other, alloc_traits::select_on_container_copy_construction(other.alloc_)){
+                /*empty*/
+            }
+
+            /// Constructs the list with the deep copy of the contents of other, using alloc for the storage.
+            vector(const vector& other, const Allocator& alloc) : alloc_(alloc){
+                data_ = allocate(other.capacity_);
                 size_ = other.size_;
                 capacity_ = other.capacity_;
-                for(auto i(0u); i < size_; i++){
-                    data[i] = other.data[i];
+                try{
+                    copy_construct(other.data_, other.data_+size_, data_);
+                }
+                catch(...){ //the destructor will not run: release the buffer here
+                    deallocate(data_, capacity_);
+                    throw;
+                }
+            }
+
+            /// Move constructor. Takes over the storage (and the allocator) of other, which is left empty.
+            vector(vector&& other) noexcept : alloc_(std::move(other.alloc_)){
+                steal(other);
+            }
+
+            /// Moves the contents of other into a list that uses alloc for the storage.
+            /*! The storage is taken over only if alloc can release it; otherwise the elements are moved one by one. */
+            vector(vector&& other, const Allocator& alloc) : alloc_(alloc){
+                data_ = nullptr;
+                size_ = 0;
+                capacity_ = 0;
+                if(alloc_ == other.alloc_){
+                    steal(other);
+                }
+                else{
+                    data_ = allocate(other.capacity_);
+                    capacity_ = other.capacity_;
+                    relocate(other.data_, other.data_+other.size_, data_);
+                    size_ = other.size_;
+                    other.size_ = 0;
                 }
             }
 
             /// Constructs the list with the contents of the initializer list init.
-            vector(std::initializer_list<T> ilist){
-                data = new T[ilist.size()];
+            vector(std::initializer_list<T> ilist, const Allocator& alloc = Allocator()) : alloc_(alloc){
+                data_ = allocate(ilist.size());
                 size_ = ilist.size();
                 capacity_ = size_;
                 //Copy the elements from ilist:
-                for(auto i(0u); i < ilist.size(); i++){ //or std::copy(data, data+(ilist.size), ilist);
-                    data[i] = *(ilist.begin()+i); //ilist[i];
+                try{
+                    copy_construct(ilist.begin(), ilist.end(), data_);
+                }
+                catch(...){
+                    deallocate(data_, capacity_);
+                    throw;
                 }
             }
 
             /// Destructs the list.
             ~vector(){
-                delete [] data;
+                destroy(data_, data_+size_);
+                deallocate(data_, capacity_);
                 size_ = 0;
                 capacity_ = 0;
             }
                 
 
             /// Copy assignment operator. Replaces the contents with a copy of the contents of other.
+            /*! The allocator is copied too when it propagates on copy assignment. */
             vector& operator=(const vector& other){
-                data = new T[other.capacity_];
-                size_ = other.size_;
-                capacity_ = other.capacity_;
-                for(auto i(0u); i < size_; i++){
-                    data[i] = other.data[i];
+                if(this == &other) return *this;
+                destroy(data_, data_+size_);
+                size_ = 0;
+                if constexpr(alloc_traits::propagate_on_container_copy_assignment::value){
+                    if(alloc_ != other.alloc_){ //the old storage must be released by the allocator that owns it
+                        deallocate(data_, capacity_);
+                        data_ = nullptr;
+                        capacity_ = 0;
+                    }
+                    alloc_ = other.alloc_;
                 }
+                if(capacity_ != other.capacity_){ //the old buffer is reused only if it has the same capacity
+                    deallocate(data_, capacity_);
+                    data_ = nullptr; //stays valid for the destructor if allocate() throws
+                    capacity_ = 0;
+                    data_ = allocate(other.capacity_);
+                    capacity_ = other.capacity_;
+                }
+                copy_construct(other.data_, other.data_+other.size_, data_);
+                size_ = other.size_; //only once the copies exist: if one throws, the list is left empty
                 return *this; //pointer pointing to the object itself so we can do "a = b = c".
             }
 
+            /// Move assignment operator. Replaces the contents with those of other, which is left empty.
+            /*! The storage changes hands in O(1) if the allocator propagates on move assignment or both
+             * allocators are equal; otherwise the elements are moved one by one into our own storage.
+             */
+            vector& operator=(vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value
+                                                       || alloc_traits::is_always_equal::value){
+                if(this == &other) return *this;
+                destroy(data_, data_+size_);
+                size_ = 0;
+                if(alloc_traits::propagate_on_container_move_assignment::value || alloc_ == other.alloc_){
+                    deallocate(data_, capacity_);
+                    if constexpr(alloc_traits::propagate_on_container_move_assignment::value){
+                        alloc_ = std::move(other.alloc_);
+                    }
+                    steal(other);
+                }
+                else{
+                    if(capacity_ < other.size_){
+                        deallocate(data_, capacity_);
+                        data_ = nullptr; //stays valid for the destructor if allocate() throws
+                        capacity_ = 0;
+                        data_ = allocate(other.capacity_);
+                        capacity_ = other.capacity_;
+                    }
+                    relocate(other.data_, other.data_+other.size_, data_);
+                    size_ = other.size_;
+                    other.size_ = 0;
+                }
+                return *this;
+            }
+
             /// Replaces the contents with those identified by initializer list ilist
             vector& operator=(std::initializer_list<T> ilist){
-                data = new T[ilist.size()];
-                size_ = ilist.size();
-                capacity_ = size_;
-                for(auto i(0u); i < ilist.size(); i++){ //or std::copy(data, data+(ilist.size), ilist);
-                    data[i] = *(ilist.begin()+i); //ilist[i];
+                destroy(data_, data_+size_);
+                size_ = 0;
+                if(capacity_ != ilist.size()){
+                    deallocate(data_, capacity_);
+                    data_ = nullptr;
+                    capacity_ = 0;
+                    data_ = allocate(ilist.size());
+                    capacity_ = ilist.size();
                 }
+                copy_construct(ilist.begin(), ilist.end(), data_);
+                size_ = ilist.size();
                 return *this;
             }
 
@@ -120,6 +463,7 @@ namespace sc{ // sc: Sequence container
 
             /// Remove (either logically or physically) all elements from the container.
             void clear(){
+                destroy(data_, data_+size_);
                 size_ = 0;
             }
 
@@ -130,37 +474,70 @@ namespace sc{ // sc: Sequence container
 
             /// Adds value to the front of the list.
             void push_front(const T &value){
-                T *first = data;
-                T *last = &data[size_];
-                vector<T> clone(first, last); //clone receives the data values
-                size_ += 1;
-                if(size_ >= capacity_){
-                    data = new T[size_*2];
-                    capacity_ *= 2;
-                }
-                for(size_t i(1); i < size_; i++){
-                    data[i] = clone.data[i-1];
-                }
-                data[0] = value;
+                insert(begin(), value);
+            }
+
+            /// Moves value to the front of the list.
+            void push_front(T &&value){
+                insert(begin(), std::move(value));
             }
             
             /// Adds value to the end of the list.
             void push_back(const T &value){
+                emplace_back(value);
+            }
+
+            /// Moves value to the end of the list.
+            void push_back(T &&value){
+                emplace_back(std::move(value));
+            }
+
+            /// Constructs a new element at the end of the list from args, in place.
+            template <typename... Args>
+            T& emplace_back(Args&&... args){
+                if(size_ < capacity_ || try_expand(next_capacity(size_+1))){
+                    construct(&data_[size_], std::forward<Args>(args)...);
+                }
+                else if constexpr(remap_growth){
+                    T item(std::forward<Args>(args)...); //args may live in the block that is about to move
+                    reallocate(next_capacity(size_+1));
+                    construct(&data_[size_], std::move(item));
+                }
+                else{
+                    size_type new_cap = next_capacity(size_+1);
+                    T *new_data = allocate(new_cap);
+                    construct(&new_data[size_], std::forward<Args>(args)...); //args may live in the old buffer
+                    adopt(new_data, new_cap, size_, 0);
+                }
                 size_ += 1;
-                if(size_ < capacity_){
-                    data[size_-1] = value;
+                return data_[size_-1];
+            }
+
+            /// Appends the elements of the range [first, last) to the end of the list.
+            /*! Forward ranges are counted first, so the list grows at most once and the elements are
+             * built straight in their final place; ranges of contiguous T are copied with memcpy when
+             * possible. Single-pass (input) ranges are appended one element at a time.
+             */
+            template <typename InItr>
+            void append_range(InItr first, InItr last){
+                using category = typename std::iterator_traits<InItr>::iterator_category;
+                if constexpr(std::is_base_of<std::forward_iterator_tag, category>::value){
+                    size_type n = std::distance(first, last);
+                    if(size_+n > capacity_ && !try_expand(next_capacity(size_+n))){
+                        size_type new_cap = next_capacity(size_+n);
+                        T *new_data = allocate(new_cap);
+                        construct_range(first, last, &new_data[size_]); //the range may live in the old buffer
+                        adopt(new_data, new_cap, size_, 0);
+                    }
+                    else{
+                        construct_range(first, last, &data_[size_]);
+                    }
+                    size_ += n;
                 }
                 else{
-                    T *first = data;
-                    T *last;
-                    last = &data[size_];
-                    vector<int> clone(first, last);
-                    data = new T[size_*2];
-                    for(auto i(0u); i < size_-1; i++){
-                        data[i] = clone.data[i];
+                    for(; first != last; first++){
+                        emplace_back(*first);
                     }
-                    data[size_-1] = value;
-                    capacity_ *= 2;
                 }
             }
 
@@ -168,48 +545,49 @@ namespace sc{ // sc: Sequence container
             void pop_back(){
                 if(size_ > 0){
                     size_ -= 1;
+                    alloc_traits::destroy(alloc_, &data_[size_]);
                 }
             }
 
             /// Removes the object at the front of the list.
             void pop_front(){
                 if(size_ > 0){
-                    for(size_t i(1); i < size_; i++){
-                        data[i-1] = data[i];
-                    }
-                    size_ -= 1;
+                    close_gap(0, 1);
                 }
             }
 
             /// Returns the object at the end of the list.
             const T& back() const{
-                return data[size_-1];
+                return data_[size_-1];
             }
 
             /// Returns the object at the end of the list.
             T& back(){
-                return data[size_-1];
+                return data_[size_-1];
             }
 
             /// Returns the object at the beginning of the list.
             const T& front() const{
-                return data[0];
+                return data_[0];
             }
 
             /// Returns the object at the beginning of the list.
             T& front(){
-                return data[0];
+                return data_[0];
             }
 
             /// Replaces the content of the list with count copies of value.
             void assign(size_type count, const T& value){
+                destroy(data_, data_+size_);
+                size_ = 0;
                 if(capacity_ < count){
-                    data = new T[count];
+                    deallocate(data_, capacity_);
+                    data_ = allocate(count);
                     capacity_ = count;
                 }
 
                 for(auto i(0u); i < count; i++){
-                    data[i] = value;
+                    construct(&data_[i], value);
                 }
 
                 size_ = count;
@@ -218,12 +596,12 @@ namespace sc{ // sc: Sequence container
         //=== Operations exclusive to dynamic array implementation
             /// Returns the object at the index pos in the array, with no bounds-checking.
             T & operator[](size_type pos){
-                return data[pos];
+                return data_[pos];
             }
 
             /// Returns the object at the index pos in the array, with no bounds-checking.
             const T & operator[](size_type pos) const{
-                return data[pos];
+                return data_[pos];
             }
 
             /// Returns the object at the index pos in the array, with bounds-checking.
@@ -235,7 +613,7 @@ namespace sc{ // sc: Sequence container
                 if(pos >= size_){
                     throw std::out_of_range("[vector::at()] Position entered beyond vector boundaries.");
                 }
-                return data[pos];
+                return data_[pos];
             }
 
             /// Returns the object at the index pos in the array, with bounds-checking.
@@ -247,7 +625,7 @@ namespace sc{ // sc: Sequence container
                 if(pos >= size_){
                     throw std::out_of_range("[vector::at()] Position entered beyond vector boundaries.");
                 }
-                return data[pos];
+                return data_[pos];
             }
 
             /// Return the internal storage capacity of the array.
@@ -258,350 +636,527 @@ namespace sc{ // sc: Sequence container
             /// Increase the storage capacity of the array to the value `new_cap` if it is greater than the current capacity()
             void reserve(size_t new_cap){
                 if(new_cap <= capacity_) return; //do nothing
-                T *first = data;
-                T *last = &data[size_];
-                vector<int> clone(first, last);
-                data = new T[new_cap];
-                for(auto i(0u); i < size_; i++){
-                    data[i] = clone.data[i];
+                if(try_expand(new_cap)) return;
+                reallocate(new_cap);
+            }
+
+            /// Resizes the list to count elements. New elements are value-initialized (zeroed for trivial types).
+            void resize(size_type count){
+                if(count <= size_){
+                    destroy(&data_[count], &data_[size_]);
+                    size_ = count;
+                    return;
                 }
-                capacity_ = new_cap;
+                grow_for(count);
+                for(; size_ < count; size_++){
+                    construct(&data_[size_]);
+                }
+            }
+
+            /// Resizes the list to count elements. New elements are copies of value.
+            void resize(size_type count, const T& value){
+                if(count <= size_){
+                    destroy(&data_[count], &data_[size_]);
+                    size_ = count;
+                    return;
+                }
+                if(count > capacity_){
+                    T item(value); //value may live in the block that is about to move
+                    grow_for(count);
+                    for(; size_ < count; size_++){
+                        construct(&data_[size_], item);
+                    }
+                    return;
+                }
+                for(; size_ < count; size_++){
+                    construct(&data_[size_], value);
+                }
+            }
+
+            /// Resizes the list to count elements, default-initializing the new ones.
+            /*! Elements of trivially default constructible types are left uninitialized, whatever the
+             * allocator (default-initializing them does nothing), so a buffer can be sized once and
+             * then filled directly by read()/memcpy. Other types are built through an allocator that
+             * has its own construct(), and with placement new otherwise.
+             */
+            void resize_for_overwrite(size_type count){
+                if(count <= size_){
+                    destroy(&data_[count], &data_[size_]);
+                    size_ = count;
+                    return;
+                }
+                grow_for(count);
+                if constexpr(std::is_trivially_default_constructible<T>::value){
+                    /*nothing to build: the new elements are left as the allocator returned them*/
+                }
+                else if constexpr(!uses_default_construct<Allocator>::value){
+                    for(; size_ < count; size_++){
+                        construct(&data_[size_]);
+                    }
+                }
+                else{
+                    for(; size_ < count; size_++){
+                        new (static_cast<void*>(&data_[size_])) T;
+                    }
+                }
+                size_ = count;
             }
 
             /// Requests the removal of unused capacity. It is a non-binding request to reduce capacity() to size().
             void shrink_to_fit(){
-                capacity_ = size_;
+                if(size_ == capacity_) return;
+                reallocate(size_);
             }            
             
         //=== Iterators
-            class iterator{ //From category "Biderectional"
+            /// Contiguous (random access) iterator: a thin wrapper around a pointer to an element.
+            /*! `basic_iterator<T>` is the iterator and `basic_iterator<const T>` the const_iterator;
+             * an iterator converts implicitly to a const_iterator, and both can be compared.
+             * Standard algorithms (std::sort, std::lower_bound, std::distance...) run at pointer speed.
+             */
+            template <typename U>
+            class basic_iterator{
                 public:
-                    typedef T& reference; //!< Reference to the value type.
-                    typedef T* pointer; //!< Pointer to the value type.
+                    typedef U& reference; //!< Reference to the value type.
+                    typedef U* pointer; //!< Pointer to the value type.
                     typedef T value_type; //!< Value type the iterator points to.
                     /// Difference type used to calculated distance between iterators.
                     typedef std::ptrdiff_t difference_type;
                     /// Identifies the iterator category to algorithms from STL
-                    typedef std::bidirectional_iterator_tag iterator_category; //!< Iterator category.
+                    typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+#if __cplusplus > 201703L
+                    typedef std::contiguous_iterator_tag iterator_concept; //!< The elements are contiguous in memory.
+#endif
                 //=== Private data
                 private:
-                    T *it;
+                    U *it;
+
+                    template <typename> friend class basic_iterator;
                 //=== Public interface
                 public:
                     /// Constructor
-                    iterator(T *ptr = nullptr) : it{ptr}{
+                    basic_iterator(U *ptr = nullptr) : it{ptr}{
+                       /*empty*/
+                    }
+
+                    /// Converts an iterator into a const_iterator.
+                    template <typename V, typename = std::enable_if_t<std::is_same<const V, U>::value && !std::is_same<V, U>::value>>
+                    basic_iterator(const basic_iterator<V> &other) : it{other.it}{
                        /*empty*/
                     }
 
                 //=== Iterator operations
                     /// Advances iterator to the next location within the vector: ++it
-                    iterator operator++(void){
-                        //Returns new iterator that points to the next address
-                        return iterator(++it);
-                        //or ++ptr; return *this;
+                    basic_iterator& operator++(){
+                        ++it;
+                        return *this;
                     }
 
                     /// Advances iterator to the next location within the vector: it++
-                    iterator operator++(int){
-                        it++;
-                        return iterator(it-1);
+                    basic_iterator operator++(int){
+                        return basic_iterator(it++);
                     }
 
-                    /// Pre increment: --it
-                    iterator operator--(void){
-                        return iterator (--it);
+                    /// Moves iterator to the previous location within the vector: --it
+                    basic_iterator& operator--(){
+                        --it;
+                        return *this;
                     }
 
-                    /// Post increment: it--
-                    iterator operator--(int){
-                        iterator temp(it); // Creates a temporary iterator with the current address.
-                        it++;
-                        return temp;
+                    /// Moves iterator to the previous location within the vector: it--
+                    basic_iterator operator--(int){
+                        return basic_iterator(it--);
                     }
 
-                    /// Return a reference to the object located at the position pointed by the iterator
-                    reference operator*(void){ //*it = x;
-                        return *it;
+                    /// Advances iterator n locations.
+                    basic_iterator& operator+=(difference_type n){
+                        it += n;
+                        return *this;
+                    }
+
+                    /// Moves iterator n locations back.
+                    basic_iterator& operator-=(difference_type n){
+                        it -= n;
+                        return *this;
                     }
 
                     /// Return a reference to the object located at the position pointed by the iterator
-                    const T& operator*(void) const{ //x = *it;
+                    reference operator*() const{
                         return *it;
                     }
-                    
-                    /// Return the difference between two iterators.
-                    difference_type operator-(const iterator &rhs){
-                        return it - rhs.it;
+
+                    /// Return a pointer to the object located at the position pointed by the iterator.
+                    pointer operator->() const{
+                        return it;
                     }
 
-                    /// Return a iterator pointing to the n-th successor in the vector from it.
-                    friend iterator operator+(int n, iterator it){
-                        return it.it + n;
+                    /// Return a reference to the object n locations away from the iterator.
+                    reference operator[](difference_type n) const{
+                        return it[n];
                     }
-                    
-                    /// Return a iterator pointing to the n-th successor in the vector from it.
-                    friend iterator operator+(iterator it, int n){
-                        return it.it + n;
+
+                    /// Return the difference between two iterators.
+                    friend difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return lhs.it - rhs.it;
                     }
 
-                    /// Return a iterator pointing to the n-th predecessor in the vector from it
-                    friend iterator operator-(int n, iterator it){
-                        return it.it - n;
+                    /// Return a iterator pointing to the n-th successor in the vector from it.
+                    friend basic_iterator operator+(difference_type n, basic_iterator it){
+                        return it += n;
                     }
 
-                    /// Return a iterator pointing to the n-th predecessor in the vector from it
-                    friend iterator operator-(iterator it, int n){
-                        return it.it - n;
+                    /// Return a iterator pointing to the n-th successor in the vector from it.
+                    friend basic_iterator operator+(basic_iterator it, difference_type n){
+                        return it += n;
                     }
 
-                    /// Return a pointer to the location in the vector the it points to.
-                    iterator operator->(){
-                        return *it;
+                    /// Return a iterator pointing to the n-th predecessor in the vector from it
+                    friend basic_iterator operator-(basic_iterator it, difference_type n){
+                        return it -= n;
                     }
 
                     /// Returns true if both iterators refer to the same location within the vector, and false otherwise.
-                    bool operator==(const iterator &ptr) const{
-                        return this->it == ptr.it;
+                    friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return lhs.it == rhs.it;
                     }
 
                     /// Returns true if both iterators refer to a different location within the vector, and false otherwise.
-                    bool operator!=(const iterator &ptr) const{
-                        return this->it != ptr.it;
+                    friend bool operator!=(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return lhs.it != rhs.it;
                     }
 
-            };
-            class const_iterator{
-                //=== Private data
-                private:
-                    const T *it;
-                //=== Public interface
-                public:
-                    /// Constructor
-                    const_iterator(const T *ptr = nullptr) : it{ptr}{
-                       /*empty*/
-                    }     
-
-                //=== Const_iterator operations
-                    /// Advances iterator to the next location within the vector: ++it
-                    const_iterator operator++(void){
-                        //Returns new iterator that points to the next address
-                        return const_iterator(++it);
-                        //or ++ptr; return *this;
+                    /// Returns true if lhs refers to an earlier location than rhs.
+                    friend bool operator<(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return lhs.it < rhs.it;
                     }
 
-                    /// Advances iterator to the next location within the vector: it++
-                    const_iterator operator++(int){
-                        it++;
-                        return const_iterator(it-1);
+                    /// Returns true if lhs refers to a later location than rhs.
+                    friend bool operator>(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return lhs.it > rhs.it;
                     }
 
-                    /// Pre increment: --it
-                    const_iterator operator--(void){
-                        return const_iterator(--it);
+                    /// Returns true if lhs does not refer to a later location than rhs.
+                    friend bool operator<=(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return lhs.it <= rhs.it;
                     }
 
-                    /// Post increment: it--
-                    const_iterator operator--(int){
-                        const_iterator temp(it);
-                        it++;
-                        return temp;
-                    }
-
-                    /// Return a reference to the object located at the position pointed by the const_iterator.
-                    reference operator*(void){ //*it = x;
-                        return *it;
+                    /// Returns true if lhs does not refer to an earlier location than rhs.
+                    friend bool operator>=(const basic_iterator &lhs, const basic_iterator &rhs){
+                        return lhs.it >= rhs.it;
                     }
-
-                    /// Return a reference to the object located at the position pointed by the const_iterator.
-                    const T& operator*(void) const{ //x = *it;
-                        return *it;
-                    }    
             };
 
+            using iterator = basic_iterator<T>; //!< Iterator over the elements.
+            using const_iterator = basic_iterator<const T>; //!< Constant iterator over the elements.
+            using reverse_iterator = std::reverse_iterator<iterator>; //!< Iterator from the last element to the first.
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>; //!< Constant reverse iterator.
+
         //=== Getting an iterator
             /// Returns an iterator pointing to the first item in the list
             iterator begin(){
-                return iterator(&data[0]);
+                return iterator(data_);
             }
 
             /// Returns an iterator pointing to the end mark in the list
             iterator end(){
-                return iterator(&data[size_]);
+                return iterator(data_+size_);
             }
 
             /// Returns a constant iterator pointing to the first item in the list.
-            const_iterator cbegin(){
-                return const_iterator(&data[0]);
+            const_iterator begin() const{
+                return const_iterator(data_);
+            }
+
+            /// Returns a constant iterator pointing to the end mark in the list.
+            const_iterator end() const{
+                return const_iterator(data_+size_);
+            }
+
+            /// Returns a constant iterator pointing to the first item in the list.
+            const_iterator cbegin() const{
+                return const_iterator(data_);
             }
 
             /// Returns a constant iterator pointing to the end mark in the list
-            const_iterator cend(){
-                return const_iterator(&data[size_]);
+            const_iterator cend() const{
+                return const_iterator(data_+size_);
+            }
+
+            /// Returns a reverse iterator pointing to the last item in the list.
+            reverse_iterator rbegin(){
+                return reverse_iterator(end());
+            }
+
+            /// Returns a reverse iterator pointing before the first item in the list.
+            reverse_iterator rend(){
+                return reverse_iterator(begin());
+            }
+
+            /// Returns a constant reverse iterator pointing to the last item in the list.
+            const_reverse_iterator rbegin() const{
+                return const_reverse_iterator(end());
+            }
+
+            /// Returns a constant reverse iterator pointing before the first item in the list.
+            const_reverse_iterator rend() const{
+                return const_reverse_iterator(begin());
+            }
+
+            /// Returns a constant reverse iterator pointing to the last item in the list.
+            const_reverse_iterator crbegin() const{
+                return rbegin();
+            }
+
+            /// Returns a constant reverse iterator pointing before the first item in the list.
+            const_reverse_iterator crend() const{
+                return rend();
+            }
+
+            /// Returns a pointer to the underlying array: [data(), data()+size()) are the elements.
+            T* data(){
+                return data_;
+            }
+
+            /// Returns a pointer to the underlying array: [data(), data()+size()) are the elements.
+            const T* data() const{
+                return data_;
             }
 
 
         //=== List container operations that require iterators
             /// Adds value into the list before the position given by the iterator pos
             iterator insert(iterator pos, const T & value){
-                int tamanho = pos - begin();
-                // if(tamanho > capacity_) return NULL;
-                iterator first = &data[tamanho];
-                iterator last = &data[size_];
-                vector<T> clone(first, last); //clone receives the data values
-                size_ +=  1;
-                if(size_ >= capacity_){
-                    sc::vector<T> secondClone(&data[0], &data[size_-1]);
-                    data = new T[size_*2];
-                    capacity_ *= 2;
-                    for(auto i(0u); i < size_-1; i++){
-                        data[i] = secondClone.data[i];
-                    }
-                }
-                int cont = 0;
-                data[tamanho] = value;
-                for(auto i(&data[tamanho+1]); i < &data[size_]; i++){
-                    *i = clone.data[cont];
-                    cont++;
+                return emplace(pos, value);
+            }
+
+            /// Moves value into the list before the position given by the iterator pos
+            iterator insert(iterator pos, T && value){
+                return emplace(pos, std::move(value));
+            }
+
+            /// Constructs a new element from args, in place, before the position given by the iterator pos
+            template <typename... Args>
+            iterator emplace(iterator pos, Args&&... args){
+                size_type tamanho = pos - begin();
+                if(size_ == capacity_ && !try_expand(next_capacity(size_+1))){
+                    if constexpr(remap_growth){
+                        T item(std::forward<Args>(args)...); //args may live in the block that is about to move
+                        reallocate(next_capacity(size_+1));
+                        open_gap(tamanho, 1);
+                        construct(&data_[tamanho], std::move(item));
+                    }
+                    else{
+                        size_type new_cap = next_capacity(size_+1);
+                        T *new_data = allocate(new_cap);
+                        construct(&new_data[tamanho], std::forward<Args>(args)...); //args may live in the old buffer
+                        adopt(new_data, new_cap, tamanho, 1);
+                    }
                 }
-                return pos;
+                else if(tamanho == size_){
+                    construct(&data_[size_], std::forward<Args>(args)...);
+                }
+                else{
+                    T item(std::forward<Args>(args)...); //args may refer to one of the tail elements
+                    open_gap(tamanho, 1);
+                    construct(&data_[tamanho], std::move(item));
+                }
+                size_ += 1;
+                return iterator(&data_[tamanho]);
             }
 
             /// Inserts elements from the range [first; last) before pos
             template < typename InItr>
             iterator insert(iterator pos, InItr first, InItr last){
                 if(size_t(pos - begin()) <= size_){
-                    int tamanho = pos - begin();
-                    int diff = last-first;
-                    T *aux = new T[end() - pos];
-                    std::copy(pos, end(), aux);
-                    if(size_+(diff) > capacity_){
-                        reserve((size_+(diff))*2);
-                        capacity_ = (size_+(diff))*2;
+                    size_type tamanho = pos - begin();
+                    size_type start = tamanho;
+                    size_type diff = last-first;
+                    if(size_+diff > capacity_ && !try_expand(next_capacity(size_+diff))){
+                        size_type new_cap = next_capacity(size_+diff);
+                        T *new_data = allocate(new_cap);
+                        construct_range(first, last, &new_data[tamanho]); //the range may live in the old buffer
+                        adopt(new_data, new_cap, tamanho, diff);
+                        size_ += diff;
+                        return iterator(&data_[start]);
                     }
+                    open_gap(tamanho, diff);
+                    construct_range(first, last, &data_[tamanho]);
                     size_ += diff;
-                    while(first != last){
-                        data[tamanho] = *first;
-                        first++;
-                        tamanho++;
-                    }
-                    int idx = 0;
-                    for(size_t i = tamanho; i < size_; i++){
-                        data[i] = aux[idx];
-                        idx++;
-                    }
-                    delete [] aux;
-                    return pos;
+                    return iterator(&data_[start]);
                 }
                 return end();
             }
 
             /// Inserts elements from the initializer list ilist before pos
             iterator insert(iterator pos, std::initializer_list<T> ilist){
-                if(size_t(pos - begin()) <= size_){
-                    int tamanho = pos - begin();
-                    T *aux = new T[end() - pos];
-                    std::copy(pos, end(), aux);
-                    if(ilist.size()+size_ > capacity_){
-                        reserve((ilist.size()+size_)*2);
-                        capacity_ = (ilist.size()+size_)*2;
-                    }
-                    size_ += ilist.size();
-
-                    auto first = ilist.begin();
-                    auto last = ilist.end();
-
-                    while(first != last){
-                        data[tamanho] = *first;
-                        first++;
-                        tamanho++;
-                    }
-                    int idx = 0;
-                    for(size_t i = tamanho; i < size_; i++){
-                        data[i] = aux[idx];
-                        idx++;
-                    }
-                    delete [] aux;
-                    return pos;
-                }
-                return end();
+                return insert(pos, ilist.begin(), ilist.end());
             }
 
             /// Removes the object at position pos
             iterator erase(iterator pos){
-                for(auto i(&data[pos-data]); i < &data[size_-1]; i++){
-                    *i = *(i+1);
-                }
-                size_ -= 1;
+                size_type tamanho = pos - begin();
+                close_gap(tamanho, tamanho+1);
                 return pos;
             }
             
             /// Removes elements in the range [first; last)
             iterator erase(iterator first, iterator last){
-                int tamanhoF = first - begin();
-                int tamanhoL = last - begin();
-                int distance = end() - last;
-                int cont = 0;
-                while(cont < distance){
-                    data[tamanhoF] = data[tamanhoL];
-                    tamanhoF += 1;
-                    tamanhoL += 1;
-                    cont += 1;
-                }
-                size_ -= last - first;
+                size_type tamanhoF = first - begin();
+                size_type tamanhoL = last - begin();
+                close_gap(tamanhoF, tamanhoL);
                 return first;
             }
 
             /// Replaces the contents of the list with the elements from the initializer list ilist
             void assign(std::initializer_list<T> ilist){
-                data = new T[ilist.size()*2];
+                destroy(data_, data_+size_);
+                size_ = 0;
+                if(capacity_ < ilist.size()){
+                    deallocate(data_, capacity_);
+                    data_ = allocate(ilist.size());
+                    capacity_ = ilist.size();
+                }
                 size_ = ilist.size();
-                capacity_ = size_*2;
-                for(auto i(0u); i < ilist.size(); i++){ //or std::copy(data, data+(ilist.size), ilist);
-                    data[i] = *(ilist.begin()+i); //ilist[i];
+                for(auto i(0u); i < ilist.size(); i++){
+                    construct(&data_[i], *(ilist.begin()+i)); //ilist[i];
                 }
             }
 
+            /// Exchanges the contents of the list with those of other, without moving any element.
+            /*! The allocators are exchanged only if they propagate on swap; otherwise they must be equal. */
+            void swap(vector& other) noexcept{
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                std::swap(capacity_, other.capacity_);
+                if constexpr(alloc_traits::propagate_on_container_swap::value){
+                    using std::swap;
+                    swap(alloc_, other.alloc_);
+                }
+            }
+
+            /// Returns the allocator associated with the container.
+            allocator_type get_allocator() const{
+                return alloc_;
+            }
+
             friend std::ostream& operator<<(std::ostream& os, const vector& v){
                 os << "[ ";
-                std::copy(&v.data[0], &v.data[v.size_], std::ostream_iterator<T>(os, " "));
-                os << "| ";
-                std::copy(&v.data[v.size_], &v.data[v.capacity_], std::ostream_iterator<T>(os, " "));
-                os << "]";
+                std::copy(&v.data_[0], &v.data_[v.size_], std::ostream_iterator<T>(os, " "));
+                os << "]"; //the capacity region past size_ holds no objects, so it is not printed
 
                 return os;
             }
 
     };
     //=== Operator overloading — non-member functions
-        /// Checks if the contents of lhs and rhs are equal.
+    namespace detail{
+        /// True for element types whose equality is equality of their bytes: integers, enums and pointers.
+        /*! Floating point types are excluded (0.0 == -0.0, NaN != NaN), and so are class types,
+         * whose operator== may say otherwise.
+         */
         template <typename T>
-        bool operator==(const sc::vector<T>& lhs, const sc::vector<T>& rhs){
-            if(lhs.size() == rhs.size()){
-                for(size_t i = 0; i < lhs.size(); i++){
-                    if(lhs[i] != rhs[i])
-                        return false;
-                }
-                return true;
+        struct bitwise_comparable : std::integral_constant<bool,
+            (std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value)
+            && std::has_unique_object_representations<T>::value>{ };
+
+        /// Returns the index of the first element that differs between a and b, or n if all n are equal.
+        /*! Bitwise comparable elements are scanned with the SIMD byte kernel. */
+        template <typename T>
+        std::size_t mismatch(const T *a, const T *b, std::size_t n){
+            if constexpr(bitwise_comparable<T>::value){
+                return n == 0 ? 0 : simd::mismatch_bytes(a, b, n * sizeof(T)) / sizeof(T);
             }
             else{
-                return false;
+                std::size_t i = 0;
+                while(i < n && a[i] == b[i]) i++;
+                return i;
             }
         }
 
-        /// Similar to the previous operator, but the opposite result.
+        /// Lexicographic comparison: negative if a < b, zero if they are equal, positive if a > b.
         template <typename T>
-        bool operator!=(const sc::vector<T>& lhs, const sc::vector<T>& rhs){
-            if(lhs.size() == rhs.size()){
+        int compare(const T *a, std::size_t na, const T *b, std::size_t nb){
+            std::size_t n = na < nb ? na : nb;
+            if constexpr(bitwise_comparable<T>::value){
+                std::size_t i = mismatch(a, b, n);
+                if(i < n) return a[i] < b[i] ? -1 : 1;
+            }
+            else{
+                for(std::size_t i = 0; i < n; i++){
+                    if(a[i] < b[i]) return -1;
+                    if(b[i] < a[i]) return 1;
+                }
+            }
+            return na < nb ? -1 : (na > nb ? 1 : 0);
+        }
+    }
+
+        /// Checks if the contents of lhs and rhs are equal.
+        /*! Integers, enums and pointers are compared with memcmp, which libc runs with its widest vector unit. */
+        template <typename T, typename Allocator, typename Growth>
+        bool operator==(const sc::vector<T, Allocator, Growth>& lhs, const sc::vector<T, Allocator, Growth>& rhs){
+            if(lhs.size() != rhs.size()) return false;
+            if constexpr(detail::bitwise_comparable<T>::value){
+                return lhs.size() == 0 || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+            }
+            else{
                 for(size_t i = 0; i < lhs.size(); i++){
                     if(lhs[i] != rhs[i])
-                        return true;
+                        return false;
                 }
-                return false;
+                return true;
+            }
+        }
+
+        /// Exchanges the contents of lhs and rhs.
+        template <typename T, typename Allocator, typename Growth>
+        void swap(sc::vector<T, Allocator, Growth>& lhs, sc::vector<T, Allocator, Growth>& rhs) noexcept{
+            lhs.swap(rhs);
+        }
+
+        /// Similar to the previous operator, but the opposite result.
+        template <typename T, typename Allocator, typename Growth>
+        bool operator!=(const sc::vector<T, Allocator, Growth>& lhs, const sc::vector<T, Allocator, Growth>& rhs){
+            return !(lhs == rhs);
+        }
+
+        /// Checks if lhs is lexicographically less than rhs.
+        /*! Integers, enums and pointers look for the first difference with the SIMD kernel of simd.h. */
+        template <typename T, typename Allocator, typename Growth>
+        bool operator<(const sc::vector<T, Allocator, Growth>& lhs, const sc::vector<T, Allocator, Growth>& rhs){
+            return detail::compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+        }
+
+        /// Checks if lhs is lexicographically greater than rhs.
+        template <typename T, typename Allocator, typename Growth>
+        bool operator>(const sc::vector<T, Allocator, Growth>& lhs, const sc::vector<T, Allocator, Growth>& rhs){
+            return rhs < lhs;
+        }
+
+        /// Checks if lhs is lexicographically less than or equal to rhs.
+        template <typename T, typename Allocator, typename Growth>
+        bool operator<=(const sc::vector<T, Allocator, Growth>& lhs, const sc::vector<T, Allocator, Growth>& rhs){
+            return !(rhs < lhs);
+        }
+
+        /// Checks if lhs is lexicographically greater than or equal to rhs.
+        template <typename T, typename Allocator, typename Growth>
+        bool operator>=(const sc::vector<T, Allocator, Growth>& lhs, const sc::vector<T, Allocator, Growth>& rhs){
+            return !(lhs < rhs);
+        }
+
+#if defined(__cpp_lib_three_way_comparison) && __cpp_lib_three_way_comparison >= 201907L
+        /// Three-way lexicographic comparison (C++20).
+        template <typename T, typename Allocator, typename Growth>
+        auto operator<=>(const sc::vector<T, Allocator, Growth>& lhs, const sc::vector<T, Allocator, Growth>& rhs){
+            if constexpr(detail::bitwise_comparable<T>::value){
+                return detail::compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) <=> 0;
             }
             else{
-                return true;
+                return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
             }
         }
+#endif
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -37,7 +37,7 @@ int main(void){
         assert(v[1] == 2);
         assert(v[2] == 3);
         assert(v.size() == 3);
-        assert(v.capacity() == 6);
+        assert(v.capacity() == 3);
     /// #Test 4: vector(const vector& other);
         sc::vector<int>v5(array_v4);
         assert(v5.size() == 3);
@@ -80,7 +80,7 @@ int main(void){
         assert(v8[1] == 7);
     /// Test #8: const T& back() const;
         assert(v7.back() == 5);
-        assert(v1.back() == 0);
+        assert(v8.back() == 7);
     /// Test #9: const T& front() const;
         assert(v7.front() == 2);
     /// Test #10: void assign(sizet_type count, const T &value);
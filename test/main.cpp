@@ -1,9 +1,38 @@
 #include <iterator>             // std::begin(), std::end()
 #include <functional>           // std::function
 #include <algorithm>            // std::min_element
+#include <numeric>              // std::accumulate
+#include <sstream>              // std::ostringstream
+#include <fstream>              // std::ifstream, std::ofstream
+#include <string>               // std::string
+#include <memory_resource>      // std::pmr
+#include <cstdint>              // std::uint64_t
+#include <cstring>              // std::memcpy
+#include <cmath>                // std::isinf
+#include <limits>               // std::numeric_limits
+#include <thread>               // std::thread
+#include <atomic>               // std::atomic
+#include <fcntl.h>              // open()
+#include <unistd.h>             // close(), lseek()
 
 #include "gtest/gtest.h"        // gtest lib
 #include "../include/vector.h"   // header file for tested functions
+#include "../include/arena.h"    // sc::arena
+#include "../include/small_vector.h" // sc::small_vector
+#include "../include/mmap_allocator.h" // sc::mmap_allocator
+#include "../include/devector.h" // sc::devector
+#include "../include/ring_vector.h" // sc::ring_vector
+#include "../include/gap_vector.h" // sc::gap_vector
+#include "../include/numeric.h" // sc::numeric
+#include "../include/parallel.h" // sc::parallel
+#include "../include/sort.h" // sc::sort
+#include "../include/soa_vector.h" // sc::soa_vector
+#include "../include/stable_vector.h" // sc::stable_vector
+#include "../include/mmap_vector.h" // sc::mmap_vector
+#include "../include/serialize.h" // sc::save, sc::load, sc::view
+#include "../include/text.h" // sc::write_text, sc::parse_text
+#include "../include/concurrent_vector.h" // sc::concurrent_vector
+#include "../include/cow_vector.h" // sc::cow_vector
 
 
 
@@ -580,6 +609,2395 @@ TEST(IntVector, ErasePos)
     ASSERT_EQ( vec.size() , 4 );
 }
 
+TEST(IntVector, RandomAccessIterators)
+{
+    sc::vector<int> vec { 5, 3, 1, 4, 2 };
+    static_assert( std::is_same< std::iterator_traits< sc::vector<int>::iterator >::iterator_category,
+                                 std::random_access_iterator_tag >::value, "" );
+    std::sort( vec.begin(), vec.end() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
+    EXPECT_EQ( *std::lower_bound( vec.begin(), vec.end(), 4 ), 4 );
+    EXPECT_EQ( std::distance( vec.begin(), vec.end() ), 5 );
+
+    auto it = vec.begin();
+    it += 3;
+    EXPECT_EQ( *it, 4 );
+    EXPECT_EQ( it[1], 5 );
+    EXPECT_EQ( *it--, 4 );
+    EXPECT_EQ( *it, 3 );
+    EXPECT_EQ( *--it, 2 );
+    EXPECT_TRUE( vec.begin() < it );
+    EXPECT_TRUE( vec.end() >= it );
+    EXPECT_EQ( vec.end() - it, 4 );
+    EXPECT_EQ( 2 + vec.begin(), vec.end() - 3 );
+}
+
+TEST(IntVector, ConstIterators)
+{
+    sc::vector<std::string> words { "a", "bb", "ccc" };
+    sc::vector<std::string>::const_iterator cit = words.begin();
+    EXPECT_TRUE( cit == words.cbegin() );
+    EXPECT_TRUE( words.begin() != words.cend() );
+    EXPECT_EQ( cit->size(), 1 );
+    words.begin()->append( "!" );
+    EXPECT_EQ( words[0], "a!" );
+
+    const sc::vector<std::string> & cref = words;
+    std::string joined;
+    for ( const auto & w : cref )
+        joined += w;
+    EXPECT_EQ( joined, "a!bbccc" );
+    EXPECT_EQ( std::count_if( cref.begin(), cref.end(), []( const std::string & w ){ return w.size() > 1; } ), 3 );
+    EXPECT_FALSE( ( std::is_assignable< decltype( *cref.begin() ), std::string >::value ) );
+}
+
+TEST(IntVector, ReverseIteratorsAndData)
+{
+    sc::vector<int> vec { 1, 2, 3 };
+    sc::vector<int> reversed( vec.rbegin(), vec.rend() );
+    EXPECT_EQ( reversed , ( sc::vector<int>{ 3, 2, 1 } ) );
+    EXPECT_EQ( *vec.crbegin(), 3 );
+    EXPECT_EQ( vec.data(), &vec[0] );
+    EXPECT_EQ( vec.data() + vec.size(), &*vec.begin() + 3 );
+
+    sc::vector<int> empty;
+    EXPECT_EQ( empty.data(), nullptr );
+    EXPECT_EQ( empty.rbegin(), empty.rend() );
+}
+
+TEST(IntVector, LexicographicOrder)
+{
+    sc::vector<int> a { 1, 2, 3 };
+    sc::vector<int> b { 1, 2, 4 };
+    sc::vector<int> prefix { 1, 2 };
+    EXPECT_TRUE( a < b );
+    EXPECT_TRUE( b > a );
+    EXPECT_TRUE( prefix < a );
+    EXPECT_TRUE( a <= a );
+    EXPECT_TRUE( a >= a );
+    EXPECT_FALSE( a < a );
+    EXPECT_TRUE( sc::vector<int>{} < prefix );
+
+    // Signed elements compare by value, not by bytes.
+    EXPECT_TRUE( ( sc::vector<int>{ -1 } ) < ( sc::vector<int>{ 1 } ) );
+
+    // Long vectors that differ past the vector width, at every offset of the last block.
+    sc::vector<std::uint16_t> x, y;
+    x.resize( 1000 );
+    for ( auto i{0u} ; i < 1000 ; ++i )
+        x[i] = i;
+    for ( auto pos : { 0u, 15u, 31u, 63u, 64u, 500u, 999u } )
+    {
+        y = x;
+        EXPECT_TRUE( x == y );
+        y[pos] += 1;
+        EXPECT_TRUE( x != y );
+        EXPECT_TRUE( x < y ) << "difference at " << pos;
+        EXPECT_FALSE( y < x );
+    }
+
+    // Other types take the element-wise path.
+    sc::vector<std::string> s1 { "a", "b" }, s2 { "a", "c" };
+    EXPECT_TRUE( s1 < s2 );
+    sc::vector<double> d1 { 0.0 }, d2 { -0.0 };
+    EXPECT_TRUE( d1 == d2 );
+
+#if defined(__cpp_lib_three_way_comparison) && __cpp_lib_three_way_comparison >= 201907L
+    EXPECT_TRUE( ( a <=> b ) < 0 );
+    EXPECT_TRUE( ( s2 <=> s1 ) > 0 );
+    EXPECT_TRUE( ( d1 <=> d2 ) == 0 );
+#endif
+}
+
+// ============================================================================
+// TESTING VECTOR STORAGE (OBJECT LIFETIMES)
+// ============================================================================
+
+/// Element type that keeps track of how many instances are alive.
+struct Counted
+{
+    static int alive;        //!< Instances currently constructed.
+    static int constructed;  //!< Total constructor calls.
+    static int copies;       //!< Copy constructions and copy assignments.
+    static int moves;        //!< Move constructions and move assignments.
+    int value;
+
+    Counted( int v = 0 ) : value{v} { ++alive; ++constructed; }
+    Counted( const Counted & other ) : value{other.value} { ++alive; ++constructed; ++copies; }
+    Counted( Counted && other ) noexcept : value{other.value} { ++alive; ++constructed; ++moves; }
+    Counted & operator=( const Counted & other ) { value = other.value; ++copies; return *this; }
+    Counted & operator=( Counted && other ) noexcept { value = other.value; ++moves; return *this; }
+    ~Counted() { --alive; }
+
+    bool operator!=( const Counted & rhs ) const { return value != rhs.value; }
+
+    static void reset() { alive = 0; constructed = 0; copies = 0; moves = 0; }
+};
+int Counted::alive{0};
+int Counted::constructed{0};
+int Counted::copies{0};
+int Counted::moves{0};
+
+TEST(Storage, ReserveDoesNotConstruct)
+{
+    Counted::reset();
+    {
+        sc::vector<Counted> vec;
+        vec.reserve( 1000 );
+        ASSERT_EQ( vec.capacity(), 1000 );
+        EXPECT_EQ( Counted::constructed, 0 );
+
+        sc::vector<Counted> vec2( 1000 );
+        EXPECT_EQ( Counted::constructed, 0 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+TEST(Storage, ClearAndPopDestroy)
+{
+    Counted::reset();
+    {
+        sc::vector<Counted> vec{ 1, 2, 3, 4, 5 };
+        EXPECT_EQ( Counted::alive, 5 );
+
+        vec.pop_back();
+        EXPECT_EQ( Counted::alive, 4 );
+        vec.pop_front();
+        EXPECT_EQ( Counted::alive, 3 );
+        vec.erase( vec.begin() );
+        EXPECT_EQ( Counted::alive, 2 );
+
+        vec.clear();
+        EXPECT_EQ( Counted::alive, 0 );
+        EXPECT_EQ( vec.capacity(), 5 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+TEST(Storage, NoLeakedObjects)
+{
+    Counted::reset();
+    {
+        sc::vector<Counted> vec;
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( Counted{i} );
+        vec.push_front( Counted{-1} );
+        vec.insert( std::next( vec.begin(), 50 ), Counted{-2} );
+        vec.insert( vec.begin(), { Counted{-3}, Counted{-4} } );
+        vec.erase( vec.begin(), std::next( vec.begin(), 10 ) );
+        vec.shrink_to_fit();
+        EXPECT_EQ( Counted::alive, (int) vec.size() );
+
+        sc::vector<Counted> vec2( vec );
+        vec2 = vec;
+        vec2.assign( 3, Counted{7} );
+        EXPECT_EQ( Counted::alive, (int) ( vec.size() + vec2.size() ) );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+TEST(Storage, MoveAssign)
+{
+    sc::vector<int> vec{ 1, 2, 3, 4, 5 };
+    sc::vector<int> vec2{ 9, 9 };
+    const int * storage = &vec[0];
+
+    vec2 = std::move( vec );
+    ASSERT_EQ( vec2, ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
+    // The buffer changed hands, nothing was copied.
+    EXPECT_EQ( &vec2[0], storage );
+    EXPECT_TRUE( vec.empty() );
+    EXPECT_EQ( vec.capacity(), 0 );
+
+    // A moved-from vector is still usable.
+    vec.push_back( 10 );
+    ASSERT_EQ( vec.size(), 1 );
+    EXPECT_EQ( vec[0], 10 );
+}
+
+TEST(Storage, Swap)
+{
+    sc::vector<int> vec{ 1, 2, 3 };
+    sc::vector<int> vec2{ 4, 5 };
+    const int * storage = &vec[0];
+    const int * storage2 = &vec2[0];
+
+    swap( vec, vec2 );
+    ASSERT_EQ( vec, ( sc::vector<int>{ 4, 5 } ) );
+    ASSERT_EQ( vec2, ( sc::vector<int>{ 1, 2, 3 } ) );
+    EXPECT_EQ( &vec[0], storage2 );
+    EXPECT_EQ( &vec2[0], storage );
+}
+
+TEST(Storage, PushBackMovesElements)
+{
+    sc::vector<std::string> vec;
+    std::string s( 100, 'x' );
+    vec.push_back( std::move( s ) );
+    ASSERT_EQ( vec.size(), 1 );
+    EXPECT_EQ( vec[0], std::string( 100, 'x' ) );
+    EXPECT_TRUE( s.empty() );
+
+    Counted::reset();
+    {
+        sc::vector<Counted> vec2;
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec2.push_back( Counted{i} );
+        vec2.insert( vec2.begin(), Counted{-1} );
+        vec2.reserve( 1000 );
+        // Neither pushing temporaries nor growing the storage copies anything.
+        EXPECT_EQ( Counted::copies, 0 );
+        ASSERT_EQ( vec2.size(), 101 );
+        for ( auto i{0u} ; i < vec2.size() ; ++i )
+            ASSERT_EQ( vec2[i].value, (int) i - 1 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+TEST(Storage, AmortizedGrowth)
+{
+    sc::vector<int> vec;
+    vec.push_back( 1 );
+    EXPECT_GE( vec.capacity(), 1 );
+
+    Counted::reset();
+    {
+        const int n{1000};
+        sc::vector<Counted> vec2;
+        auto reallocations{0};
+        for ( auto i{0} ; i < n ; ++i )
+        {
+            auto old_cap = vec2.capacity();
+            vec2.push_back( Counted{i} );
+            if ( vec2.capacity() != old_cap ) ++reallocations;
+        }
+        // One move per pushed temporary, and each element relocated fewer than twice on average.
+        EXPECT_LT( Counted::moves - n, 2 * n );
+        EXPECT_EQ( Counted::copies, 0 );
+        EXPECT_LE( reallocations, 11 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+TEST(Storage, InsertRangeFromItself)
+{
+    sc::vector<int> vec{ 1, 2, 3 };
+    vec.insert( std::next( vec.begin(), 1 ), vec.begin(), vec.end() );
+    ASSERT_EQ( vec, ( sc::vector<int>{ 1, 1, 2, 3, 2, 3 } ) );
+}
+
+TEST(Storage, Emplace)
+{
+    Counted::reset();
+    {
+        sc::vector<Counted> vec;
+        vec.reserve( 10 );
+        auto & e = vec.emplace_back( 3 );
+        EXPECT_EQ( e.value, 3 );
+        vec.emplace_back( 5 );
+        vec.emplace( std::next( vec.begin(), 1 ), 4 );
+        vec.emplace( vec.begin(), 1 );
+        EXPECT_EQ( Counted::copies, 0 );
+
+        ASSERT_EQ( vec.size(), 4 );
+        EXPECT_EQ( vec[0].value, 1 );
+        EXPECT_EQ( vec[1].value, 3 );
+        EXPECT_EQ( vec[2].value, 4 );
+        EXPECT_EQ( vec[3].value, 5 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+
+    // Emplacing a copy of an element that is shifted by the insertion.
+    sc::vector<std::string> vec{ "a", "b", "c" };
+    vec.emplace( vec.begin(), vec[2] );
+    ASSERT_EQ( vec, ( sc::vector<std::string>{ "c", "a", "b", "c" } ) );
+    vec.emplace_back( vec[0] );
+    ASSERT_EQ( vec, ( sc::vector<std::string>{ "c", "a", "b", "c", "c" } ) );
+}
+
+/// Owns a heap int; declared relocatable so sc::vector moves it with memmove.
+struct Handle
+{
+    int * ptr;
+    explicit Handle( int v ) : ptr{ new int{v} } { }
+    Handle( Handle && other ) noexcept : ptr{other.ptr} { other.ptr = nullptr; }
+    Handle( const Handle & other ) : ptr{ new int{*other.ptr} } { }
+    Handle & operator=( Handle && other ) noexcept { std::swap( ptr, other.ptr ); return *this; }
+    ~Handle() { delete ptr; }
+};
+namespace sc { template <> struct is_trivially_relocatable<Handle> : std::true_type { }; }
+
+TEST(Storage, TriviallyRelocatable)
+{
+    struct Point { int x; double y; };
+    static_assert( sc::is_trivially_relocatable<Point>::value, "POD types are relocatable" );
+    static_assert( not sc::is_trivially_relocatable<std::string>::value, "opt-in only" );
+
+    sc::vector<Point> points{ {1, 1.5}, {2, 2.5}, {3, 3.5} };
+    points.insert( std::next( points.begin(), 1 ), Point{9, 9.5} );
+    points.erase( points.begin() );
+    points.pop_front();
+    ASSERT_EQ( points.size(), 2 );
+    EXPECT_EQ( points[0].x, 2 );
+    EXPECT_EQ( points[1].x, 3 );
+
+    // Opted-in type: shifting and growth must not double free nor leak (checked by ASan).
+    sc::vector<Handle> handles;
+    for ( auto i{0} ; i < 20 ; ++i )
+        handles.emplace_back( i );
+    handles.emplace( handles.begin(), -1 );
+    handles.erase( std::next( handles.begin(), 5 ), std::next( handles.begin(), 10 ) );
+    handles.pop_front();
+    handles.shrink_to_fit();
+    ASSERT_EQ( handles.size(), 15 );
+    EXPECT_EQ( *handles[0].ptr, 0 );
+    EXPECT_EQ( *handles[4].ptr, 9 );
+    EXPECT_EQ( *handles.back().ptr, 19 );
+}
+
+/// Relocatable type that counts its move constructions: there are none when sc::vector relocates it bitwise.
+struct MoveCounter
+{
+    static int moves;
+    int value;
+    explicit MoveCounter( int v ) : value{v} { }
+    MoveCounter( MoveCounter && other ) noexcept : value{other.value} { moves++; }
+    MoveCounter & operator=( MoveCounter && other ) noexcept { value = other.value; moves++; return *this; }
+    ~MoveCounter() { }
+};
+int MoveCounter::moves = 0;
+namespace sc { template <> struct is_trivially_relocatable<MoveCounter> : std::true_type { }; }
+
+TEST(Storage, DefaultAllocatorTakesBitwisePath)
+{
+    static_assert( sc::uses_default_construct<std::allocator<int>>::value, "std::allocator only does placement new" );
+    static_assert( sc::uses_default_construct<std::allocator<std::string>>::value, "for any element type" );
+
+    // Growth, insertion and erasure relocate with memmove instead of moving element by element.
+    MoveCounter::moves = 0;
+    sc::vector<MoveCounter> vec;
+    for ( auto i{0} ; i < 100 ; ++i )
+        vec.emplace_back( i );
+    vec.emplace( vec.begin(), -1 );
+    vec.erase( std::next( vec.begin(), 10 ) );
+    vec.shrink_to_fit();
+    // The only move is emplace() moving its temporary into the gap.
+    EXPECT_EQ( MoveCounter::moves, 1 );
+    ASSERT_EQ( vec.size(), 100 );
+    EXPECT_EQ( vec[0].value, -1 );
+    EXPECT_EQ( vec[10].value, 10 );
+}
+
+TEST(Storage, PrintsOnlyElements)
+{
+    sc::vector<int> vec( 10 );
+    vec.push_back( 1 );
+    vec.push_back( 2 );
+
+    std::ostringstream oss;
+    oss << vec;
+    EXPECT_EQ( oss.str(), "[ 1 2 ]" );
+}
+
+TEST(Storage, AppendRange)
+{
+    sc::vector<int> vec{ 1, 2 };
+    int raw[] = { 3, 4, 5, 6, 7 };
+    vec.append_range( std::begin( raw ), std::end( raw ) );
+    // One reservation for the whole range (doubling one element at a time would give 8).
+    EXPECT_EQ( vec.capacity(), 7 );
+    EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2, 3, 4, 5, 6, 7 } ) );
+
+    // The range may be the vector itself.
+    vec.append_range( &vec[0], &vec[0] + 3 );
+    EXPECT_EQ( vec.size(), 10 );
+    EXPECT_EQ( vec[9], 3 );
+
+    // Single-pass ranges work as well.
+    std::istringstream in( "8 9" );
+    sc::vector<int> parsed;
+    parsed.append_range( std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+    EXPECT_EQ( parsed, ( sc::vector<int>{ 8, 9 } ) );
+
+    Counted::reset();
+    {
+        sc::vector<Counted> objs;
+        sc::vector<Counted> src{ 1, 2, 3 };
+        objs.append_range( src.begin(), src.end() );
+        EXPECT_EQ( objs.size(), 3 );
+        EXPECT_EQ( objs[2].value, 3 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+TEST(Storage, Resize)
+{
+    Counted::reset();
+    {
+        sc::vector<Counted> vec{ 1, 2, 3 };
+        vec.resize( 10 );
+        EXPECT_EQ( vec.size(), 10 );
+        EXPECT_EQ( vec[9].value, 0 );
+        EXPECT_EQ( Counted::alive, 10 );
+        vec.resize( 2 );
+        EXPECT_EQ( Counted::alive, 2 );
+        // The value may alias an element while the vector grows.
+        vec.resize( 100, vec[1] );
+        EXPECT_EQ( vec[99].value, 2 );
+        EXPECT_EQ( Counted::alive, 100 );
+        vec.resize( 0 );
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( Counted::alive, 0 );
+    }
+
+    sc::vector<int> zeros{ 5 };
+    zeros.resize( 1000 );
+    EXPECT_EQ( zeros[0], 5 );
+    EXPECT_EQ( zeros[999], 0 );
+}
+
+/// std::allocator that counts the objects built through its construct().
+template <typename T>
+struct ConstructCountingAllocator : std::allocator<T>
+{
+    static int constructed;
+    using value_type = T;
+    template <typename U> struct rebind { using other = ConstructCountingAllocator<U>; };
+    ConstructCountingAllocator() = default;
+    template <typename U>
+    ConstructCountingAllocator( const ConstructCountingAllocator<U> & ) { }
+    template <typename U, typename... Args>
+    void construct( U * p, Args &&... args ) { constructed++; new ( p ) U( std::forward<Args>( args )... ); }
+};
+template <typename T>
+int ConstructCountingAllocator<T>::constructed = 0;
+
+TEST(Storage, ResizeForOverwrite)
+{
+    // Trivial elements are not built at all, not even through an allocator's construct().
+    {
+        sc::vector<int, ConstructCountingAllocator<int>> vec;
+        ConstructCountingAllocator<int>::constructed = 0;
+        vec.resize_for_overwrite( 1000 );
+        EXPECT_EQ( vec.size(), 1000 );
+        EXPECT_EQ( ConstructCountingAllocator<int>::constructed, 0 );
+        // resize() does build them, through the allocator.
+        vec.resize( 900 );
+        vec.resize( 1000 );
+        EXPECT_EQ( ConstructCountingAllocator<int>::constructed, 100 );
+    }
+    {
+        sc::vector<std::string, ConstructCountingAllocator<std::string>> vec;
+        ConstructCountingAllocator<std::string>::constructed = 0;
+        vec.resize_for_overwrite( 3 );
+        EXPECT_EQ( ConstructCountingAllocator<std::string>::constructed, 3 );
+    }
+
+    sc::vector<char> buffer;
+    const char payload[] = "record";
+    buffer.resize_for_overwrite( sizeof(payload) );
+    ASSERT_EQ( buffer.size(), sizeof(payload) );
+    std::memcpy( &buffer[0], payload, sizeof(payload) );
+    EXPECT_STREQ( &buffer[0], "record" );
+    buffer.resize_for_overwrite( 3 );
+    EXPECT_EQ( buffer.size(), 3 );
+
+    Counted::reset();
+    {
+        sc::vector<Counted> vec;
+        vec.resize_for_overwrite( 4 );
+        EXPECT_EQ( Counted::alive, 4 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+// ============================================================================
+// TESTING VECTOR WITH CUSTOM ALLOCATORS
+// ============================================================================
+
+/// Stateful allocator that accounts the bytes currently allocated through it.
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+    long * bytes;   //!< Shared counter of live bytes.
+    int id;         //!< Allocators compare equal only if they have the same id.
+
+    CountingAllocator( long * b, int i = 0 ) : bytes{b}, id{i} { }
+    template <typename U>
+    CountingAllocator( const CountingAllocator<U> & other ) : bytes{other.bytes}, id{other.id} { }
+
+    T * allocate( std::size_t n ) { *bytes += n * sizeof(T); return std::allocator<T>{}.allocate( n ); }
+    void deallocate( T * p, std::size_t n ) { *bytes -= n * sizeof(T); std::allocator<T>{}.deallocate( p, n ); }
+
+    bool operator==( const CountingAllocator & rhs ) const { return id == rhs.id; }
+    bool operator!=( const CountingAllocator & rhs ) const { return id != rhs.id; }
+};
+
+TEST(Allocator, AccountsEveryByte)
+{
+    long bytes{0};
+    {
+        CountingAllocator<int> alloc( &bytes );
+        sc::vector<int, CountingAllocator<int>> vec( alloc );
+        EXPECT_EQ( bytes, 0 );
+        vec.reserve( 10 );
+        EXPECT_EQ( bytes, 10 * sizeof(int) );
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( i );
+        EXPECT_EQ( bytes, (long) ( vec.capacity() * sizeof(int) ) );
+        vec.shrink_to_fit();
+        EXPECT_EQ( bytes, 100 * sizeof(int) );
+
+        auto vec2( vec );
+        EXPECT_EQ( vec2.get_allocator(), alloc );
+        EXPECT_EQ( bytes, 200 * sizeof(int) );
+    }
+    EXPECT_EQ( bytes, 0 );
+}
+
+TEST(Allocator, MoveBetweenUnequalAllocators)
+{
+    long bytes1{0}, bytes2{0};
+    {
+        sc::vector<std::string, CountingAllocator<std::string>> vec( { "a", "b", "c" }, CountingAllocator<std::string>( &bytes1, 1 ) );
+        sc::vector<std::string, CountingAllocator<std::string>> vec2( CountingAllocator<std::string>( &bytes2, 2 ) );
+
+        // Does not propagate and allocators differ: elements move into vec2's own storage.
+        vec2 = std::move( vec );
+        ASSERT_EQ( vec2.size(), 3 );
+        EXPECT_EQ( vec2[2], "c" );
+        EXPECT_EQ( vec2.get_allocator().id, 2 );
+        EXPECT_GT( bytes2, 0 );
+
+        // Swapping storage between vectors with equal allocators is O(1).
+        sc::vector<std::string, CountingAllocator<std::string>> vec3( { "x" }, CountingAllocator<std::string>( &bytes2, 2 ) );
+        const std::string * storage = &vec3[0];
+        vec2.swap( vec3 );
+        EXPECT_EQ( &vec2[0], storage );
+        EXPECT_EQ( vec3.size(), 3 );
+    }
+    EXPECT_EQ( bytes1, 0 );
+    EXPECT_EQ( bytes2, 0 );
+}
+
+TEST(Allocator, PolymorphicMemoryResource)
+{
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource resource( buffer, sizeof(buffer), std::pmr::null_memory_resource() );
+    sc::vector<int, std::pmr::polymorphic_allocator<int>> vec( &resource );
+
+    for ( auto i{0} ; i < 200 ; ++i )
+        vec.push_back( i );
+    ASSERT_EQ( vec.size(), 200 );
+    EXPECT_GE( (const char *) &vec[0], buffer );
+    EXPECT_LT( (const char *) &vec[199], buffer + sizeof(buffer) );
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i );
+}
+
+TEST(Allocator, ArenaGrowsInPlace)
+{
+    sc::arena arena( 1024 );
+    sc::arena_vector<int> vec( arena );
+
+    vec.push_back( 0 );
+    const int * storage = &vec[0];
+    // The vector sits at the arena tip, so growing never moves it.
+    for ( auto i{1} ; i < 100 ; ++i )
+        vec.push_back( i );
+    EXPECT_EQ( &vec[0], storage );
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i );
+
+    // Once another allocation follows it, growth reallocates.
+    sc::arena_vector<int> other( { 1, 2, 3 }, arena );
+    vec.reserve( vec.capacity() + 1 );
+    EXPECT_NE( &vec[0], storage );
+    EXPECT_EQ( vec[99], 99 );
+}
+
+TEST(Allocator, ArenaRewind)
+{
+    sc::arena arena( 256 );
+    sc::arena_allocator<double> alloc( arena );
+
+    auto start = arena.mark();
+    double * first{ nullptr };
+    {
+        sc::arena_vector<double> vec( alloc );
+        vec.reserve( 8 );
+        first = &vec[0];
+        // Bigger than a block: chains a new one.
+        sc::arena_vector<double> big( 1000, alloc );
+        EXPECT_EQ( (std::uintptr_t) &vec[0] % alignof(double), 0u );
+    }
+    arena.rewind( start );
+
+    // After the rewind the same memory is handed out again.
+    sc::arena_vector<double> vec( alloc );
+    vec.reserve( 8 );
+    EXPECT_EQ( &vec[0], first );
+
+    arena.reset();
+    sc::arena_vector<double> big( alloc );
+    big.reserve( 1000 );
+    big.push_back( 1.5 );
+    EXPECT_EQ( big[0], 1.5 );
+}
+
+// ============================================================================
+// TESTING SMALL VECTOR
+// ============================================================================
+
+TEST(SmallVector, StaysInline)
+{
+    sc::small_vector<int, 8> vec;
+    EXPECT_TRUE( vec.empty() );
+    EXPECT_TRUE( vec.is_inline() );
+    EXPECT_EQ( vec.capacity(), 8 );
+
+    for ( auto i{0} ; i < 8 ; ++i )
+        vec.push_back( i );
+    EXPECT_TRUE( vec.is_inline() );
+
+    // Spills to the heap past N.
+    vec.push_back( 8 );
+    EXPECT_FALSE( vec.is_inline() );
+    ASSERT_EQ( vec.size(), 9 );
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i );
+
+    // And comes back when it fits again.
+    vec.erase( vec.begin(), std::next( vec.begin(), 4 ) );
+    vec.shrink_to_fit();
+    EXPECT_TRUE( vec.is_inline() );
+    ASSERT_EQ( vec, ( sc::small_vector<int, 8>{ 4, 5, 6, 7, 8 } ) );
+}
+
+TEST(SmallVector, SameInterface)
+{
+    sc::small_vector<std::string, 4> vec{ "b", "d" };
+    vec.push_front( "a" );
+    vec.insert( std::next( vec.begin(), 2 ), "c" );
+    vec.emplace_back( 3, 'e' );
+    vec.insert( vec.end(), { "f", "g" } );
+    ASSERT_EQ( vec, ( sc::small_vector<std::string, 4>{ "a", "b", "c", "d", "eee", "f", "g" } ) );
+
+    vec.pop_front();
+    vec.pop_back();
+    vec.erase( vec.begin() );
+    EXPECT_EQ( vec.front(), "c" );
+    EXPECT_EQ( vec.back(), "f" );
+    EXPECT_EQ( vec.at( 1 ), "d" );
+    EXPECT_THROW( vec.at( 10 ), std::out_of_range );
+
+    auto copy( vec );
+    EXPECT_EQ( copy, vec );
+    copy.assign( 2, "z" );
+    EXPECT_NE( copy, vec );
+
+    std::ostringstream oss;
+    oss << copy;
+    EXPECT_EQ( oss.str(), "[ z z ]" );
+}
+
+TEST(SmallVector, MoveAndConvert)
+{
+    // Heap blocks change hands in O(1).
+    sc::vector<int> big;
+    for ( auto i{0} ; i < 100 ; ++i )
+        big.push_back( i );
+    const int * storage = &big[0];
+
+    sc::small_vector<int, 8> small( std::move( big ) );
+    EXPECT_EQ( &small[0], storage );
+    EXPECT_TRUE( big.empty() );
+
+    sc::small_vector<int, 8> small2( std::move( small ) );
+    EXPECT_EQ( &small2[0], storage );
+    EXPECT_TRUE( small.empty() );
+    EXPECT_TRUE( small.is_inline() );
+
+    sc::vector<int> back = std::move( small2 );
+    EXPECT_EQ( &back[0], storage );
+    ASSERT_EQ( back.size(), 100 );
+    EXPECT_EQ( back[99], 99 );
+
+    // Inline elements are moved one by one.
+    sc::small_vector<int, 8> tiny{ 1, 2, 3 };
+    sc::vector<int> vec = std::move( tiny );
+    ASSERT_EQ( vec, ( sc::vector<int>{ 1, 2, 3 } ) );
+    sc::small_vector<int, 8> tiny2( vec );
+    EXPECT_TRUE( tiny2.is_inline() );
+    EXPECT_EQ( tiny2[2], 3 );
+
+    sc::small_vector<int, 8> other{ 9 };
+    swap( tiny2, other );
+    EXPECT_EQ( tiny2.size(), 1 );
+    EXPECT_EQ( other.size(), 3 );
+}
+
+TEST(SmallVector, ResizeAppendAndOrder)
+{
+    sc::small_vector<int, 4> vec{ 1, 2 };
+    vec.resize( 3 );
+    EXPECT_EQ( vec, ( sc::small_vector<int, 4>{ 1, 2, 0 } ) );
+    vec.resize( 6, 7 );
+    EXPECT_FALSE( vec.is_inline() );
+    EXPECT_EQ( vec, ( sc::small_vector<int, 4>{ 1, 2, 0, 7, 7, 7 } ) );
+    vec.resize( 2 );
+    EXPECT_EQ( vec.size(), 2 );
+
+    int raw[] = { 3, 4, 5 };
+    vec.append_range( std::begin( raw ), std::end( raw ) );
+    std::istringstream in( "6 7" );
+    vec.append_range( std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+    EXPECT_EQ( vec, ( sc::small_vector<int, 4>{ 1, 2, 3, 4, 5, 6, 7 } ) );
+
+    sc::small_vector<int, 4> other{ 1, 2, 4 };
+    EXPECT_LT( vec, other );
+    EXPECT_GT( other, vec );
+    EXPECT_LE( vec, vec );
+    EXPECT_GE( other, vec );
+
+    // The heap block grows as the policy says: 4 inline, then 1.5x.
+    sc::small_vector<int, 4, sc::growth::one_and_half> slow{ 1, 2, 3, 4 };
+    slow.push_back( 5 );
+    EXPECT_EQ( slow.capacity(), 6 );
+    slow.push_back( 6 );
+    slow.push_back( 7 );
+    EXPECT_EQ( slow.capacity(), 9 );
+}
+
+// ============================================================================
+// TESTING GROWTH POLICIES
+// ============================================================================
+
+TEST(Growth, BuiltInPolicies)
+{
+    using namespace sc::growth;
+    EXPECT_EQ( doubling::next( 0, 1, 4 ), 1 );
+    EXPECT_EQ( doubling::next( 8, 9, 4 ), 16 );
+    EXPECT_EQ( one_and_half::next( 1, 2, 4 ), 2 );
+    EXPECT_EQ( one_and_half::next( 100, 101, 4 ), 150 );
+    // 16 * 4 = 64 bytes is already a size class; 10 * 20 = 200 bytes rounds up to 224.
+    EXPECT_EQ( size_class<>::next( 8, 9, 4 ), 16 );
+    EXPECT_EQ( size_class<>::next( 5, 6, 20 ), 11 );
+    EXPECT_EQ( size_class<>::round( 257 ), 320 );
+    // Page rounding only kicks in from one page on.
+    EXPECT_EQ( page_aligned<>::next( 10, 11, 8 ), 20 );
+    EXPECT_EQ( page_aligned<one_and_half>::next( 1000, 1001, 8 ) * 8 % 4096, 0 );
+    EXPECT_EQ( ( capped_linear<1024>::next( 1000, 1001, 8 ) ), 1128 );
+    EXPECT_EQ( ( capped_linear<1024>::next( 10, 11, 8 ) ), 20 );
+}
+
+TEST(Growth, VectorWithPolicy)
+{
+    sc::vector<int, std::allocator<int>, sc::growth::one_and_half> vec;
+    sc::vector<int>::size_type last_cap{0};
+    for ( auto i{0} ; i < 1000 ; ++i )
+    {
+        vec.push_back( i );
+        if ( vec.capacity() != last_cap )
+        {
+            if ( last_cap > 1 )
+            {
+                EXPECT_EQ( vec.capacity(), last_cap + last_cap / 2 );
+            }
+            last_cap = vec.capacity();
+        }
+    }
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i );
+
+    sc::vector<char, std::allocator<char>, sc::growth::page_aligned<>> pages( 4000 );
+    for ( auto i{0} ; i < 4001 ; ++i )
+        pages.push_back( 'x' );
+    EXPECT_EQ( pages.capacity(), 8192 );
+}
+
+TEST(Allocator, MremapGrowth)
+{
+    // A 4 KiB threshold so that the test crosses it quickly.
+    sc::vector<std::uint64_t, sc::mmap_allocator<std::uint64_t, 4096>> vec;
+    for ( auto i{0ul} ; i < 100000 ; ++i )
+        vec.push_back( i );
+    vec.insert( vec.begin(), 7 );
+    vec.emplace_back( vec[0] );
+    EXPECT_EQ( (std::uintptr_t) &vec[0] % 4096, 0u );
+    ASSERT_EQ( vec.size(), 100002 );
+    EXPECT_EQ( vec[0], 7u );
+    EXPECT_EQ( vec.back(), 7u );
+    for ( auto i{1ul} ; i <= 100000 ; ++i )
+        ASSERT_EQ( vec[i], i-1 );
+
+    // Shrinking back under the threshold returns to malloc storage.
+    vec.erase( std::next( vec.begin(), 10 ), vec.end() );
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 10 );
+    EXPECT_EQ( vec[9], 8u );
+
+    sc::large_vector<double> big( 1 << 20 );
+    big.push_back( 2.5 );
+    big.reserve( 1 << 21 );
+    EXPECT_EQ( big[0], 2.5 );
+}
+
+// ============================================================================
+// TESTING DEVECTOR
+// ============================================================================
+
+TEST(Devector, PushBothEnds)
+{
+    sc::devector<int> vec;
+    EXPECT_TRUE( vec.empty() );
+    for ( auto i{0} ; i < 100 ; ++i )
+    {
+        vec.push_back( i );
+        vec.push_front( -i-1 );
+    }
+    ASSERT_EQ( vec.size(), 200 );
+    EXPECT_EQ( vec.front(), -100 );
+    EXPECT_EQ( vec.back(), 99 );
+    for ( auto i{0} ; i < 200 ; ++i )
+        ASSERT_EQ( vec[i], i-100 );
+    // Contiguous: the iterators walk plain memory.
+    EXPECT_EQ( &*vec.begin() + 200, &*vec.end() );
+
+    vec.pop_front();
+    vec.pop_back();
+    EXPECT_EQ( vec.front(), -99 );
+    EXPECT_EQ( vec.back(), 98 );
+    EXPECT_THROW( vec.at( 198 ), std::out_of_range );
+}
+
+TEST(Devector, QueueDoesNotGrow)
+{
+    sc::devector<int> queue;
+    for ( auto i{0} ; i < 16 ; ++i )
+        queue.push_back( i );
+    // Pushing at one end while popping at the other recenters instead of growing.
+    sc::devector<int>::size_type cap{0};
+    for ( auto i{16} ; i < 100000 ; ++i )
+    {
+        queue.push_back( i );
+        ASSERT_EQ( queue.front(), i-16 );
+        queue.pop_front();
+        if ( i == 1000 )
+            cap = queue.capacity();
+    }
+    EXPECT_LE( cap, 64u );
+    EXPECT_EQ( queue.capacity(), cap );
+    EXPECT_EQ( queue.size(), 16 );
+    EXPECT_EQ( queue.front(), 100000-16 );
+}
+
+TEST(Devector, FrontReserve)
+{
+    sc::devector<int> vec( 10 );
+    EXPECT_EQ( vec.capacity(), 10 );
+    EXPECT_EQ( vec.front_capacity() + vec.back_capacity(), 10 );
+    EXPECT_GT( vec.front_capacity(), 0u );
+    EXPECT_GT( vec.back_capacity(), 0u );
+
+    vec.push_front( 1 );
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 1 );
+    EXPECT_EQ( vec.front_capacity(), 0 );
+    vec.push_front( vec.front() ); // aliasing an element while growing
+    EXPECT_EQ( vec, ( sc::devector<int>{ 1, 1 } ) );
+}
+
+TEST(Devector, InsertErase)
+{
+    sc::devector<int> vec{ 1, 2, 3, 4, 5 };
+    vec.insert( vec.begin() + 1, 10 );
+    vec.insert( vec.end() - 1, 20 );
+    EXPECT_EQ( vec, ( sc::devector<int>{ 1, 10, 2, 3, 4, 20, 5 } ) );
+
+    vec.insert( vec.begin() + 2, { 7, 8, 9 } );
+    EXPECT_EQ( vec, ( sc::devector<int>{ 1, 10, 7, 8, 9, 2, 3, 4, 20, 5 } ) );
+
+    auto it = vec.erase( vec.begin() + 1, vec.begin() + 5 );
+    EXPECT_EQ( *it, 2 );
+    vec.erase( vec.end() - 2 );
+    EXPECT_EQ( vec, ( sc::devector<int>{ 1, 2, 3, 4, 5 } ) );
+
+    std::ostringstream oss;
+    oss << vec;
+    EXPECT_EQ( oss.str(), "[ 1 2 3 4 5 ]" );
+}
+
+TEST(Devector, ObjectLifetimes)
+{
+    Counted::reset();
+    {
+        sc::devector<Counted> vec;
+        for ( auto i{0} ; i < 50 ; ++i )
+        {
+            vec.emplace_back( i );
+            vec.emplace_front( -i );
+        }
+        vec.erase( vec.begin() + 3, vec.begin() + 20 );
+        vec.insert( vec.begin() + 40, Counted( 7 ) );
+        EXPECT_EQ( Counted::alive, (int) vec.size() );
+        EXPECT_EQ( Counted::copies, 0 );
+
+        sc::devector<Counted> copy( vec );
+        EXPECT_TRUE( copy == vec );
+        sc::devector<Counted> moved( std::move( copy ) );
+        EXPECT_TRUE( copy.empty() );
+        moved.clear();
+        EXPECT_EQ( Counted::alive, (int) vec.size() );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+// ============================================================================
+// TESTING RING VECTOR
+// ============================================================================
+
+TEST(RingVector, SlidingWindow)
+{
+    sc::ring_vector<int> window( 4, true );
+    EXPECT_TRUE( window.empty() );
+    EXPECT_EQ( window.capacity(), 4 );
+    for ( auto i{0} ; i < 10 ; ++i )
+        window.push_back( i );
+    EXPECT_TRUE( window.full() );
+    EXPECT_EQ( window, ( sc::ring_vector<int>{ 6, 7, 8, 9 } ) );
+    EXPECT_EQ( window.front(), 6 );
+    EXPECT_EQ( window.back(), 9 );
+    EXPECT_EQ( window.at( 3 ), 9 );
+    EXPECT_THROW( window.at( 4 ), std::out_of_range );
+
+    // Pushing at the front drops the back.
+    window.push_front( 5 );
+    EXPECT_EQ( window, ( sc::ring_vector<int>{ 5, 6, 7, 8 } ) );
+    // The pushed value may alias the element being dropped.
+    window.push_back( window.front() );
+    EXPECT_EQ( window, ( sc::ring_vector<int>{ 6, 7, 8, 5 } ) );
+    EXPECT_EQ( window.capacity(), 4 );
+}
+
+TEST(RingVector, RejectsWhenFull)
+{
+    sc::ring_vector<int> ring( 2 );
+    ring.push_back( 1 );
+    ring.push_back( 2 );
+    EXPECT_THROW( ring.push_back( 3 ), std::length_error );
+    EXPECT_THROW( ring.push_front( 0 ), std::length_error );
+    ring.pop_front();
+    ring.push_back( 3 );
+    EXPECT_EQ( ring[0], 2 );
+    EXPECT_EQ( ring[1], 3 );
+    ring.pop_back();
+    ring.pop_back();
+    EXPECT_TRUE( ring.empty() );
+}
+
+TEST(RingVector, SpansAndIterators)
+{
+    sc::ring_vector<int> ring( 5 );
+    for ( auto i{0} ; i < 5 ; ++i )
+        ring.push_back( i );
+    auto spans = ring.as_spans();
+    EXPECT_EQ( spans.first.size(), 5 );
+    EXPECT_TRUE( spans.second.empty() );
+
+    ring.pop_front();
+    ring.pop_front();
+    ring.push_back( 5 );
+    ring.push_back( 6 );
+    spans = ring.as_spans();
+    ASSERT_EQ( spans.first.size(), 3 );
+    ASSERT_EQ( spans.second.size(), 2 );
+    EXPECT_EQ( spans.first[0], 2 );
+    EXPECT_EQ( spans.second[1], 6 );
+    EXPECT_EQ( spans.first.end(), spans.second.begin() + 5 );
+
+    int expected{2};
+    for ( auto x : ring )
+        EXPECT_EQ( x, expected++ );
+    EXPECT_EQ( ring.end() - ring.begin(), 5 );
+    EXPECT_EQ( *( ring.begin() + 4 ), 6 );
+    EXPECT_EQ( ring.begin()[3], 5 );
+    sc::ring_vector<int>::const_iterator cit = ring.begin();
+    EXPECT_TRUE( cit == ring.cbegin() );
+    EXPECT_EQ( *std::max_element( ring.begin(), ring.end() ), 6 );
+}
+
+TEST(RingVector, NoAllocationsInSteadyState)
+{
+    Counted::reset();
+    {
+        sc::ring_vector<Counted> ring( 8, true );
+        const Counted *block = &ring.as_spans().first[0];
+        for ( auto i{0} ; i < 1000 ; ++i )
+            ring.emplace_back( i );
+        EXPECT_EQ( Counted::alive, 8 );
+        EXPECT_EQ( Counted::copies, 0 );
+        EXPECT_EQ( ring.front().value, 992 );
+        EXPECT_GE( &ring.front(), block );
+        EXPECT_LT( &ring.front(), block + 8 );
+
+        sc::ring_vector<Counted> copy( ring );
+        EXPECT_TRUE( copy == ring );
+        sc::ring_vector<Counted> moved( std::move( copy ) );
+        EXPECT_EQ( copy.capacity(), 0 );
+        EXPECT_EQ( moved.size(), 8 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+// ============================================================================
+// TESTING GAP VECTOR
+// ============================================================================
+
+TEST(GapVector, EditsAtCursor)
+{
+    sc::gap_vector<char> text{ 'h', 'e', 'l', 'o' };
+    auto it = text.insert( text.begin() + 3, 'l' );
+    EXPECT_EQ( *it, 'l' );
+    EXPECT_EQ( text.gap_position(), 4 );
+    // Typing continues at the cursor without moving anything.
+    text.insert( text.begin() + 4, ',' );
+    text.insert( text.begin() + 5, '!' );
+    EXPECT_EQ( text.gap_position(), 6 );
+    // Backspace.
+    text.erase( text.begin() + 5 );
+    EXPECT_EQ( text.gap_position(), 5 );
+    EXPECT_EQ( text, ( sc::gap_vector<char>{ 'h', 'e', 'l', 'l', ',', 'o' } ) );
+
+    text.erase( text.begin() + 4 );
+    text.push_back( '!' );
+    text.push_front( '>' );
+    EXPECT_EQ( std::string( text.begin(), text.end() ), ">hello!" );
+    EXPECT_EQ( text.front(), '>' );
+    EXPECT_EQ( text.back(), '!' );
+    EXPECT_EQ( text.at( 1 ), 'h' );
+    EXPECT_THROW( text.at( 7 ), std::out_of_range );
+}
+
+TEST(GapVector, IteratorsSkipTheGap)
+{
+    sc::gap_vector<int> vec;
+    for ( auto i{0} ; i < 100 ; ++i )
+        vec.push_back( i );
+    vec.insert( vec.begin() + 50, -1 );
+    vec.erase( vec.begin() + 50 );
+    ASSERT_EQ( vec.gap_position(), 50 );
+    ASSERT_GT( vec.capacity(), vec.size() );
+
+    int expected{0};
+    for ( auto x : vec )
+        ASSERT_EQ( x, expected++ );
+    EXPECT_EQ( vec.end() - vec.begin(), 100 );
+    EXPECT_EQ( vec.begin()[75], 75 );
+    EXPECT_EQ( *std::min_element( vec.begin(), vec.end() ), 0 );
+    const sc::gap_vector<int> &cref = vec;
+    sc::gap_vector<int>::const_iterator cit = vec.begin() + 10;
+    EXPECT_TRUE( cit == cref.begin() + 10 );
+
+    vec.insert( vec.begin() + 20, { 7, 8, 9 } );
+    EXPECT_EQ( vec[20], 7 );
+    EXPECT_EQ( vec[23], 20 );
+    vec.erase( vec.begin() + 10, vec.begin() + 90 );
+    EXPECT_EQ( vec.size(), 23 );
+    EXPECT_EQ( vec[10], 87 );
+}
+
+TEST(GapVector, ObjectLifetimes)
+{
+    Counted::reset();
+    {
+        sc::gap_vector<Counted> vec;
+        for ( auto i{0} ; i < 40 ; ++i )
+            vec.emplace( vec.begin() + i / 2, i );
+        vec.erase( vec.begin() + 5, vec.begin() + 15 );
+        vec.insert( vec.begin(), vec[10] ); // aliasing an element that moves
+        EXPECT_EQ( vec[0].value, vec[11].value );
+        EXPECT_EQ( Counted::alive, (int) vec.size() );
+
+        sc::gap_vector<Counted> copy( vec );
+        EXPECT_TRUE( copy == vec );
+        sc::gap_vector<Counted> moved( std::move( copy ) );
+        EXPECT_TRUE( copy.empty() );
+        moved.clear();
+        EXPECT_EQ( Counted::alive, (int) vec.size() );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+// ============================================================================
+// TESTING NUMERIC REDUCTIONS
+// ============================================================================
+
+TEST(Numeric, MatchScalarLoops)
+{
+    // Every size up to a few vector blocks, plus a long odd one: exercises the tails.
+    for ( auto n : { 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 33, 64, 65, 100, 1001 } )
+    {
+        sc::vector<int> v;
+        sc::vector<double> d;
+        for ( auto i{0} ; i < n ; ++i )
+        {
+            v.push_back( ( i * 7919 ) % 1000 - 500 );
+            d.push_back( v.back() * 0.5 );
+        }
+        long long sum{0}, dot{0};
+        int lo = v[0], hi = v[0];
+        std::size_t negatives{0};
+        for ( auto x : v )
+        {
+            sum += x;
+            dot += (long long) x * x;
+            lo = std::min( lo, x );
+            hi = std::max( hi, x );
+            negatives += x < 0;
+        }
+        ASSERT_EQ( sc::numeric::sum( v ), sum ) << n;
+        ASSERT_EQ( sc::numeric::dot( v, v ), dot ) << n;
+        ASSERT_EQ( sc::numeric::min( v ), lo ) << n;
+        ASSERT_EQ( sc::numeric::max( v ), hi ) << n;
+        ASSERT_EQ( sc::numeric::minmax( v ), std::make_pair( lo, hi ) ) << n;
+        ASSERT_EQ( sc::numeric::argmin( v ), std::size_t( std::min_element( v.begin(), v.end() ) - v.begin() ) ) << n;
+        ASSERT_EQ( sc::numeric::argmax( v ), std::size_t( std::max_element( v.begin(), v.end() ) - v.begin() ) ) << n;
+        ASSERT_EQ( sc::numeric::argmax( d ), sc::numeric::argmax( v ) ) << n;
+        ASSERT_EQ( sc::numeric::count_if( v, sc::numeric::less_than<int>{ 0 } ), negatives ) << n;
+        ASSERT_EQ( sc::numeric::count_if( v, []( int x ){ return x < 0; } ), negatives ) << n;
+        // Halves of integers add up exactly.
+        ASSERT_EQ( sc::numeric::sum( d ), sum * 0.5 ) << n;
+        ASSERT_EQ( sc::numeric::min( d ), lo * 0.5 ) << n;
+        ASSERT_EQ( sc::numeric::count_if( d, sc::numeric::greater_than<double>{ hi * 0.5 } ), 0u ) << n;
+    }
+}
+
+TEST(Numeric, BothDispatchTargets)
+{
+    sc::vector<float> f;
+    for ( auto i{0} ; i < 999 ; ++i )
+        f.push_back( float( i % 17 ) );
+    const float *p = f.data();
+    EXPECT_EQ( sc::numeric::detail::sum_sse2( p, f.size() ), sc::numeric::sum( f ) );
+    EXPECT_EQ( sc::numeric::detail::extreme_sse2<true>( p, f.size() ), 16.0f );
+    if ( sc::simd::has_avx2() )
+    {
+        EXPECT_EQ( sc::numeric::detail::sum_avx2( p, f.size() ), sc::numeric::detail::sum_sse2( p, f.size() ) );
+        EXPECT_EQ( sc::numeric::detail::minmax_avx2( p, f.size() ), std::make_pair( 0.0f, 16.0f ) );
+        EXPECT_EQ( sc::numeric::detail::find_avx2( p, f.size(), 16.0f ), 16u );
+    }
+    EXPECT_EQ( sc::numeric::detail::find_sse2( p, f.size(), 16.0f ), 16u );
+    EXPECT_EQ( sc::numeric::detail::find_sse2( p, f.size(), 17.0f ), f.size() );
+}
+
+TEST(Numeric, NaNsAreSkipped)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    // A NaN first, in the middle and last, at sizes below and above the vector blocks.
+    for ( auto n : { 5, 17, 64, 257, 1001 } )
+    {
+        sc::vector<float> f;
+        for ( auto i{0} ; i < n ; ++i )
+            f.push_back( float( ( i * 37 ) % 101 ) );
+        f[0] = nan;
+        f[n / 2] = nan;
+        f[n - 1] = nan;
+        float lo = 1000, hi = -1;
+        for ( auto x : f )
+            if ( x == x )
+            {
+                lo = std::min( lo, x );
+                hi = std::max( hi, x );
+            }
+        ASSERT_EQ( sc::numeric::min( f ), lo ) << n;
+        ASSERT_EQ( sc::numeric::max( f ), hi ) << n;
+        ASSERT_EQ( sc::numeric::minmax( f ), std::make_pair( lo, hi ) ) << n;
+        ASSERT_EQ( f[sc::numeric::argmin( f )], lo ) << n;
+        ASSERT_EQ( f[sc::numeric::argmax( f )], hi ) << n;
+        const float *p = f.data();
+        ASSERT_EQ( sc::numeric::detail::minmax_sse2( p, f.size() ), std::make_pair( lo, hi ) ) << n;
+        ASSERT_EQ( sc::numeric::detail::extreme_sse2<false>( p, f.size() ), lo ) << n;
+        if ( sc::simd::has_avx2() )
+        {
+            ASSERT_EQ( sc::numeric::detail::minmax_avx2( p, f.size() ), std::make_pair( lo, hi ) ) << n;
+            ASSERT_EQ( sc::numeric::detail::extreme_avx2<true>( p, f.size() ), hi ) << n;
+        }
+    }
+    // Only NaNs: the result is NaN, at index 0.
+    sc::vector<double> all;
+    for ( auto i{0} ; i < 100 ; ++i )
+        all.push_back( std::numeric_limits<double>::quiet_NaN() );
+    EXPECT_TRUE( std::isnan( sc::numeric::min( all ) ) );
+    EXPECT_TRUE( std::isnan( sc::numeric::minmax( all ).second ) );
+    EXPECT_EQ( sc::numeric::argmax( all ), 0u );
+}
+
+TEST(Numeric, ArgminArgmax)
+{
+    // The first of several equal extremes, wherever it falls in the vector blocks.
+    for ( auto at : { 0, 1, 7, 31, 32, 500, 998 } )
+    {
+        sc::vector<std::int64_t> v;
+        v.resize( 999 );
+        std::fill( v.begin(), v.end(), 5 );
+        v[at] = -1;
+        v[998] = -1;
+        EXPECT_EQ( sc::numeric::argmin( v ), std::size_t( at ) ) << at;
+        EXPECT_EQ( sc::numeric::argmax( v ), at == 0 ? 1u : 0u ) << at;
+    }
+    sc::vector<std::uint32_t> u { 4, 9, 2, 9 };
+    EXPECT_EQ( sc::numeric::argmin( u.data() + 1, u.data() + 4 ), 1u );
+    EXPECT_EQ( sc::numeric::argmax( u.data() + 2, u.data() + 4 ), 1u );
+    EXPECT_THROW( sc::numeric::argmax( u.data(), u.data() ), std::invalid_argument );
+
+    // Types without kernels use the scalar loop.
+    sc::vector<short> s { 3, -4, 5, -4 };
+    EXPECT_EQ( sc::numeric::argmin( s ), 1u );
+    EXPECT_EQ( sc::numeric::argmax( s ), 2u );
+}
+
+TEST(Numeric, Subranges)
+{
+    sc::vector<std::uint64_t> v;
+    for ( auto i{0ul} ; i < 100 ; ++i )
+        v.push_back( i );
+    EXPECT_EQ( sc::numeric::sum( v.data() + 10, v.data() + 20 ), 145u );
+    EXPECT_EQ( sc::numeric::max( v.data(), v.data() + 50 ), 49u );
+    EXPECT_EQ( sc::numeric::count_if( v.data() + 90, v.data() + 100, sc::numeric::equal_to<std::uint64_t>{ 95 } ), 1u );
+    EXPECT_EQ( sc::numeric::sum( v.data(), v.data() ), 0u );
+    EXPECT_THROW( sc::numeric::min( v.data(), v.data() ), std::invalid_argument );
+
+    // Types without kernels use the scalar loops.
+    sc::vector<short> s { 3, -4, 5 };
+    EXPECT_EQ( sc::numeric::sum( s ), 4 );
+    EXPECT_EQ( sc::numeric::minmax( s ), ( std::pair<short, short>( -4, 5 ) ) );
+}
+
+TEST(Numeric, InclusiveScan)
+{
+    for ( auto n : { 0, 1, 5, 8, 13, 64, 257 } )
+    {
+        sc::vector<int> v;
+        sc::vector<float> f;
+        for ( auto i{0} ; i < n ; ++i )
+        {
+            v.push_back( i % 5 - 2 );
+            f.push_back( float( i % 3 ) );
+        }
+        sc::vector<int> out;
+        out.resize( n );
+        auto end = sc::numeric::inclusive_scan( v.data(), v.data() + n, out.data() );
+        EXPECT_EQ( end, out.data() + n );
+        int running{0};
+        for ( auto i{0} ; i < n ; ++i )
+        {
+            running += v[i];
+            ASSERT_EQ( out[i], running ) << n << " at " << i;
+        }
+        // In place.
+        sc::numeric::inclusive_scan( f );
+        float frunning{0};
+        for ( auto i{0} ; i < n ; ++i )
+        {
+            frunning += float( i % 3 );
+            ASSERT_EQ( f[i], frunning ) << n << " at " << i;
+        }
+    }
+}
+
+// ============================================================================
+// TESTING PARALLEL ALGORITHMS
+// ============================================================================
+
+TEST(Parallel, ForEachTransformFillCopy)
+{
+    sc::thread_pool pool( 3 );
+    sc::parallel::options opt;
+    opt.pool = &pool;
+    opt.grain = 100;
+
+    sc::vector<int> v;
+    v.resize( 10007 );
+    sc::parallel::fill( v.begin(), v.end(), 1, opt );
+    sc::parallel::for_each( v.begin(), v.end(), []( int &x ){ x *= 3; }, opt );
+    for ( auto x : v )
+        ASSERT_EQ( x, 3 );
+
+    for ( auto i{0u} ; i < v.size() ; ++i )
+        v[i] = int( i );
+    sc::vector<long> squares;
+    squares.resize( v.size() );
+    auto end = sc::parallel::transform( v.begin(), v.end(), squares.begin(),
+                                        []( int x ){ return long( x ) * x; }, opt );
+    EXPECT_EQ( end, squares.end() );
+    for ( auto i{0u} ; i < v.size() ; ++i )
+        ASSERT_EQ( squares[i], long( i ) * long( i ) );
+
+    sc::vector<int> dest;
+    dest.resize( v.size() );
+    sc::parallel::copy( v.cbegin(), v.cend(), dest.begin(), opt );
+    EXPECT_EQ( dest, v );
+
+    // Empty ranges and ranges smaller than a grain.
+    sc::parallel::fill( v.begin(), v.begin(), 9, opt );
+    sc::parallel::fill( v.begin(), v.begin() + 10, 9, opt );
+    EXPECT_EQ( v[0], 9 );
+    EXPECT_EQ( v[10], 10 );
+}
+
+TEST(Parallel, Reduce)
+{
+    sc::vector<long> v;
+    for ( auto i{1} ; i <= 100000 ; ++i )
+        v.push_back( i );
+    sc::thread_pool pool( 2 );
+    sc::parallel::options opt;
+    opt.pool = &pool;
+    opt.grain = 1000;
+    EXPECT_EQ( sc::parallel::reduce( v.begin(), v.end(), 0L, std::plus<>{}, opt ), 5000050000L );
+    EXPECT_EQ( sc::parallel::reduce( v.begin(), v.begin(), 7L, std::plus<>{}, opt ), 7L );
+    EXPECT_EQ( sc::parallel::reduce( v.begin(), v.end(), 0L,
+                                     []( long a, long b ){ return std::max( a, b ); }, opt ), 100000L );
+    // Default pool and options.
+    EXPECT_EQ( sc::parallel::reduce( v.begin(), v.end(), 0L ), 5000050000L );
+}
+
+TEST(Parallel, DeterministicReduce)
+{
+    sc::vector<double> v;
+    for ( auto i{0} ; i < 200000 ; ++i )
+        v.push_back( 1.0 / ( i + 1 ) * ( i % 2 ? -1e8 : 1.0 ) );
+    sc::parallel::options opt;
+    opt.deterministic = true;
+    sc::thread_pool one( 1 ), four( 4 );
+    opt.pool = &one;
+    double a = sc::parallel::reduce( v.begin(), v.end(), 0.0, std::plus<>{}, opt );
+    opt.pool = &four;
+    for ( auto r{0} ; r < 5 ; ++r )
+        ASSERT_EQ( sc::parallel::reduce( v.begin(), v.end(), 0.0, std::plus<>{}, opt ), a );
+
+    // The pieces are combined left to right, so non-commutative operations work.
+    sc::vector<std::string> words;
+    for ( auto i{0} ; i < 1000 ; ++i )
+        words.push_back( std::string( 1, char( 'a' + i % 26 ) ) );
+    opt.grain = 7;
+    std::string joined = sc::parallel::reduce( words.begin(), words.end(), std::string(), std::plus<>{}, opt );
+    std::string expected;
+    for ( auto &w : words )
+        expected += w;
+    EXPECT_EQ( joined, expected );
+}
+
+TEST(Parallel, ExceptionsAndNesting)
+{
+    sc::thread_pool pool( 2 );
+    sc::parallel::options opt;
+    opt.pool = &pool;
+    opt.grain = 10;
+    sc::vector<int> v;
+    v.resize( 1000 );
+    v[777] = 1;
+    EXPECT_THROW( sc::parallel::for_each( v.begin(), v.end(), []( int &x ){
+                      if ( x == 1 ) throw std::runtime_error( "piece failed" ); }, opt ),
+                  std::runtime_error );
+
+    // Parallel calls from inside a task run on the same pool without deadlocking.
+    std::atomic<long> total{0};
+    sc::parallel::for_each( v.begin(), v.begin() + 40, [&]( int & ){
+        sc::vector<int> inner;
+        inner.resize( 100 );
+        sc::parallel::fill( inner.begin(), inner.end(), 1, opt );
+        total += sc::parallel::reduce( inner.begin(), inner.end(), 0, std::plus<>{}, opt );
+    }, opt );
+    EXPECT_EQ( total.load(), 4000 );
+}
+
+// ============================================================================
+// TESTING SORT
+// ============================================================================
+
+TEST(Sort, RadixIntegersAndFloats)
+{
+    std::uint64_t state{12345};
+    auto next = [&state](){ state = state * 6364136223846793005ull + 1442695040888963407ull; return state; };
+    for ( auto n : { 0, 1, 31, 33, 1000, 100000 } )
+    {
+        sc::vector<std::uint64_t> u;
+        sc::vector<int> i;
+        sc::vector<double> d;
+        sc::vector<float> f;
+        sc::vector<short> s;
+        for ( auto k{0} ; k < n ; ++k )
+        {
+            std::uint64_t r = next();
+            u.push_back( r );
+            i.push_back( int( r >> 32 ) );
+            d.push_back( double( std::int64_t( r ) ) / 1e9 );
+            f.push_back( k % 7 == 0 ? -0.0f : float( int( r >> 40 ) - ( 1 << 23 ) ) / 3.0f );
+            s.push_back( short( r >> 48 ) );
+        }
+        std::vector<std::uint64_t> eu( u.begin(), u.end() );
+        std::vector<int> ei( i.begin(), i.end() );
+        std::vector<double> ed( d.begin(), d.end() );
+        std::vector<float> ef( f.begin(), f.end() );
+        std::vector<short> es( s.begin(), s.end() );
+        std::sort( eu.begin(), eu.end() );
+        std::sort( ei.begin(), ei.end() );
+        std::sort( ed.begin(), ed.end() );
+        std::sort( ef.begin(), ef.end() );
+        std::sort( es.begin(), es.end() );
+        sc::sort( u.begin(), u.end() );
+        sc::sort( i.begin(), i.end() );
+        sc::radix_sort( d.begin(), d.end() );
+        sc::radix_sort( f.data(), f.data() + f.size() );
+        sc::sort( s.begin(), s.end() );
+        EXPECT_TRUE( std::equal( u.begin(), u.end(), eu.begin() ) ) << n;
+        EXPECT_TRUE( std::equal( i.begin(), i.end(), ei.begin() ) ) << n;
+        EXPECT_TRUE( std::equal( d.begin(), d.end(), ed.begin() ) ) << n;
+        EXPECT_TRUE( std::equal( f.begin(), f.end(), ef.begin() ) ) << n;
+        EXPECT_TRUE( std::equal( s.begin(), s.end(), es.begin() ) ) << n;
+    }
+    // Keys that only use their low byte take a single pass.
+    sc::vector<long> small{ 5, -3, 200, 7, -3, 0, 1, 99, 42, 6, 5, 4, 3, 2, 1, 0, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                            -1, -2, -3, -4, -5, -6, -7, -8 };
+    sc::sort( small.begin(), small.end() );
+    EXPECT_TRUE( std::is_sorted( small.begin(), small.end() ) );
+}
+
+TEST(Sort, RadixByKeyIsStable)
+{
+    struct Record { int key; std::string name; };
+    sc::vector<Record> records;
+    for ( auto k{0} ; k < 500 ; ++k )
+        records.push_back( Record{ ( k * 37 ) % 50 - 25, std::to_string( k ) } );
+    sc::radix_sort( records.begin(), records.end(), []( const Record &r ){ return r.key; } );
+    for ( auto k{1u} ; k < records.size() ; ++k )
+    {
+        ASSERT_LE( records[k-1].key, records[k].key );
+        if ( records[k-1].key == records[k].key )
+        {
+            ASSERT_LT( std::stoi( records[k-1].name ), std::stoi( records[k].name ) );
+        }
+    }
+    // Small ranges are insertion sorted, stable as well.
+    sc::vector<Record> few{ { 2, "a" }, { 1, "b" }, { 2, "c" }, { 1, "d" } };
+    sc::radix_sort( few.begin(), few.end(), []( const Record &r ){ return double( r.key ); } );
+    EXPECT_EQ( few[0].name + few[1].name + few[2].name + few[3].name, "bdac" );
+}
+
+TEST(Sort, ParallelMergeSort)
+{
+    sc::thread_pool pool( 3 );
+    sc::parallel::options opt;
+    opt.pool = &pool;
+    for ( auto grain : { 0, 100, 1000 } )
+    {
+        opt.grain = grain;
+        for ( auto n : { 0, 5, 32, 100, 1001, 54321 } )
+        {
+            sc::vector<std::string> words;
+            for ( auto k{0} ; k < n ; ++k )
+                words.push_back( std::to_string( ( k * 7919 ) % 10007 ) );
+            std::vector<std::string> expected( words.begin(), words.end() );
+            std::sort( expected.begin(), expected.end(), std::greater<>{} );
+            sc::sort( words.begin(), words.end(), std::greater<>{}, opt );
+            ASSERT_TRUE( std::equal( words.begin(), words.end(), expected.begin() ) ) << n << " " << grain;
+        }
+    }
+    // Default comparator and pool for non-numeric elements.
+    sc::vector<std::string> names{ "carol", "alice", "dave", "bob" };
+    sc::sort( names.begin(), names.end() );
+    EXPECT_EQ( names, ( sc::vector<std::string>{ "alice", "bob", "carol", "dave" } ) );
+
+    sc::vector<int> few{ 3, 1, 2 };
+    sc::insertion_sort( few.begin(), few.end() );
+    EXPECT_EQ( few, ( sc::vector<int>{ 1, 2, 3 } ) );
+}
+
+// ============================================================================
+// TESTING SOA VECTOR
+// ============================================================================
+
+TEST(SoaVector, RowsAndColumns)
+{
+    sc::soa_vector<float, float, int> particles;
+    EXPECT_TRUE( particles.empty() );
+    for ( auto i{0} ; i < 100 ; ++i )
+        particles.emplace_back( float( i ), float( -i ), i % 3 );
+    particles.push_back( std::make_tuple( 0.5f, 1.5f, 7 ) );
+    ASSERT_EQ( particles.size(), 101 );
+
+    // Proxy references read and write the row in place.
+    auto [ x, y, tag ] = particles[10];
+    EXPECT_EQ( x, 10.0f );
+    EXPECT_EQ( y, -10.0f );
+    EXPECT_EQ( tag, 1 );
+    x = 42.0f;
+    EXPECT_EQ( std::get<0>( particles[10] ), 42.0f );
+    particles[11] = std::make_tuple( 1.0f, 2.0f, 3 );
+    EXPECT_EQ( particles.at( 11 ), std::make_tuple( 1.0f, 2.0f, 3 ) );
+    EXPECT_EQ( std::get<2>( particles.back() ), 7 );
+    EXPECT_THROW( particles.at( 101 ), std::out_of_range );
+
+    // Each column is one contiguous array.
+    auto xs = particles.column<0>();
+    auto tags = particles.column<2>();
+    EXPECT_EQ( xs.size(), 101 );
+    EXPECT_EQ( xs.data(), particles.data<0>() );
+    EXPECT_EQ( &xs[10], &std::get<0>( particles[10] ) );
+    EXPECT_EQ( &xs[11], &xs[10] + 1 );
+    EXPECT_EQ( sc::numeric::count_if( tags, sc::numeric::equal_to<int>{ 2 } ), 32 ); // row 11 was overwritten
+    float sum{0};
+    for ( float v : particles.column<1>() )
+        sum += v;
+    EXPECT_EQ( sum, -4950.0f + 1.5f + 11.0f + 2.0f );
+
+    int rows{0};
+    for ( auto [ px, py, pt ] : particles )
+    {
+        (void)py;
+        (void)pt;
+        px += 1.0f;
+        ++rows;
+    }
+    EXPECT_EQ( rows, 101 );
+    EXPECT_EQ( particles.column<0>()[0], 1.0f );
+    EXPECT_EQ( particles.end() - particles.begin(), 101 );
+
+    particles.pop_back();
+    particles.resize( 200 );
+    EXPECT_EQ( particles[150], std::make_tuple( 0.0f, 0.0f, 0 ) );
+    particles.resize( 3 );
+    EXPECT_EQ( particles, ( sc::soa_vector<float, float, int>{ { 1.0f, 0.0f, 0 },
+                                                                { 2.0f, -1.0f, 1 },
+                                                                { 3.0f, -2.0f, 2 } } ) );
+}
+
+TEST(SoaVector, GrowthLikeVector)
+{
+    sc::soa_vector<double, char> vec;
+    sc::vector<double> ref;
+    for ( auto i{0} ; i < 1000 ; ++i )
+    {
+        vec.emplace_back( i, 'a' );
+        ref.push_back( i );
+        ASSERT_EQ( vec.capacity(), ref.capacity() ) << i;
+    }
+    vec.reserve( 5000 );
+    EXPECT_EQ( vec.capacity(), 5000 );
+    vec.reserve( 10 );
+    EXPECT_EQ( vec.capacity(), 5000 );
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 1000 );
+    // An element of the vector itself may be appended while it grows.
+    vec.emplace_back( std::get<0>( vec[999] ), std::get<1>( vec[0] ) );
+    EXPECT_EQ( vec.back(), std::make_tuple( 999.0, 'a' ) );
+    vec.clear();
+    EXPECT_TRUE( vec.empty() );
+    EXPECT_EQ( vec.capacity(), 2000 );
+}
+
+TEST(SoaVector, ObjectLifetimes)
+{
+    Counted::reset();
+    {
+        sc::soa_vector<Counted, std::string> vec;
+        for ( auto i{0} ; i < 50 ; ++i )
+            vec.emplace_back( i, std::to_string( i ) );
+        EXPECT_EQ( Counted::alive, 50 );
+        EXPECT_EQ( Counted::copies, 0 );
+        sc::soa_vector<Counted, std::string> copy( vec );
+        EXPECT_EQ( Counted::alive, 100 );
+        EXPECT_EQ( std::get<1>( copy[49] ), "49" );
+        sc::soa_vector<Counted, std::string> moved( std::move( copy ) );
+        EXPECT_TRUE( copy.empty() );
+        EXPECT_EQ( Counted::alive, 100 );
+        moved.resize( 10 );
+        EXPECT_EQ( Counted::alive, 60 );
+        vec = moved;
+        EXPECT_EQ( Counted::alive, 20 );
+        EXPECT_EQ( std::get<0>( vec[9] ).value, 9 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+// ============================================================================
+// TESTING STABLE VECTOR
+// ============================================================================
+
+TEST(StableVector, ReferencesStayValid)
+{
+    sc::stable_vector<int, 4> vec;
+    vec.push_back( 0 );
+    int *first = &vec[0];
+    const int &ref = vec.front();
+    sc::vector<int*> addresses;
+    for ( auto i{1} ; i < 5000 ; ++i )
+    {
+        vec.push_back( i );
+        addresses.push_back( &vec.back() );
+    }
+    // Many segments and several directory doublings later, nothing moved.
+    EXPECT_EQ( first, &vec[0] );
+    EXPECT_EQ( ref, 0 );
+    for ( auto i{1} ; i < 5000 ; ++i )
+    {
+        ASSERT_EQ( addresses[i-1], &vec[i] );
+        ASSERT_EQ( vec[i], i );
+    }
+    EXPECT_EQ( vec.size(), 5000 );
+    EXPECT_EQ( vec.capacity(), 5000 );
+    EXPECT_EQ( vec.at( 4999 ), 4999 );
+    EXPECT_THROW( vec.at( 5000 ), std::out_of_range );
+
+    // Elements of the vector can be appended while it grows.
+    for ( auto i{0} ; i < 10 ; ++i )
+        vec.push_back( vec[i] );
+    EXPECT_EQ( vec.back(), 9 );
+}
+
+TEST(StableVector, SegmentsAndIterators)
+{
+    sc::stable_vector<long, 8> vec;
+    for ( auto i{0} ; i < 100 ; ++i )
+        vec.push_back( i );
+    ASSERT_EQ( vec.segment_count(), 13 );
+    long expected{0};
+    for ( auto k{0u} ; k < vec.segment_count() ; ++k )
+    {
+        auto block = vec.segment( k );
+        EXPECT_EQ( block.size(), k + 1 < vec.segment_count() ? 8u : 4u );
+        for ( long x : block )
+            ASSERT_EQ( x, expected++ );
+    }
+    EXPECT_EQ( expected, 100 );
+
+    EXPECT_EQ( std::accumulate( vec.begin(), vec.end(), 0L ), 4950 );
+    EXPECT_EQ( vec.end() - vec.begin(), 100 );
+    EXPECT_EQ( vec.begin()[42], 42 );
+    EXPECT_EQ( *std::lower_bound( vec.cbegin(), vec.cend(), 57L ), 57 );
+    std::reverse( vec.begin(), vec.end() );
+    EXPECT_EQ( vec.front(), 99 );
+
+    vec.resize( 20 );
+    EXPECT_EQ( vec.capacity(), 104 );
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 24 );
+    vec.resize( 30 );
+    EXPECT_EQ( vec[29], 0 );
+    vec.reserve( 1000 );
+    EXPECT_EQ( vec.capacity(), 1000 );
+    EXPECT_EQ( vec[19], 80 );
+}
+
+TEST(StableVector, ObjectLifetimes)
+{
+    Counted::reset();
+    {
+        sc::stable_vector<Counted, 16> vec;
+        for ( auto i{0} ; i < 1000 ; ++i )
+            vec.emplace_back( i );
+        // Growing never copies or moves an element.
+        EXPECT_EQ( Counted::alive, 1000 );
+        EXPECT_EQ( Counted::copies, 0 );
+        EXPECT_EQ( Counted::moves, 0 );
+
+        sc::stable_vector<Counted, 16> copy( vec );
+        EXPECT_EQ( Counted::alive, 2000 );
+        Counted *p = &copy[500];
+        sc::stable_vector<Counted, 16> moved( std::move( copy ) );
+        EXPECT_EQ( &moved[500], p );
+        EXPECT_TRUE( copy.empty() );
+        moved.resize( 10 );
+        EXPECT_EQ( Counted::alive, 1010 );
+        vec = moved;
+        EXPECT_EQ( Counted::alive, 20 );
+        EXPECT_EQ( vec[9].value, 9 );
+        vec.clear();
+        EXPECT_EQ( Counted::alive, 10 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+// ============================================================================
+// TESTING MMAP VECTOR
+// ============================================================================
+
+struct Record
+{
+    int id;
+    double value;
+};
+
+/// Length of the file at path, in bytes.
+long file_length( const std::string & path )
+{
+    std::ifstream in( path, std::ios::binary | std::ios::ate );
+    return long( in.tellg() );
+}
+
+TEST(MmapVector, WriteThenReopen)
+{
+    const std::string path = testing::TempDir() + "sc_mmap_vector_test.bin";
+    std::remove( path.c_str() );
+    {
+        sc::mmap_vector<Record> vec( path );
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( vec.mode(), sc::map_mode::read_write );
+        for ( auto i{0} ; i < 10000 ; ++i )
+            vec.push_back( Record{ i, i * 0.5 } );
+        EXPECT_EQ( vec.size(), 10000 );
+        EXPECT_GE( vec.capacity(), 10000 );
+        // An element of the vector can be appended while the mapping moves.
+        vec.reserve( vec.size() );
+        vec.push_back( vec[0] );
+        EXPECT_EQ( vec.back().id, 0 );
+        vec.pop_back();
+        vec.flush();
+        EXPECT_EQ( vec.at( 9999 ).value, 4999.5 );
+        EXPECT_THROW( vec.at( 10000 ), std::out_of_range );
+    }
+    // Spare capacity is trimmed: the file holds exactly the records.
+    EXPECT_EQ( file_length( path ), long( 10000 * sizeof( Record ) ) );
+    {
+        const sc::mmap_view<Record> vec( path );
+        ASSERT_EQ( vec.size(), 10000 );
+        EXPECT_EQ( vec.capacity(), 10000 );
+        EXPECT_EQ( vec[1234].id, 1234 );
+        EXPECT_EQ( vec.front().value, 0.0 );
+        auto it = std::find_if( vec.begin(), vec.end(), []( const Record & r ){ return r.value >= 100; } );
+        EXPECT_EQ( it - vec.begin(), 200 );
+        EXPECT_EQ( vec.rbegin()->id, 9999 );
+    }
+    {
+        sc::mmap_view<Record> vec( path );
+        EXPECT_EQ( vec.mode(), sc::map_mode::read_only );
+        EXPECT_THROW( vec.push_back( Record{ 0, 0 } ), std::logic_error );
+        EXPECT_THROW( vec.resize( 3 ), std::logic_error );
+        // The mapping is PROT_READ: even a non-const view only hands out const access.
+        static_assert( std::is_same<decltype( vec[0] ), const Record &>::value, "" );
+        static_assert( std::is_same<decltype( vec.data() ), const Record *>::value, "" );
+        static_assert( std::is_same<decltype( vec.begin() ), sc::mmap_view<Record>::const_iterator>::value, "" );
+        long ids{0};
+        for ( auto & r : vec )
+            ids += r.id;
+        EXPECT_EQ( ids, 9999L * 10000 / 2 );
+        EXPECT_EQ( vec.back().id, 9999 );
+        EXPECT_EQ( vec.size(), 10000 );
+    }
+    {
+        sc::mmap_vector<Record> vec( path );
+        vec.resize( 10 );
+        Record more[] = { { 100, 1.0 }, { 101, 2.0 } };
+        vec.append( more, 2 );
+        vec.append( vec.data(), 3 );
+        vec.resize( 16 );
+        EXPECT_EQ( vec[10].id, 100 );
+        EXPECT_EQ( vec[14].id, 2 );
+        EXPECT_EQ( vec[15].id, 0 );
+        sc::mmap_vector<Record> moved( std::move( vec ) );
+        EXPECT_EQ( moved.size(), 16 );
+        EXPECT_EQ( vec.size(), 0 );
+    }
+    EXPECT_EQ( file_length( path ), long( 16 * sizeof( Record ) ) );
+    std::remove( path.c_str() );
+}
+
+TEST(MmapVector, Errors)
+{
+    const std::string path = testing::TempDir() + "sc_mmap_vector_missing.bin";
+    std::remove( path.c_str() );
+    EXPECT_THROW( sc::mmap_view<int>{ path }, std::system_error );
+    {
+        std::ofstream out( path, std::ios::binary );
+        out << "12345";
+    }
+    EXPECT_THROW( sc::mmap_view<int>{ path }, std::runtime_error );
+    std::remove( path.c_str() );
+}
+
+// ============================================================================
+// TESTING SERIALIZATION
+// ============================================================================
+
+TEST(Serialize, TrivialRoundTripStream)
+{
+    sc::vector<double> vec;
+    for ( auto i{0} ; i < 1000 ; ++i )
+        vec.push_back( i * 0.25 );
+    std::stringstream ss;
+    sc::save( vec, ss );
+    EXPECT_EQ( ss.str().size(), sizeof( sc::serial_header ) + 1000 * sizeof( double ) );
+
+    sc::vector<double> back{ 1.0, 2.0 };
+    sc::load( back, ss );
+    EXPECT_EQ( back, vec );
+
+    // An empty vector round-trips too.
+    sc::vector<double> empty;
+    std::stringstream ss2;
+    sc::save( empty, ss2 );
+    sc::load( back, ss2 );
+    EXPECT_TRUE( back.empty() );
+}
+
+TEST(Serialize, StringsRoundTrip)
+{
+    sc::vector<std::string> vec{ "", "a", "hello", std::string( 1000, 'x' ) };
+    std::stringstream ss;
+    sc::save( vec, ss );
+    sc::vector<std::string> back;
+    sc::load( back, ss );
+    EXPECT_EQ( back, vec );
+}
+
+TEST(Serialize, FileDescriptor)
+{
+    const std::string path = testing::TempDir() + "sc_serialize_test.bin";
+    sc::vector<Record> vec;
+    for ( auto i{0} ; i < 5000 ; ++i )
+        vec.push_back( Record{ i, i * 1.5 } );
+    int fd = ::open( path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+    ASSERT_GE( fd, 0 );
+    sc::save( vec, fd );
+    ::lseek( fd, 0, SEEK_SET );
+    sc::vector<Record> back;
+    sc::load( back, fd );
+    ::close( fd );
+    ASSERT_EQ( back.size(), vec.size() );
+    EXPECT_EQ( back[4999].id, 4999 );
+    EXPECT_EQ( back[4999].value, 4999 * 1.5 );
+
+    // The saved file can be mapped and used in place.
+    const sc::mmap_view<char> file( path );
+    auto view = sc::view<Record>( file.data(), file.size(), true );
+    ASSERT_EQ( view.size(), 5000 );
+    EXPECT_EQ( view[1234].id, 1234 );
+    EXPECT_EQ( view.back().value, 4999 * 1.5 );
+    EXPECT_EQ( std::distance( view.begin(), view.end() ), 5000 );
+    EXPECT_THROW( view.at( 5000 ), std::out_of_range );
+    std::remove( path.c_str() );
+}
+
+TEST(Serialize, Errors)
+{
+    sc::vector<int> vec{ 1, 2, 3, 4, 5 };
+    std::stringstream ss;
+    sc::save( vec, ss );
+    const std::string bytes = ss.str();
+    sc::vector<int> back{ 7 };
+
+    // Wrong element type.
+    {
+        std::stringstream in( bytes );
+        sc::vector<double> wrong;
+        EXPECT_THROW( sc::load( wrong, in ), sc::serial_error );
+    }
+    // Truncated payload: the vector is left as it was.
+    {
+        std::stringstream in( bytes.substr( 0, bytes.size() - 1 ) );
+        EXPECT_THROW( sc::load( back, in ), sc::serial_error );
+        EXPECT_EQ( back, sc::vector<int>{ 7 } );
+    }
+    // Corrupted payload.
+    {
+        std::string bad = bytes;
+        bad[ bad.size() - 1 ] ^= 1;
+        std::stringstream in( bad );
+        EXPECT_THROW( sc::load( back, in ), sc::serial_error );
+    }
+    // Not a serialized vector at all.
+    {
+        std::stringstream in( std::string( 100, 'z' ) );
+        EXPECT_THROW( sc::load( back, in ), sc::serial_error );
+    }
+    // The view checks bounds and, when asked, the checksum.
+    EXPECT_THROW( sc::view<int>( bytes.data(), 10 ), sc::serial_error );
+    EXPECT_THROW( sc::view<int>( bytes.data(), bytes.size() - 4 ), sc::serial_error );
+}
+
+TEST(Serialize, CraftedCount)
+{
+    // count * element_size wraps around to the (empty) payload size: 2^61 * 8 == 0 mod 2^64.
+    sc::vector<std::uint64_t> empty;
+    std::stringstream ss;
+    sc::save( empty, ss );
+    std::string bytes = ss.str();
+    sc::serial_header h;
+    std::memcpy( &h, bytes.data(), sizeof h );
+    h.count = std::uint64_t( 1 ) << 61;
+    h.payload_bytes = 0;
+    std::memcpy( &bytes[0], &h, sizeof h );
+
+    EXPECT_THROW( sc::view<std::uint64_t>( bytes.data(), bytes.size() ), sc::serial_error );
+    sc::vector<std::uint64_t> back{ 7 };
+    std::stringstream in( bytes );
+    EXPECT_THROW( sc::load( back, in ), sc::serial_error );
+    EXPECT_EQ( back, sc::vector<std::uint64_t>{ 7 } );
+
+    // Variable-size elements: a huge count with a small payload fails on the payload, not on reserve().
+    sc::vector<std::string> strings{ "a" };
+    std::stringstream ss2;
+    sc::save( strings, ss2 );
+    bytes = ss2.str();
+    std::memcpy( &h, bytes.data(), sizeof h );
+    h.count = std::uint64_t( 1 ) << 61;
+    std::memcpy( &bytes[0], &h, sizeof h );
+    sc::vector<std::string> back2;
+    std::stringstream in2( bytes );
+    EXPECT_THROW( sc::load( back2, in2 ), sc::serial_error );
+}
+
+TEST(Serialize, SizesAreNotTrusted)
+{
+    // A header that claims 2^40 elements (8 TB) followed by a few bytes.
+    sc::vector<std::uint64_t> small{ 1, 2, 3 };
+    std::stringstream ss;
+    sc::save( small, ss );
+    std::string bytes = ss.str();
+    sc::serial_header h;
+    std::memcpy( &h, bytes.data(), sizeof h );
+    h.count = std::uint64_t( 1 ) << 40;
+    h.payload_bytes = h.count * sizeof( std::uint64_t );
+    std::memcpy( &bytes[0], &h, sizeof h );
+
+    // A seekable stream: rejected from its size, before anything is allocated.
+    sc::vector<std::uint64_t> back{ 7 };
+    std::stringstream in( bytes );
+    EXPECT_THROW( sc::load( back, in ), sc::serial_error );
+    EXPECT_EQ( back, sc::vector<std::uint64_t>{ 7 } );
+
+    // A pipe cannot tell its size: the vector grows with the data and the read fails at the end.
+    int fds[2];
+    ASSERT_EQ( ::pipe( fds ), 0 );
+    ASSERT_EQ( ::write( fds[1], bytes.data(), bytes.size() ), ssize_t( bytes.size() ) );
+    ::close( fds[1] );
+    EXPECT_THROW( sc::load( back, fds[0] ), sc::serial_error );
+    ::close( fds[0] );
+    EXPECT_EQ( back, sc::vector<std::uint64_t>{ 7 } );
+
+    // A valid payload larger than one 16 MB chunk still loads through a pipe.
+    sc::vector<std::uint64_t> big;
+    for ( std::uint64_t i{0} ; i < 3'000'000 ; ++i )
+        big.push_back( i * 3 );
+    ASSERT_EQ( ::pipe( fds ), 0 );
+    std::thread writer( [&]{ sc::save( big, fds[1] ); ::close( fds[1] ); } );
+    sc::load( back, fds[0] );
+    writer.join();
+    ::close( fds[0] );
+    EXPECT_EQ( back, big );
+}
+
+TEST(Serialize, OtherByteOrder)
+{
+    sc::vector<std::uint32_t> vec{ 0x01020304u, 0xA0B0C0D0u };
+    std::stringstream ss;
+    sc::save( vec, ss );
+    std::string bytes = ss.str();
+    // Rewrite the file as a machine of the other byte order would have written it.
+    sc::serial_header h;
+    std::memcpy( &h, bytes.data(), sizeof h );
+    auto swap_bytes = []( void * p, std::size_t n ){ std::reverse( (char *) p, (char *) p + n ); };
+    swap_bytes( &h.version, 2 );
+    swap_bytes( &h.byte_order, 2 );
+    swap_bytes( &h.element_size, 4 );
+    swap_bytes( &h.count, 8 );
+    swap_bytes( &h.payload_bytes, 8 );
+    for ( std::size_t i = sizeof h ; i < bytes.size() ; i += 4 )
+        swap_bytes( &bytes[i], 4 );
+    h.checksum = sc::detail::xxh64( bytes.data() + sizeof h, bytes.size() - sizeof h );
+    swap_bytes( &h.checksum, 8 );
+    std::memcpy( &bytes[0], &h, sizeof h );
+
+    std::stringstream in( bytes );
+    sc::vector<std::uint32_t> back;
+    sc::load( back, in );
+    EXPECT_EQ( back, vec );
+    EXPECT_THROW( sc::view<std::uint32_t>( bytes.data(), bytes.size() ), sc::serial_error );
+}
+
+TEST(Serialize, Checksum)
+{
+    // Reference values of XXH64 with seed 0.
+    EXPECT_EQ( sc::detail::xxh64( "", 0 ), 0xEF46DB3751D8E999ull );
+    EXPECT_EQ( sc::detail::xxh64( "abc", 3 ), 0x44BC2CF5AD770999ull );
+}
+
+// ============================================================================
+// TESTING TEXT FORMATTING AND PARSING
+// ============================================================================
+
+TEST(Text, Format)
+{
+    sc::vector<int> vec{ 1, -2, 30, 400, 5 };
+    EXPECT_EQ( sc::to_text( vec ), "1,-2,30,400,5\n" );
+    EXPECT_EQ( sc::to_text( vec, { '\t', 2 } ), "1\t-2\n30\t400\n5\n" );
+    EXPECT_EQ( sc::to_text( vec, { ',', 1 } ), "1\n-2\n30\n400\n5\n" );
+    EXPECT_EQ( sc::to_text( sc::vector<int>{} ), "" );
+    // Only the elements are written, never the spare capacity.
+    vec.reserve( 100 );
+    std::ostringstream oss;
+    sc::write_text( oss, vec, { ';' } );
+    EXPECT_EQ( oss.str(), "1;-2;30;400;5\n" );
+    // Shortest text that reads back to the same double.
+    EXPECT_EQ( sc::to_text( sc::vector<double>{ 0.1, 2.5, -1e300 } ), "0.1,2.5,-1e+300\n" );
+}
+
+TEST(Text, RoundTrip)
+{
+    sc::vector<double> vec;
+    for ( auto i{0} ; i < 100000 ; ++i )
+        vec.push_back( i / 7.0 - 5000 );
+    sc::vector<double> back;
+    sc::parse_text( back, sc::to_text( vec, { ',', 10 } ) );
+    EXPECT_EQ( back, vec );
+
+    sc::vector<long> longs{ -9223372036854775807L - 1, 0, 9223372036854775807L };
+    sc::vector<long> longs_back;
+    sc::parse_text( longs_back, sc::to_text( longs ) );
+    EXPECT_EQ( longs_back, longs );
+}
+
+TEST(Text, Parse)
+{
+    sc::vector<int> vec{ 9, 9 };
+    sc::parse_text( vec, " 1, 2,3\r\n+4\t5,,6\n\n" );
+    EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2, 3, 4, 5, 6 } ) );
+    EXPECT_EQ( vec.capacity(), 6 );
+    sc::parse_text( vec, "7;8;9", ';' );
+    EXPECT_EQ( vec, ( sc::vector<int>{ 7, 8, 9 } ) );
+    sc::parse_text( vec, "" );
+    EXPECT_TRUE( vec.empty() );
+
+    // Errors leave the vector as it was.
+    vec = sc::vector<int>{ 1 };
+    EXPECT_THROW( sc::parse_text( vec, "1,2,x" ), std::invalid_argument );
+    EXPECT_THROW( sc::parse_text( vec, "1,2.5" ), std::invalid_argument );
+    EXPECT_THROW( sc::parse_text( vec, "1,+" ), std::invalid_argument );
+    EXPECT_THROW( sc::parse_text( vec, "+-5" ), std::invalid_argument );
+    EXPECT_THROW( sc::parse_text( vec, "1,99999999999" ), std::out_of_range );
+    EXPECT_EQ( vec, sc::vector<int>{ 1 } );
+    try {
+        sc::parse_text( vec, "10,20,abc" );
+        ADD_FAILURE() << "parse_text accepted abc";
+    } catch ( const std::invalid_argument & e ) {
+        EXPECT_NE( std::string( e.what() ).find( "offset 6" ), std::string::npos );
+    }
+
+    // The SIMD field count agrees with a byte-by-byte one across block boundaries.
+    std::string text;
+    for ( auto i{0} ; i < 200 ; ++i )
+        text += std::string( i % 7, ' ' ) + std::to_string( i ) + ( i % 3 ? "," : "\r\n" );
+    for ( std::size_t len = 0 ; len < text.size() ; len += 13 )
+        EXPECT_EQ( sc::simd::count_fields( text.data(), len, ',' ),
+                   sc::simd::detail::count_fields_scalar( (const unsigned char *) text.data(), len, ',' ) );
+    sc::parse_text( vec, text );
+    EXPECT_EQ( vec.size(), 200 );
+    EXPECT_EQ( vec[199], 199 );
+
+    sc::vector<float> floats;
+    sc::parse_text( floats, "1.5 -2e3 inf" );
+    ASSERT_EQ( floats.size(), 3 );
+    EXPECT_EQ( floats[1], -2000.0f );
+    EXPECT_TRUE( std::isinf( floats[2] ) );
+}
+
+TEST(Text, File)
+{
+    const std::string path = testing::TempDir() + "sc_text_test.csv";
+    sc::vector<double> vec{ 1.25, 2.5, 3.75, 5 };
+    {
+        std::ofstream out( path );
+        sc::write_text( out, vec, { ',', 2 } );
+    }
+    sc::vector<double> back;
+    sc::read_text( back, path );
+    EXPECT_EQ( back, vec );
+    std::remove( path.c_str() );
+    EXPECT_THROW( sc::read_text( back, path ), std::system_error );
+}
+
+// ============================================================================
+// TESTING CONCURRENT VECTOR
+// ============================================================================
+
+TEST(ConcurrentVector, SingleThread)
+{
+    sc::concurrent_vector<int, 4> vec{ 1, 2, 3 };
+    EXPECT_EQ( vec.size(), 3 );
+    int & first = vec.front();
+    for ( auto i{4} ; i <= 100 ; ++i )
+        vec.push_back( i );
+    // Growing never moves an element.
+    EXPECT_EQ( &first, &vec[0] );
+    EXPECT_EQ( vec.back(), 100 );
+    EXPECT_GE( vec.capacity(), 100 );
+    EXPECT_EQ( std::accumulate( vec.begin(), vec.end(), 0 ), 5050 );
+
+    auto it = vec.grow_by( 30, -1 );
+    EXPECT_EQ( it - vec.begin(), 100 );
+    EXPECT_EQ( vec.end() - it, 30 );
+    EXPECT_EQ( vec[129], -1 );
+    it = vec.grow_by( 2 );
+    EXPECT_EQ( *it, 0 );
+    EXPECT_EQ( vec.size(), 132 );
+    EXPECT_EQ( vec.at( 131 ), 0 );
+    EXPECT_THROW( vec.at( 132 ), std::out_of_range );
+
+    sc::concurrent_vector<int, 4> copy( vec );
+    EXPECT_EQ( copy.size(), 132 );
+    EXPECT_TRUE( std::equal( vec.begin(), vec.end(), copy.begin() ) );
+    sc::concurrent_vector<int, 4> moved( std::move( copy ) );
+    EXPECT_EQ( moved.size(), 132 );
+    EXPECT_TRUE( copy.empty() );
+    vec.clear();
+    EXPECT_TRUE( vec.empty() );
+    EXPECT_GE( vec.capacity(), 132 );
+}
+
+TEST(ConcurrentVector, ThrowingConstructorLeavesNoHole)
+{
+    struct Fragile
+    {
+        std::string name;
+        Fragile( const std::string & n ) : name( n ) { if ( n.empty() ) throw std::invalid_argument( "empty" ); }
+    };
+    sc::concurrent_vector<Fragile> vec;
+    vec.emplace_back( "a" );
+    EXPECT_THROW( vec.emplace_back( "" ), std::invalid_argument );
+    vec.emplace_back( "b" );
+    ASSERT_EQ( vec.size(), 2 );
+    EXPECT_EQ( vec[1].name, "b" );
+}
+
+TEST(ConcurrentVector, ManyWriters)
+{
+    const int threads = 8, per_thread = 20000;
+    sc::concurrent_vector<int, 16> vec;
+    std::atomic<int> started{ 0 };
+    sc::vector<std::thread> workers;
+    for ( auto t{0} ; t < threads ; ++t )
+        workers.push_back( std::thread( [&, t]{
+            started++;
+            while ( started < threads ) std::this_thread::yield();
+            for ( auto i{0} ; i < per_thread ; ++i )
+            {
+                int & ref = vec.push_back( t * per_thread + i );
+                EXPECT_EQ( ref, t * per_thread + i );
+                if ( i % 1000 == 0 )
+                    std::fill_n( vec.grow_by( 10 ), 10, -1 );
+            }
+        } ) );
+    for ( auto & w : workers )
+        w.join();
+    ASSERT_EQ( vec.size(), std::size_t( threads * ( per_thread + 200 ) ) );
+    sc::vector<int> seen( vec.begin(), vec.end() );
+    std::sort( seen.begin(), seen.end() );
+    EXPECT_EQ( std::count( seen.begin(), seen.end(), -1 ), threads * 200 );
+    auto values = std::find_if( seen.begin(), seen.end(), []( int x ){ return x >= 0; } );
+    for ( auto i{0} ; i < threads * per_thread ; ++i )
+        ASSERT_EQ( values[i], i );
+}
+
+// ============================================================================
+// TESTING COPY-ON-WRITE VECTOR
+// ============================================================================
+
+TEST(CowVector, CopiesShareUntilChanged)
+{
+    sc::cow_vector<int> a{ 1, 2, 3, 4 };
+    EXPECT_EQ( a.use_count(), 1 );
+    sc::cow_vector<int> b = a;
+    // The copy is O(1): same buffer, one more reference.
+    EXPECT_EQ( b.data(), a.data() );
+    EXPECT_EQ( a.use_count(), 2 );
+    EXPECT_EQ( a, b );
+
+    // Reading through a non-const vector does not clone.
+    EXPECT_EQ( b[2], 3 );
+    EXPECT_EQ( std::accumulate( b.begin(), b.end(), 0 ), 10 );
+    EXPECT_EQ( b.data(), a.data() );
+
+    // The first change clones; the other copy keeps its snapshot.
+    b.set( 0, 10 );
+    EXPECT_NE( b.data(), a.data() );
+    EXPECT_EQ( a.use_count(), 1 );
+    EXPECT_EQ( b.use_count(), 1 );
+    EXPECT_EQ( a[0], 1 );
+    EXPECT_EQ( b[0], 10 );
+    EXPECT_NE( a, b );
+
+    // A vector that is the only user of its buffer changes it in place.
+    const int * before = b.data();
+    b.modify( 1 ) = 20;
+    b.mutable_data()[2] = 30;
+    EXPECT_EQ( b.data(), before );
+    EXPECT_EQ( b.items(), ( sc::vector<int>{ 10, 20, 30, 4 } ) );
+
+    sc::cow_vector<int> c = b;
+    c.push_back( 5 );
+    EXPECT_EQ( b.size(), 4 );
+    EXPECT_EQ( c.size(), 5 );
+    c = b;
+    c.pop_back();
+    EXPECT_EQ( b.size(), 4 );
+    EXPECT_EQ( c.size(), 3 );
+    EXPECT_THROW( c.at( 3 ), std::out_of_range );
+    c = b;
+    c.clear();
+    EXPECT_TRUE( c.empty() );
+    EXPECT_EQ( b.size(), 4 );
+    EXPECT_EQ( b.use_count(), 1 );
+}
+
+TEST(CowVector, EmptyAndAdopted)
+{
+    sc::cow_vector<std::string> empty;
+    EXPECT_TRUE( empty.empty() );
+    EXPECT_EQ( empty.use_count(), 0 );
+    EXPECT_EQ( empty.begin(), empty.end() );
+    sc::cow_vector<std::string> copy = empty;
+    copy.push_back( "x" );
+    EXPECT_TRUE( empty.empty() );
+    EXPECT_EQ( copy.front(), "x" );
+
+    sc::vector<std::string> built{ "a", "b" };
+    const std::string * storage = built.data();
+    sc::cow_vector<std::string> adopted( std::move( built ) );
+    EXPECT_EQ( adopted.data(), storage );
+    sc::cow_vector<std::string> moved( std::move( adopted ) );
+    EXPECT_TRUE( adopted.empty() );
+    EXPECT_EQ( moved.back(), "b" );
+}
+
+TEST(CowVector, ReadersKeepTheirSnapshot)
+{
+    sc::cow_vector<int> table;
+    table.resize( 1000 );
+    sc::vector<std::thread> readers;
+    std::atomic<int> bad{ 0 };
+    // Each version holds the same value everywhere; a reader must never see two values.
+    for ( auto version{1} ; version <= 8 ; ++version )
+    {
+        std::fill( table.mutable_data(), table.mutable_data() + table.size(), version );
+        sc::cow_vector<int> snapshot = table;
+        readers.push_back( std::thread( [snapshot, version, &bad]{
+            for ( auto round{0} ; round < 50 ; ++round )
+                for ( int x : snapshot )
+                    if ( x != version ) bad++;
+        } ) );
+    }
+    for ( auto & r : readers )
+        r.join();
+    EXPECT_EQ( bad, 0 );
+    EXPECT_EQ( table.use_count(), 1 );
+    EXPECT_EQ( table[999], 8 );
+}
+
+// ============================================================================
+// TESTING VECTOR COPY WITH THROWING ELEMENTS
+// ============================================================================
+
+struct CopyBomb
+{
+    static int copies_left;
+    int value;
+    CopyBomb( int v = 0 ) : value( v ) {}
+    CopyBomb( const CopyBomb & other ) : value( other.value )
+    {
+        if ( copies_left-- == 0 ) throw std::runtime_error( "copy failed" );
+    }
+    CopyBomb & operator=( const CopyBomb & ) = default;
+};
+int CopyBomb::copies_left = -1;
+
+TEST(IntVector, CopyThatThrowsReleasesEverything)
+{
+    sc::vector<CopyBomb> source;
+    for ( auto i{0} ; i < 10 ; ++i )
+        source.emplace_back( i );
+    // Copy constructor: the buffer and the copies made so far are released (checked by ASan).
+    CopyBomb::copies_left = 5;
+    EXPECT_THROW( sc::vector<CopyBomb> copy( source ), std::runtime_error );
+    // Copy assignment into a vector of another capacity: it is left empty and usable.
+    sc::vector<CopyBomb> target;
+    target.emplace_back( 42 );
+    CopyBomb::copies_left = 5;
+    EXPECT_THROW( target = source, std::runtime_error );
+    EXPECT_TRUE( target.empty() );
+    CopyBomb::copies_left = -1;
+    target = source;
+    EXPECT_EQ( target.size(), 10 );
+    EXPECT_EQ( target[9].value, 9 );
+}
+
+TEST(SoaVector, CopyThatThrowsReleasesEverything)
+{
+    using Rows = sc::soa_vector<int, CopyBomb>;
+    Rows source;
+    for ( auto i{0} ; i < 10 ; ++i )
+        source.emplace_back( i, CopyBomb( i ) );
+    // The rows copied so far and every column are freed exactly once (checked by ASan).
+    CopyBomb::copies_left = 5;
+    EXPECT_THROW( Rows copy( source ), std::runtime_error );
+    CopyBomb::copies_left = -1;
+    Rows copy( source );
+    EXPECT_EQ( copy.size(), 10 );
+    EXPECT_EQ( copy.column<1>()[9].value, 9 );
+
+    // pop_back() on an empty vector does nothing, as in sc::vector.
+    Rows empty;
+    empty.pop_back();
+    EXPECT_TRUE( empty.empty() );
+    EXPECT_THROW( empty.at( 0 ), std::out_of_range );
+}
+
+TEST(StableVector, CopyThatThrowsReleasesEverything)
+{
+    // Enough elements for several segments and a directory that has grown.
+    sc::stable_vector<CopyBomb, 16> source;
+    for ( auto i{0} ; i < 200 ; ++i )
+        source.emplace_back( i );
+    // The elements copied so far, the segments and the directories are freed exactly once (checked by ASan).
+    CopyBomb::copies_left = 150;
+    EXPECT_THROW( ( sc::stable_vector<CopyBomb, 16>( source ) ), std::runtime_error );
+    CopyBomb::copies_left = -1;
+    sc::stable_vector<CopyBomb, 16> copy( source );
+    EXPECT_EQ( copy.size(), 200 );
+    EXPECT_EQ( copy[199].value, 199 );
+
+    // pop_back() on an empty vector does nothing, as in sc::vector.
+    sc::stable_vector<CopyBomb, 16> empty;
+    empty.pop_back();
+    EXPECT_TRUE( empty.empty() );
+    EXPECT_THROW( empty.at( 0 ), std::out_of_range );
+}
+
+// concurrent_vector needs a nothrow move when the copy may throw.
+struct MovableCopyBomb : CopyBomb
+{
+    using CopyBomb::CopyBomb;
+    MovableCopyBomb( const MovableCopyBomb & ) = default;
+    MovableCopyBomb( MovableCopyBomb && other ) noexcept : CopyBomb( other.value ) {}
+};
+
+TEST(ConcurrentVector, CopyThatThrowsReleasesEverything)
+{
+    sc::concurrent_vector<MovableCopyBomb> source;
+    for ( auto i{0} ; i < 100 ; ++i )
+        source.emplace_back( i );
+    // The elements copied so far and their segments are freed once, by the destructor (checked by ASan).
+    CopyBomb::copies_left = 70;
+    EXPECT_THROW( ( sc::concurrent_vector<MovableCopyBomb>( source ) ), std::runtime_error );
+    CopyBomb::copies_left = -1;
+    sc::concurrent_vector<MovableCopyBomb> copy( source );
+    EXPECT_EQ( copy.size(), 100 );
+    EXPECT_EQ( copy[99].value, 99 );
+    EXPECT_THROW( copy.at( 100 ), std::out_of_range );
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);